@@ -0,0 +1,28 @@
+#version 420
+
+uniform vec2 view_position;
+uniform vec2 view_scale;
+uniform vec2 mesh_position;
+uniform vec2 mesh_scale;
+uniform vec4 palette[PALETTE_SIZE];
+uniform uint palette_count;
+
+layout (location = 0) in vec2 vertex_position;
+layout (location = 1) in vec2 instance_position;
+layout (location = 2) in vec2 instance_scale;
+layout (location = 3) in uint instance_color;
+
+out vec2 position;
+out vec4 color;
+
+void main()
+{
+    vec2 v = instance_position + vertex_position * instance_scale;
+
+    position = view_position + (mesh_position + v * mesh_scale) * view_scale;
+    color = palette_count > 0u
+        ? palette[instance_color % palette_count]
+        : vec4(0.0);
+
+    gl_Position = vec4(position, 0.0, 1.0);
+}
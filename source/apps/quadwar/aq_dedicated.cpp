@@ -0,0 +1,158 @@
+/*  apps/quadwar/aq_dedicated.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "dedicated.h"
+
+#include "../../laplace/core/string.h"
+#include "../../laplace/engine/protocol/basic_event.h"
+#include "../../laplace/stem/config.h"
+#include "object/root.h"
+#include "protocol/qw_loading.h"
+#include "quadwar.h"
+
+namespace quadwar_app {
+  namespace access = engine::access;
+  namespace ids    = protocol::ids;
+
+  using std::make_shared, std::max, core::family, network::host,
+      object::root;
+
+  const uint16_t dedicated::allowed_commands[] = {
+    ids::session_request, ids::session_token, ids::request_token,
+    ids::request_events,  ids::ping_request,  ids::ping_response,
+    ids::client_enter,    ids::client_leave,  ids::client_ready,
+    ids::player_name,     ids::order_move
+  };
+
+  const uint16_t  dedicated::default_port        = network::any_port;
+  const sl::whole dedicated::default_match_count = 1;
+  const sl::whole dedicated::thread_count        = 4;
+
+  auto dedicated::get_config() -> family {
+    auto cfg = family {};
+
+    cfg[stem::config::k_tick_rate] = stem::config::default_tick_rate;
+    cfg[stem::config::k_tick_spin] = stem::config::default_tick_spin;
+    cfg[stem::config::k_report_period] =
+        stem::config::default_report_period_msec;
+
+    cfg[k_server_port]  = default_port;
+    cfg[k_match_count]  = default_match_count;
+    cfg[k_map_size]     = quadwar::default_map_size;
+    cfg[k_player_count] = quadwar::default_player_count;
+    cfg[k_unit_count]   = quadwar::default_unit_count;
+
+    return cfg;
+  }
+
+  dedicated::dedicated(int argc, char **argv) :
+      app_headless(argc, argv, get_config()) { }
+
+  void dedicated::init() {
+    m_map_size     = m_config[k_map_size].get_integer();
+    m_player_count = m_config[k_player_count].get_integer();
+    m_unit_count   = m_config[k_unit_count].get_integer();
+
+    const auto port  = m_config[k_server_port].get_uint();
+    const auto count = max<sl::whole>(
+        1, m_config[k_match_count].get_integer());
+
+    m_matches.resize(count);
+
+    for (sl::index i = 0; i < count; i++) {
+      auto &m = m_matches[i];
+
+      m.server = make_shared<host>();
+      m.world  = m.server->get_world();
+
+      m.world->set_thread_count(thread_count);
+
+      m.server->set_verbose(false);
+      m.server->set_allowed_commands(allowed_commands);
+      m.server->make_factory<qw_factory>();
+
+      /*  Consecutive ports if the port is set.
+       */
+      m.server->listen(static_cast<uint16_t>(
+          port != network::any_port ? port + i : port));
+
+      log(fmt("Dedicated: Match %lld on port %hu, %lld players.",
+              static_cast<long long>(i), m.server->get_port(),
+              static_cast<long long>(m_player_count)));
+    }
+  }
+
+  void dedicated::cleanup() {
+    m_matches.clear();
+  }
+
+  void dedicated::update(uint64_t delta_msec) {
+    auto is_quit = true;
+
+    for (auto &m : m_matches) {
+      m.server->tick(delta_msec);
+
+      m_bytes_sent += m.server->get_bytes_sent();
+      m_bytes_received += m.server->get_bytes_received();
+      m_bytes_loss += m.server->get_bytes_loss();
+
+      if (m.server->is_quit()) {
+        continue;
+      }
+
+      is_quit = false;
+
+      if (!m.is_launched) {
+        update_lobby(m);
+      }
+    }
+
+    if (is_quit) {
+      quit();
+    }
+  }
+
+  void dedicated::report(const tick_stats &stats) {
+    app_headless::report(stats);
+
+    log(fmt("Dedicated: %lld bytes sent, %lld received, %lld lost.",
+            static_cast<long long>(m_bytes_sent),
+            static_cast<long long>(m_bytes_received),
+            static_cast<long long>(m_bytes_loss)));
+
+    m_bytes_sent     = 0;
+    m_bytes_received = 0;
+    m_bytes_loss     = 0;
+  }
+
+  void dedicated::update_lobby(match &m) {
+    auto world = access::world({ *m.world, access::read_only });
+
+    auto r     = world.get_entity(world.get_root());
+    auto slots = world.get_entity(root::get_slots(r));
+
+    if (slots.vec_get_size() < m_player_count) {
+      return;
+    }
+
+    log(fmt("Dedicated: Launch the match on port %hu.",
+            m.server->get_port()));
+
+    m.server->emit<protocol::qw_loading>(m_map_size, m_player_count,
+                                         m_unit_count);
+
+    m.server->emit<protocol::server_launch>();
+    m.server->emit<protocol::server_action>();
+
+    m.is_launched = true;
+  }
+}
@@ -13,6 +13,7 @@
 #include "../../laplace/core/socket.h"
 #include "../../laplace/platform/wrap.h"
 #include "../../laplace/stem/config.h"
+#include "dedicated.h"
 #include "quadwar.h"
 #include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
@@ -20,8 +21,9 @@
 namespace cfg = laplace::stem::config;
 
 using cfg::scan_flag, cfg::f_tests, cfg::a_tests, cfg::f_benchmarks,
-    cfg::a_benchmarks, cfg::f_run, cfg::a_run,
-    laplace::socket_library, quadwar_app::quadwar;
+    cfg::a_benchmarks, cfg::f_run, cfg::a_run, cfg::f_server,
+    cfg::a_server, laplace::socket_library, quadwar_app::quadwar,
+    quadwar_app::dedicated;
 
 auto run_tests(int &argc, char **argv) -> int {
   testing::InitGoogleTest(&argc, argv);
@@ -69,6 +71,12 @@ auto WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR args, int) -> int {
     run = true;
   }
 
+  if (status == 0 && scan_flag(argc, argv, f_server, a_server)) {
+    run    = false;
+    auto _ = socket_library {};
+    status = dedicated(argc, argv).run();
+  }
+
   if (status == 0 && run) {
     auto _ = socket_library {};
     status = quadwar(argc, argv).run();
@@ -77,6 +77,13 @@ namespace quadwar_app {
   }
 
   session::~session() {
+    /*  The World may outlive the view.
+     */
+    if (m_world) {
+      m_world->on_tick({});
+      m_world->join();
+    }
+
     if (m_host_info_saved) {
       std::filesystem::remove(host_info_file);
     }
@@ -175,6 +182,9 @@ namespace quadwar_app {
     m_world  = server->get_world();
 
     m_world->set_thread_count(thread_count);
+    m_world->on_tick([this](const access::world &w) {
+      m_view.publish(w);
+    });
 
     server->set_verbose(true);
     server->set_allowed_commands(allowed_commands);
@@ -203,6 +213,9 @@ namespace quadwar_app {
     m_world  = server->get_world();
 
     m_world->set_thread_count(thread_count);
+    m_world->on_tick([this](const access::world &w) {
+      m_view.publish(w);
+    });
 
     server->set_verbose(true);
     server->make_factory<qw_factory>();
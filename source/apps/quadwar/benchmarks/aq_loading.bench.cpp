@@ -0,0 +1,62 @@
+/*  apps/quadwar/benchmarks/aq_loading.bench.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../../../laplace/engine/loader.h"
+#include "../../../laplace/engine/world.h"
+#include "../protocol/qw_init.h"
+#include "../protocol/qw_loading.h"
+#include "../protocol/qw_slot_create.h"
+#include <benchmark/benchmark.h>
+
+namespace quadwar_app::bench {
+  using std::make_shared, engine::world, engine::loader,
+      engine::id_undefined, protocol::qw_init,
+      protocol::qw_slot_create, protocol::qw_loading;
+
+  static void quadwar_loading(benchmark::State &state) {
+    const auto map_size     = static_cast<sl::whole>(state.range(0));
+    const auto player_count = sl::whole { 4 };
+    const auto unit_count   = sl::whole { 10 };
+
+    for (auto _ : state) {
+      auto w = make_shared<world>();
+      auto l = loader {};
+
+      w->set_thread_count(0);
+      l.set_world(w);
+
+      for (sl::index i = 0; i < player_count; i++) { w->reserve(i); }
+
+      l.add_task(make_shared<qw_init>());
+
+      for (sl::index i = 0; i < player_count; i++) {
+        l.add_task(make_shared<qw_slot_create>(id_undefined, 0, i,
+                                               i == 0));
+      }
+
+      l.add_task(make_shared<qw_loading>(map_size, player_count,
+                                         unit_count));
+      l.wait();
+
+      /*  Pathmap reset and unit placement.
+       */
+      w->tick(1);
+
+      benchmark::DoNotOptimize(w->get_root());
+    }
+  }
+
+  BENCHMARK(quadwar_loading)
+      ->Arg(256)
+      ->Arg(1024)
+      ->Unit(benchmark::kMillisecond);
+}
@@ -0,0 +1,154 @@
+/*  apps/quadwar/benchmarks/aqo_pathmap.bench.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../object/pathmap.h"
+#include <benchmark/benchmark.h>
+#include <random>
+
+namespace quadwar_app::bench {
+  using std::make_shared, std::mt19937_64,
+      std::uniform_int_distribution, engine::vec2z, object::pathmap,
+      object::footprint_of;
+
+  namespace access = engine::access;
+
+  static constexpr sl::whole moves_count = 1024;
+  static constexpr sl::whole fp_size     = 9;
+
+  struct footprint {
+    vec2z              size  = { fp_size, fp_size };
+    sl::vector<int8_t> bytes = sl::vector<int8_t>(fp_size * fp_size,
+                                                  1);
+  };
+
+  struct pathmap_setup {
+    std::shared_ptr<pathmap> map;
+    sl::vector<vec2z>        positions;
+  };
+
+  static auto make_pathmap(sl::whole size) -> pathmap_setup {
+    auto rng  = mt19937_64 {};
+    auto cell = uniform_int_distribution<int>(0, 19);
+    auto pos  = uniform_int_distribution<sl::index>(8, size - 10);
+
+    auto tiles = sl::vector<int8_t>(size * size);
+
+    for (auto &x : tiles) { x = cell(rng) == 0 ? 1 : 0; }
+
+    auto s = pathmap_setup { .map = make_shared<pathmap>() };
+
+    pathmap::set_tiles(access::entity { s.map, access::sync }, size,
+                       size, tiles);
+
+    s.positions.resize(moves_count);
+
+    for (auto &p : s.positions) { p = { pos(rng), pos(rng) }; }
+
+    return s;
+  }
+
+  static void quadwar_pathmap_check_move(benchmark::State &state) {
+    const auto size = static_cast<sl::whole>(state.range(0));
+    const auto fp   = footprint {};
+
+    auto s  = make_pathmap(size);
+    auto en = access::entity { s.map, access::sync };
+
+    for (auto _ : state) {
+      for (auto &p : s.positions) {
+        benchmark::DoNotOptimize(pathmap::check_move(
+            en, p, fp.size, fp.bytes, p + vec2z { 1, 1 }, fp.size,
+            fp.bytes));
+      }
+    }
+
+    state.SetItemsProcessed(state.iterations() * moves_count);
+  }
+
+  static void quadwar_pathmap_add_subtract(benchmark::State &state) {
+    const auto size = static_cast<sl::whole>(state.range(0));
+    const auto fp   = footprint {};
+
+    auto s  = make_pathmap(size);
+    auto en = access::entity { s.map, access::sync };
+
+    for (auto _ : state) {
+      for (auto &p : s.positions) {
+        pathmap::add(en, p, fp.size, fp.bytes);
+        pathmap::subtract(en, p, fp.size, fp.bytes);
+      }
+    }
+
+    state.SetItemsProcessed(state.iterations() * moves_count);
+  }
+
+  static void quadwar_pathmap_check_move_cached(
+      benchmark::State &state) {
+    const auto  size     = static_cast<sl::whole>(state.range(0));
+    const auto &foot_max = footprint_of(fp_size / 2);
+    const auto &foot_min = footprint_of(fp_size / 2 - 1);
+
+    auto s  = make_pathmap(size);
+    auto en = access::entity { s.map, access::sync };
+
+    for (auto _ : state) {
+      for (auto &p : s.positions) {
+        benchmark::DoNotOptimize(pathmap::check_move(
+            en, p, foot_max, p + vec2z { 1, 1 }, foot_min));
+      }
+    }
+
+    state.SetItemsProcessed(state.iterations() * moves_count);
+  }
+
+  static void quadwar_pathmap_move(benchmark::State &state) {
+    const auto  size = static_cast<sl::whole>(state.range(0));
+    const auto &foot = footprint_of(fp_size / 2);
+
+    auto s  = make_pathmap(size);
+    auto en = access::entity { s.map, access::sync };
+
+    for (auto _ : state) {
+      for (auto &p : s.positions) {
+        pathmap::move(en, p, p + vec2z { 1, 1 }, foot);
+        pathmap::move(en, p + vec2z { 1, 1 }, p, foot);
+      }
+    }
+
+    state.SetItemsProcessed(state.iterations() * moves_count * 2);
+  }
+
+  static void quadwar_pathmap_find_empty(benchmark::State &state) {
+    const auto size = static_cast<sl::whole>(state.range(0));
+    const auto fp   = footprint {};
+
+    auto s  = make_pathmap(size);
+    auto en = access::entity { s.map, access::sync };
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(pathmap::find_empty(
+          en, { size / 2, size / 2 }, fp.size, fp.bytes));
+    }
+  }
+
+  BENCHMARK(quadwar_pathmap_check_move)->Arg(256)->Arg(512)->Arg(1024);
+  BENCHMARK(quadwar_pathmap_add_subtract)
+      ->Arg(256)
+      ->Arg(512)
+      ->Arg(1024);
+  BENCHMARK(quadwar_pathmap_check_move_cached)
+      ->Arg(256)
+      ->Arg(512)
+      ->Arg(1024);
+  BENCHMARK(quadwar_pathmap_move)->Arg(256)->Arg(512)->Arg(1024);
+  BENCHMARK(quadwar_pathmap_find_empty)->Arg(256)->Arg(512)->Arg(1024);
+}
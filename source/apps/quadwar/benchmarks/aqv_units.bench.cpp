@@ -0,0 +1,70 @@
+/*  apps/quadwar/benchmarks/aqv_units.bench.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../view/units.h"
+#include <benchmark/benchmark.h>
+#include <random>
+
+namespace quadwar_app::bench {
+  using std::mt19937_64, std::uniform_real_distribution, view::camera,
+      view::snapshot, view::units;
+
+  static void quadwar_view_units_update(benchmark::State &state) {
+    const auto unit_count = static_cast<sl::whole>(state.range(0));
+    const auto selected   = unit_count / 4;
+
+    auto rng = mt19937_64 {};
+    auto pos = uniform_real_distribution<view::real>(0.f, 100.f);
+
+    auto s         = snapshot {};
+    auto v         = units {};
+    auto cam       = camera {};
+    auto states    = sl::vector<snapshot::unit_state>(unit_count);
+    auto selection = sl::vector<sl::index>(selected);
+
+    for (sl::index i = 0; i < unit_count; i++) {
+      states[i] = { .id     = i * 2 + 10,
+                    .x      = pos(rng),
+                    .y      = pos(rng),
+                    .radius = 1.f,
+                    .color  = i % 4,
+                    .health = 100 };
+    }
+
+    for (sl::index i = 0; i < selected; i++) {
+      selection[i] = states[i * 4].id;
+    }
+
+    const sl::index highlight[] = { states[1].id };
+
+    s.publish(states);
+    s.acquire();
+
+    for (auto &u : states) { u.x += 1.f; }
+
+    s.publish(states);
+    s.acquire();
+
+    for (auto _ : state) {
+      v.update(cam, s, highlight, selection);
+
+      benchmark::DoNotOptimize(v.get_units().data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * unit_count);
+  }
+
+  BENCHMARK(quadwar_view_units_update)
+      ->Arg(2000)
+      ->Arg(5000)
+      ->Unit(benchmark::kMicrosecond);
+}
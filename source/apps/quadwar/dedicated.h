@@ -0,0 +1,71 @@
+/*  apps/quadwar/dedicated.h
+ *
+ *      Dedicated server without window and graphics.
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#ifndef quadwar_dedicated_h
+#define quadwar_dedicated_h
+
+#include "../../laplace/network/host.h"
+#include "../../laplace/stem/app_headless.h"
+#include "defs.h"
+
+namespace quadwar_app {
+  static constexpr auto k_server_port = "server_port";
+  static constexpr auto k_match_count = "match_count";
+
+  /*  Hosts the matches with no local player, one port each. A
+   *  match starts when all the player slots are taken. The
+   *  Worlds share the engine executor.
+   */
+  class dedicated : public stem::app_headless {
+  public:
+    static const uint16_t  allowed_commands[];
+    static const uint16_t  default_port;
+    static const sl::whole default_match_count;
+    static const sl::whole thread_count;
+
+    dedicated(int argc, char **argv);
+    ~dedicated() override = default;
+
+  protected:
+    void init() override;
+    void cleanup() override;
+    void update(uint64_t delta_msec) override;
+    void report(const tick_stats &stats) override;
+
+  private:
+    struct match {
+      std::shared_ptr<network::host> server;
+      engine::ptr_world              world;
+      bool                           is_launched = false;
+    };
+
+    static auto get_config() -> core::family;
+
+    void update_lobby(match &m);
+
+    sl::vector<match> m_matches;
+
+    sl::whole m_map_size     = 0;
+    sl::whole m_player_count = 0;
+    sl::whole m_unit_count   = 0;
+
+    /*  Traffic for the report period.
+     */
+    sl::whole m_bytes_sent     = 0;
+    sl::whole m_bytes_received = 0;
+    sl::whole m_bytes_loss     = 0;
+  };
+}
+
+#endif
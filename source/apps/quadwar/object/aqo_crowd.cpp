@@ -0,0 +1,184 @@
+/*  apps/quadwar/object/aqo_crowd.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "crowd.h"
+
+#include "../../../laplace/core/utils.h"
+#include "landscape.h"
+#include "root.h"
+#include "unit.h"
+
+namespace quadwar_app::object {
+  namespace access = engine::access;
+
+  using std::make_shared, std::min, std::max, engine::id_undefined,
+      engine::intval, engine::vec2i;
+
+  const intval crowd::cell_size = 3000;
+
+  sl::index crowd::n_width    = {};
+  sl::index crowd::n_height   = {};
+  sl::index crowd::n_capacity = {};
+
+  crowd crowd::m_proto(crowd::proto);
+
+  crowd::crowd(proto_tag) : basic_entity(1) {
+    setup_sets({ { .id = sets::crowd_width, .scale = 1 },
+                 { .id = sets::crowd_height, .scale = 1 },
+                 { .id = sets::crowd_capacity, .scale = 1 } });
+
+    n_width    = index_of(sets::crowd_width);
+    n_height   = index_of(sets::crowd_height);
+    n_capacity = index_of(sets::crowd_capacity);
+  }
+
+  crowd::crowd() : basic_entity(dummy) {
+    *this = m_proto;
+  }
+
+  void crowd::tick(access::world w) {
+    auto r     = w.get_entity(w.get_root());
+    auto units = w.get_entity(root::get_units(r));
+
+    const auto width    = as_index(get(n_width));
+    const auto height   = as_index(get(n_height));
+    const auto capacity = as_index(get(n_capacity));
+    const auto cells    = width * height;
+
+    if (cells <= 0) {
+      return;
+    }
+
+    const auto ids = units.vec_get_all();
+
+    if (ids.size() > capacity) {
+      error_("Too many units.", __FUNCTION__);
+      return;
+    }
+
+    /*  Counting sort by cell. The unit ids are sorted, so the
+     *  order in each cell is by id.
+     */
+
+    auto cell = sl::vector<sl::index>(ids.size(), -1);
+    auto v    = sl::vector<intval>(cells + 1 + capacity);
+
+    for (sl::index i = 0; i < ids.size(); i++) {
+      auto u = w.get_entity(as_index(ids[i]));
+
+      if (!u.exist()) {
+        continue;
+      }
+
+      const auto x = cell_of(unit::get_x(u), width);
+      const auto y = cell_of(unit::get_y(u), height);
+
+      cell[i] = y * width + x;
+      v[cell[i] + 1]++;
+    }
+
+    for (sl::index n = 0; n < cells; n++) { v[n + 1] += v[n]; }
+
+    auto next = sl::vector<intval>(v.begin(), v.begin() + cells);
+
+    for (sl::index i = 0; i < ids.size(); i++) {
+      if (cell[i] >= 0) {
+        v[cells + 1 + next[cell[i]]++] = ids[i];
+      }
+    }
+
+    vec_write(0, v);
+  }
+
+  auto crowd::create(world w, sl::whole unit_count) -> sl::index {
+    auto r    = w.get_entity(w.get_root());
+    auto land = w.get_entity(root::get_landscape(r));
+
+    if (!land.exist()) {
+      error_("No landscape.", __FUNCTION__);
+      return id_undefined;
+    }
+
+    const auto size_x = landscape::get_width(land) *
+                        sets::scale_real;
+    const auto size_y = landscape::get_height(land) *
+                        sets::scale_real;
+
+    const auto width  = as_index(size_x + cell_size - 1) /
+                        cell_size;
+    const auto height = as_index(size_y + cell_size - 1) /
+                        cell_size;
+
+    auto id = w.spawn(make_shared<crowd>(), id_undefined);
+    auto en = w.get_entity(id);
+
+    en.vec_resize(width * height + 1 + unit_count);
+    en.set(n_width, width);
+    en.set(n_height, height);
+    en.set(n_capacity, unit_count);
+    en.adjust();
+
+    root::set_crowd(r, id);
+    r.adjust();
+
+    return id;
+  }
+
+  auto crowd::get_near(entity en, const vec2i position)
+      -> sl::vector<sl::index> {
+    const auto width    = as_index(en.get(n_width));
+    const auto height   = as_index(en.get(n_height));
+    const auto capacity = as_index(en.get(n_capacity));
+    const auto cells    = width * height;
+
+    if (cells <= 0) {
+      return {};
+    }
+
+    const auto x = cell_of(position.x(), width);
+    const auto y = cell_of(position.y(), height);
+
+    const auto x0 = max<sl::index>(x - 1, 0);
+    const auto y0 = max<sl::index>(y - 1, 0);
+    const auto x1 = min<sl::index>(x + 2, width);
+    const auto y1 = min<sl::index>(y + 2, height);
+
+    auto v   = sl::vector<sl::index> {};
+    auto ids = sl::vector<intval> {};
+
+    /*  Cells of a row are adjacent, so the ids are read by
+     *  one range per row.
+     */
+    for (auto j = y0; j < y1; j++) {
+      const auto begin = as_index(en.vec_get(j * width + x0));
+      const auto end   = as_index(en.vec_get(j * width + x1));
+
+      if (begin < 0 || end < begin || end > capacity) {
+        error_("Invalid cell.", __FUNCTION__);
+        return {};
+      }
+
+      ids.resize(end - begin);
+      en.vec_read(cells + 1 + begin, ids);
+
+      for (const auto id : ids) { v.emplace_back(as_index(id)); }
+    }
+
+    return v;
+  }
+
+  auto crowd::cell_of(const intval x, const sl::whole size) noexcept
+      -> sl::index {
+    return max<sl::index>(
+        0, min<sl::index>(size - 1, as_index(x / cell_size)));
+  }
+}
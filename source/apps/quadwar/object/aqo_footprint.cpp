@@ -0,0 +1,162 @@
+/*  apps/quadwar/object/aqo_footprint.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "footprint.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+namespace quadwar_app::object {
+  using std::map, std::unique_ptr, std::make_unique,
+      std::shared_mutex, std::shared_lock, std::unique_lock,
+      engine::vec2z;
+
+  static const vec2z directions[footprint::direction_count] = {
+    { 1, 0 },  { 1, 1 },   { 0, 1 },  { -1, 1 },
+    { -1, 0 }, { -1, -1 }, { 0, -1 }, { 1, -1 }
+  };
+
+  static auto byte_at(const footprint &f, sl::index x, sl::index y)
+      -> int8_t {
+    if (x < 0 || y < 0 || x >= f.size.x() || y >= f.size.y()) {
+      return 0;
+    }
+
+    return f.bytes[y * f.size.x() + x];
+  }
+
+  static void build_rows(footprint &f) {
+    f.rows.resize(f.size.y());
+    f.is_solid = true;
+
+    for (sl::index j = 0; j < f.size.y(); j++) {
+      auto x0 = f.size.x();
+      auto x1 = sl::index {};
+
+      for (sl::index i = 0; i < f.size.x(); i++) {
+        if (byte_at(f, i, j) != 0) {
+          x0 = std::min(x0, i);
+          x1 = i + 1;
+        }
+      }
+
+      if (x0 >= x1) {
+        continue;
+      }
+
+      f.rows[j] = { .start = x0, .length = x1 - x0 };
+
+      for (auto i = x0; i < x1; i++) {
+        if (byte_at(f, i, j) <= 0) {
+          f.is_solid = false;
+        }
+      }
+    }
+  }
+
+  /*  The old footprint is at the new position minus the
+   *  direction, so the old cell for the new local coordinates
+   *  (x, y) is (x + dx, y + dy).
+   */
+  static void build_edge(footprint &f, sl::index n) {
+    const auto dx = directions[n].x();
+    const auto dy = directions[n].y();
+
+    auto &e = f.edges[n];
+
+    const auto delta_at = [&](sl::index i, sl::index j) {
+      return static_cast<int8_t>(byte_at(f, i, j) -
+                                 byte_at(f, i + dx, j + dy));
+    };
+
+    for (sl::index j = -1; j <= f.size.y(); j++) {
+      auto i0 = f.size.x() + 1;
+      auto i1 = sl::index { -1 };
+
+      for (sl::index i = -1; i <= f.size.x(); i++) {
+        if (delta_at(i, j) != 0) {
+          i0 = std::min(i0, i);
+          i1 = i + 1;
+        }
+      }
+
+      if (i0 >= i1) {
+        continue;
+      }
+
+      e.spans.emplace_back(footprint::edge_span {
+          .x      = i0,
+          .y      = j,
+          .length = i1 - i0,
+          .offset = static_cast<sl::index>(e.deltas.size()) });
+
+      for (auto i = i0; i < i1; i++) {
+        e.deltas.emplace_back(delta_at(i, j));
+      }
+    }
+  }
+
+  static auto make_footprint(sl::whole radius) -> footprint {
+    const auto size = 1 + radius * 2;
+
+    auto f = footprint { .size     = { size, size },
+                         .center   = { radius, radius },
+                         .bytes    = sl::vector<int8_t>(size * size,
+                                                       1),
+                         .rows     = {},
+                         .is_solid = false,
+                         .edges    = {} };
+
+    build_rows(f);
+
+    for (sl::index n = 0; n < footprint::direction_count; n++) {
+      build_edge(f, n);
+    }
+
+    return f;
+  }
+
+  auto footprint_of(sl::whole radius) -> const footprint & {
+    static shared_mutex lock;
+    static map<sl::whole, unique_ptr<const footprint>> cache;
+
+    if (radius < 0) {
+      error_("Invalid radius.", __FUNCTION__);
+      radius = 0;
+    }
+
+    {
+      auto _sl = shared_lock(lock);
+
+      if (auto i = cache.find(radius); i != cache.end()) {
+        return *i->second;
+      }
+    }
+
+    auto f = make_unique<const footprint>(make_footprint(radius));
+
+    auto _ul = unique_lock(lock);
+    return *cache.try_emplace(radius, std::move(f)).first->second;
+  }
+
+  auto direction_of(vec2z delta) noexcept -> sl::index {
+    for (sl::index n = 0; n < footprint::direction_count; n++) {
+      if (delta == directions[n]) {
+        return n;
+      }
+    }
+
+    return -1;
+  }
+}
@@ -13,39 +13,117 @@
 #include "pathmap.h"
 
 #include "../../../laplace/core/serial.h"
+#include "../../../laplace/core/utils.h"
 #include "../../../laplace/engine/eval/grid.h"
 #include "root.h"
+#include "unit.h"
 
 namespace quadwar_app::object {
   namespace access = engine::access;
   namespace grid   = engine::eval::grid;
 
   using std::make_shared, std::min, std::max, std::span, std::array,
-      engine::id_undefined, engine::vec2z,
+      engine::id_undefined, engine::intval, engine::vec2z,
       engine::eval::astar::status;
 
   const sl::whole pathmap::resolution     = 2;
   const sl::whole pathmap::spawn_distance = 100;
   const sl::whole pathmap::search_scale   = 10;
+  const sl::whole pathmap::block_size     = 16;
 
-  sl::index pathmap::n_width  = {};
-  sl::index pathmap::n_height = {};
+  sl::index pathmap::n_width    = {};
+  sl::index pathmap::n_height   = {};
+  sl::index pathmap::n_revision = {};
 
   pathmap pathmap::m_proto(pathmap::proto);
 
-  pathmap::pathmap(proto_tag) {
-
+  pathmap::pathmap(proto_tag) : basic_entity(1) {
     setup_sets({ { .id = sets::pathmap_width, .scale = 1 },
-                 { .id = sets::pathmap_height, .scale = 1 } });
+                 { .id = sets::pathmap_height, .scale = 1 },
+                 { .id = sets::pathmap_revision, .scale = 1 } });
 
-    n_width  = index_of(sets::pathmap_width);
-    n_height = index_of(sets::pathmap_height);
+    n_width    = index_of(sets::pathmap_width);
+    n_height   = index_of(sets::pathmap_height);
+    n_revision = index_of(sets::pathmap_revision);
   }
 
   pathmap::pathmap() : basic_entity(dummy) {
     *this = m_proto;
   }
 
+  void pathmap::tick(access::world w) {
+    const auto revisions = vec_get_all();
+
+    if (revisions.size() != m_seen.size()) {
+      m_seen = revisions;
+      return;
+    }
+
+    if (revisions == m_seen) {
+      return;
+    }
+
+    /*  Count the changed blocks with the prefix sums, so each
+     *  corridor is checked in constant time.
+     */
+
+    const auto width    = as_index(get(n_width));
+    const auto height   = as_index(get(n_height));
+    const auto blocks_x = (width + block_size - 1) / block_size;
+    const auto blocks_y = (height + block_size - 1) / block_size;
+    const auto stride   = blocks_x + 1;
+
+    if (blocks_x * blocks_y != revisions.size()) {
+      error_("Invalid block revisions.", __FUNCTION__);
+      return;
+    }
+
+    m_changed.assign(stride * (blocks_y + 1), 0);
+
+    for (sl::index y = 0; y < blocks_y; y++)
+      for (sl::index x = 0; x < blocks_x; x++) {
+        const auto n = y * blocks_x + x;
+
+        m_changed[(y + 1) * stride + x + 1] =
+            (revisions[n] != m_seen[n] ? 1 : 0) +
+            m_changed[y * stride + x + 1] +
+            m_changed[(y + 1) * stride + x] -
+            m_changed[y * stride + x];
+      }
+
+    m_seen = revisions;
+
+    auto r     = w.get_entity(w.get_root());
+    auto units = w.get_entity(root::get_units(r));
+
+    for (const auto id : units.vec_get_all()) {
+      auto u = w.get_entity(as_index(id));
+
+      if (!u.exist()) {
+        continue;
+      }
+
+      const auto c  = unit::get_corridor(u);
+      const auto x0 = max<sl::index>(c.min.x(), 0);
+      const auto y0 = max<sl::index>(c.min.y(), 0);
+      const auto x1 = min(c.max.x(), blocks_x);
+      const auto y1 = min(c.max.y(), blocks_y);
+
+      if (x0 >= x1 || y0 >= y1) {
+        continue;
+      }
+
+      const auto count = m_changed[y1 * stride + x1] -
+                         m_changed[y0 * stride + x1] -
+                         m_changed[y1 * stride + x0] +
+                         m_changed[y0 * stride + x0];
+
+      if (count > 0) {
+        unit::notify_path_changed(u);
+      }
+    }
+  }
+
   auto pathmap::create(world w) -> sl::index {
     auto r  = w.get_entity(w.get_root());
     auto id = w.spawn(make_shared<pathmap>(), id_undefined);
@@ -75,8 +153,15 @@ namespace quadwar_app::object {
     en.bytes_resize(tiles.size());
     en.bytes_write(0, tiles);
 
+    const auto blocks_x = (width + block_size - 1) / block_size;
+    const auto blocks_y = (height + block_size - 1) / block_size;
+
+    en.vec_resize(0);
+    en.vec_resize(blocks_x * blocks_y);
+
     en.set(n_width, width);
     en.set(n_height, height);
+    en.apply_delta(n_revision, 1);
 
     en.adjust();
   }
@@ -99,6 +184,14 @@ namespace quadwar_app::object {
     return v;
   }
 
+  auto pathmap::get_revision(entity en) -> intval {
+    return en.get(n_revision);
+  }
+
+  auto pathmap::get_block_revisions(entity en) -> sl::vector<intval> {
+    return en.vec_get_all();
+  }
+
   auto pathmap::check_move(
       entity                   en,
       const vec2z              position,
@@ -152,22 +245,132 @@ namespace quadwar_app::object {
     for (sl::index j = 0; j < new_size.y(); j++) {
       en.bytes_read((y0 + j) * width + x0, line);
 
-      for (sl::index i = 0; i < new_size.x(); i++) {
-        if (line[i] <= 0) {
-          continue;
-        }
+      const auto row = new_footprint.data() + j * new_size.x();
 
-        const auto i0 = i + dx;
-        const auto j0 = j + dy;
+      /*  Cells covered by the current footprint are not
+       *  blocking. Split the row into the ranges outside and
+       *  inside of it, so each range is a branchless loop.
+       */
 
-        if (i0 >= 0 && i0 < size.x() && j0 >= 0 && j0 < size.y() &&
-            footprint[j0 * size.x() + i0] > 0) {
-          continue;
-        }
+      auto i0 = sl::index {};
+      auto i1 = sl::index {};
+
+      if (const auto j0 = j + dy; j0 >= 0 && j0 < size.y()) {
+        i0 = min<sl::index>(max<sl::index>(-dx, 0), new_size.x());
+        i1 = min<sl::index>(max<sl::index>(size.x() - dx, i0),
+                            new_size.x());
+      }
+
+      const auto own = (j + dy) * size.x() + dx;
+
+      auto blocked = 0;
+
+      for (sl::index i = 0; i < i0; i++) {
+        blocked |= (line[i] > 0) & (row[i] > 0);
+      }
+
+      for (sl::index i = i0; i < i1; i++) {
+        blocked |= (line[i] > 0) & (row[i] > 0) &
+                   (footprint[own + i] <= 0);
+      }
+
+      for (sl::index i = i1; i < new_size.x(); i++) {
+        blocked |= (line[i] > 0) & (row[i] > 0);
+      }
+
+      if (blocked != 0) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  auto pathmap::check_move(entity           en,
+                           const vec2z      position,
+                           const footprint &foot,
+                           const vec2z      new_position,
+                           const footprint &new_foot) noexcept
+      -> bool {
+
+    const auto width  = en.get(n_width);
+    const auto height = en.get(n_height);
+
+    const auto x0 = new_position.x() - new_foot.center.x();
+    const auto y0 = new_position.y() - new_foot.center.y();
 
-        if (new_footprint[j * new_size.x() + i] > 0) {
-          return false;
+    const auto x1 = x0 + new_foot.size.x();
+    const auto y1 = y0 + new_foot.size.y();
+
+    const auto dx = x0 - (position.x() - foot.center.x());
+    const auto dy = y0 - (position.y() - foot.center.y());
+
+    if (x0 < 0 || y0 < 0 || x1 >= width || y1 >= height) {
+      return false;
+    }
+
+    auto line = sl::vector<int8_t>(new_foot.size.x());
+
+    /*  Check range [i0, i1) of the row j. If the range is
+     *  covered by the current footprint, own cells are not
+     *  blocking.
+     */
+    const auto is_blocked = [&](sl::index j, sl::index i0,
+                                sl::index i1, bool is_own) -> bool {
+      if (i0 >= i1) {
+        return false;
+      }
+
+      en.bytes_read((y0 + j) * width + x0 + i0,
+                    { line.data() + i0, line.data() + i1 });
+
+      const auto row = new_foot.bytes.data() + j * new_foot.size.x();
+
+      auto blocked = 0;
+
+      if (is_own) {
+        const auto own = foot.bytes.data() +
+                         ((j + dy) * foot.size.x() + dx);
+
+        for (auto i = i0; i < i1; i++) {
+          blocked |= (line[i] > 0) & (row[i] > 0) & (own[i] <= 0);
         }
+      } else {
+        for (auto i = i0; i < i1; i++) {
+          blocked |= (line[i] > 0) & (row[i] > 0);
+        }
+      }
+
+      return blocked != 0;
+    };
+
+    for (sl::index j = 0; j < new_foot.size.y(); j++) {
+      const auto &s = new_foot.rows[j];
+
+      const auto i0 = s.start;
+      const auto i1 = s.start + s.length;
+
+      /*  Range [own0, own1) is covered by the current
+       *  footprint. If it is solid, the range is skipped.
+       */
+
+      auto own0 = i1;
+      auto own1 = i1;
+
+      if (const auto j0 = j + dy; j0 >= 0 && j0 < foot.size.y()) {
+        const auto &r = foot.rows[j0];
+
+        own0 = min(max(r.start - dx, i0), i1);
+        own1 = min(max(r.start + r.length - dx, own0), i1);
+      }
+
+      if (is_blocked(j, i0, own0, false) ||
+          is_blocked(j, own1, i1, false)) {
+        return false;
+      }
+
+      if (!foot.is_solid && is_blocked(j, own0, own1, true)) {
+        return false;
       }
     }
 
@@ -212,6 +415,8 @@ namespace quadwar_app::object {
           { footprint.begin() + (j * size.x()),
             footprint.begin() + ((j + 1) * size.x()) });
     }
+
+    mark_changed(en, { x0, y0 }, { x1, y1 });
   }
 
   void pathmap::subtract(
@@ -252,6 +457,124 @@ namespace quadwar_app::object {
           { footprint.begin() + (j * size.x()),
             footprint.begin() + ((j + 1) * size.x()) });
     }
+
+    mark_changed(en, { x0, y0 }, { x1, y1 });
+  }
+
+  void pathmap::add(entity           en,
+                    const vec2z      position,
+                    const footprint &foot) noexcept {
+
+    const auto width  = en.get(n_width);
+    const auto height = en.get(n_height);
+
+    const auto x0 = position.x() - foot.center.x();
+    const auto y0 = position.y() - foot.center.y();
+
+    const auto x1 = x0 + foot.size.x();
+    const auto y1 = y0 + foot.size.y();
+
+    if (x0 < 0 || y0 < 0 || x1 >= width || y1 >= height) {
+      error_("Invalid position.", __FUNCTION__);
+      return;
+    }
+
+    for (sl::index j = 0; j < foot.size.y(); j++) {
+      const auto &s = foot.rows[j];
+
+      if (s.length > 0) {
+        const auto row = foot.bytes.begin() +
+                         (j * foot.size.x() + s.start);
+
+        en.bytes_write_delta((y0 + j) * width + x0 + s.start,
+                             { row, row + s.length });
+      }
+    }
+
+    mark_changed(en, { x0, y0 }, { x1, y1 });
+  }
+
+  void pathmap::subtract(entity           en,
+                         const vec2z      position,
+                         const footprint &foot) noexcept {
+
+    const auto width  = en.get(n_width);
+    const auto height = en.get(n_height);
+
+    const auto x0 = position.x() - foot.center.x();
+    const auto y0 = position.y() - foot.center.y();
+
+    const auto x1 = x0 + foot.size.x();
+    const auto y1 = y0 + foot.size.y();
+
+    if (x0 < 0 || y0 < 0 || x1 >= width || y1 >= height) {
+      error_("Invalid position.", __FUNCTION__);
+      return;
+    }
+
+    for (sl::index j = 0; j < foot.size.y(); j++) {
+      const auto &s = foot.rows[j];
+
+      if (s.length > 0) {
+        const auto row = foot.bytes.begin() +
+                         (j * foot.size.x() + s.start);
+
+        en.bytes_erase_delta((y0 + j) * width + x0 + s.start,
+                             { row, row + s.length });
+      }
+    }
+
+    mark_changed(en, { x0, y0 }, { x1, y1 });
+  }
+
+  void pathmap::move(entity           en,
+                     const vec2z      position,
+                     const vec2z      new_position,
+                     const footprint &foot) noexcept {
+
+    if (position == new_position) {
+      return;
+    }
+
+    const auto n = direction_of(new_position - position);
+
+    if (n < 0) {
+      subtract(en, position, foot);
+      add(en, new_position, foot);
+      return;
+    }
+
+    const auto width  = en.get(n_width);
+    const auto height = en.get(n_height);
+
+    const auto x0 = min(position.x(), new_position.x()) -
+                    foot.center.x();
+    const auto y0 = min(position.y(), new_position.y()) -
+                    foot.center.y();
+
+    const auto x1 = max(position.x(), new_position.x()) -
+                    foot.center.x() + foot.size.x();
+    const auto y1 = max(position.y(), new_position.y()) -
+                    foot.center.y() + foot.size.y();
+
+    if (x0 < 0 || y0 < 0 || x1 >= width || y1 >= height) {
+      error_("Invalid position.", __FUNCTION__);
+      return;
+    }
+
+    const auto nx0 = new_position.x() - foot.center.x();
+    const auto ny0 = new_position.y() - foot.center.y();
+
+    const auto &e = foot.edges[n];
+
+    for (auto &s : e.spans) {
+      const auto delta = e.deltas.begin() + s.offset;
+
+      en.bytes_write_delta((ny0 + s.y) * width + nx0 + s.x,
+                           { delta, delta + s.length });
+    }
+
+    mark_changed(en, { x0, y0 }, { x1, y1 });
   }
 
   auto pathmap::find_empty(
@@ -311,6 +634,27 @@ namespace quadwar_app::object {
            grid::nearest(position - area.min, area_size, area_dst);
   }
 
+  void pathmap::mark_changed(entity      en,
+                             const vec2z min,
+                             const vec2z max) noexcept {
+
+    const auto width    = en.get(n_width);
+    const auto blocks_x = (width + block_size - 1) / block_size;
+
+    const auto x0 = min.x() / block_size;
+    const auto y0 = min.y() / block_size;
+    const auto x1 = (max.x() - 1) / block_size + 1;
+    const auto y1 = (max.y() - 1) / block_size + 1;
+
+    const auto ones = sl::vector<intval>(x1 - x0, 1);
+
+    for (auto y = y0; y < y1; y++) {
+      en.vec_write_delta(y * blocks_x + x0, ones);
+    }
+
+    en.apply_delta(n_revision, 1);
+  }
+
   auto pathmap::adjust_rect(
       const vec2z min, const vec2z max, const vec2z bounds) noexcept
       -> adjust_rect_result {
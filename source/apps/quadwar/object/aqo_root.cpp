@@ -25,6 +25,7 @@ namespace quadwar_app::object {
   sl::index root::n_is_launched = {};
   sl::index root::n_landscape   = {};
   sl::index root::n_pathmap     = {};
+  sl::index root::n_crowd       = {};
   sl::index root::n_slots       = {};
   sl::index root::n_units       = {};
 
@@ -36,6 +37,7 @@ namespace quadwar_app::object {
                  { .id = sets::root_is_launched, .scale = 1 },
                  { .id = sets::root_landscape, .value = -1 },
                  { .id = sets::root_pathmap, .value = -1 },
+                 { .id = sets::root_crowd, .value = -1 },
                  { .id = sets::root_slots, .value = -1 },
                  { .id = sets::root_units, .value = -1 } });
 
@@ -44,6 +46,7 @@ namespace quadwar_app::object {
     n_is_launched = index_of(sets::root_is_launched);
     n_landscape   = index_of(sets::root_landscape);
     n_pathmap     = index_of(sets::root_pathmap);
+    n_crowd       = index_of(sets::root_crowd);
     n_slots       = index_of(sets::root_slots);
     n_units       = index_of(sets::root_units);
   }
@@ -87,6 +90,10 @@ namespace quadwar_app::object {
     en.set(n_pathmap, static_cast<int64_t>(id_pathmap));
   }
 
+  void root::set_crowd(entity en, sl::index id_crowd) {
+    en.set(n_crowd, static_cast<int64_t>(id_crowd));
+  }
+
   auto root::get_version(entity en) -> sl::index {
     return static_cast<sl::index>(en.get(n_version));
   }
@@ -107,6 +114,10 @@ namespace quadwar_app::object {
     return as_index(en.get(n_pathmap, -1));
   }
 
+  auto root::get_crowd(entity en) -> sl::index {
+    return as_index(en.get(n_crowd, -1));
+  }
+
   auto root::get_slots(entity en) -> sl::index {
     return as_index(en.get(n_slots, -1));
   }
@@ -14,17 +14,22 @@
 
 #include "../../../laplace/core/utils.h"
 #include "../../../laplace/engine/eval/integral.h"
+#include "crowd.h"
+#include "footprint.h"
 #include "landscape.h"
 #include "pathmap.h"
 #include "player.h"
 #include "root.h"
+#include <algorithm>
+#include <cstdlib>
 
 namespace quadwar_app::object {
   namespace access = engine::access;
   namespace eval   = engine::eval;
   namespace grid   = eval::grid;
 
-  using std::min, std::max, std::span, std::vector, engine::intval,
+  using std::min, std::max, std::abs, std::sort, std::unique,
+      std::span, std::vector, engine::intval,
       engine::vec2i, engine::vec2z, engine::id_undefined,
       std::shared_ptr, std::make_shared;
 
@@ -33,6 +38,10 @@ namespace quadwar_app::object {
   const engine::intval unit::default_collision_radius = 600;
   const engine::intval unit::default_movement_speed   = 200;
 
+  const sl::whole unit::stall_limit = 10;
+
+  const intval unit::separation_divisor = 2;
+
   sl::index unit::n_health           = {};
   sl::index unit::n_radius           = {};
   sl::index unit::n_collision_radius = {};
@@ -44,6 +53,11 @@ namespace quadwar_app::object {
   sl::index unit::n_target_order     = {};
   sl::index unit::n_target_x         = {};
   sl::index unit::n_target_y         = {};
+  sl::index unit::n_corridor_x0      = {};
+  sl::index unit::n_corridor_y0      = {};
+  sl::index unit::n_corridor_x1      = {};
+  sl::index unit::n_corridor_y1      = {};
+  sl::index unit::n_path_changed     = {};
 
   unit unit::m_proto(unit::proto);
 
@@ -61,7 +75,12 @@ namespace quadwar_app::object {
           { .id = sets::unit_y, .scale = sets::scale_real },
           { .id = sets::unit_target_order, .scale = 1 },
           { .id = sets::unit_target_x, .scale = sets::scale_real },
-          { .id = sets::unit_target_y, .scale = sets::scale_real } });
+          { .id = sets::unit_target_y, .scale = sets::scale_real },
+          { .id = sets::unit_corridor_x0, .scale = 1 },
+          { .id = sets::unit_corridor_y0, .scale = 1 },
+          { .id = sets::unit_corridor_x1, .scale = 1 },
+          { .id = sets::unit_corridor_y1, .scale = 1 },
+          { .id = sets::unit_path_changed, .scale = 1 } });
 
     n_health           = index_of(sets::unit_health);
     n_radius           = index_of(sets::unit_radius);
@@ -74,6 +93,11 @@ namespace quadwar_app::object {
     n_target_order     = index_of(sets::unit_target_order);
     n_target_x         = index_of(sets::unit_target_x);
     n_target_y         = index_of(sets::unit_target_y);
+    n_corridor_x0      = index_of(sets::unit_corridor_x0);
+    n_corridor_y0      = index_of(sets::unit_corridor_y0);
+    n_corridor_x1      = index_of(sets::unit_corridor_x1);
+    n_corridor_y1      = index_of(sets::unit_corridor_y1);
+    n_path_changed     = index_of(sets::unit_path_changed);
   }
 
   unit::unit() : basic_entity(dummy) {
@@ -81,10 +105,12 @@ namespace quadwar_app::object {
   }
 
   void unit::tick(access::world w) {
-    auto r   = w.get_entity(w.get_root());
-    auto map = w.get_entity(root::get_pathmap(r));
+    auto r      = w.get_entity(w.get_root());
+    auto map    = w.get_entity(root::get_pathmap(r));
+    auto lookup = w.get_entity(root::get_crowd(r));
 
     do_search(map);
+    do_separation(w, lookup);
     do_movement(map);
   }
 
@@ -177,12 +203,12 @@ namespace quadwar_app::object {
     const auto r_min = as_index(
         eval::div(u.get(n_collision_radius), scale, 1));
 
-    const auto foot_max = make_footprint(r_max);
-    const auto foot_min = make_footprint(r_min);
+    const auto &foot_max = footprint_of(r_max);
+    const auto &foot_min = footprint_of(r_min);
 
     auto p = pathmap::find_empty(
         path, { x0, y0 }, foot_max.size, foot_max.bytes);
-    pathmap::add(path, p, foot_min.size, foot_min.bytes);
+    pathmap::add(path, p, foot_min);
 
     u.set(n_x, p.x() * scale);
     u.set(n_y, p.y() * scale);
@@ -234,6 +260,17 @@ namespace quadwar_app::object {
     return en.get(n_health);
   }
 
+  auto unit::get_corridor(entity en) -> corridor {
+    return { .min = { as_index(en.get(n_corridor_x0)),
+                      as_index(en.get(n_corridor_y0)) },
+             .max = { as_index(en.get(n_corridor_x1)),
+                      as_index(en.get(n_corridor_y1)) } };
+  }
+
+  void unit::notify_path_changed(entity en) {
+    en.apply_delta(n_path_changed, 1);
+  }
+
   auto unit::get_position_scaled(entity en) -> view::vec2 {
     return { static_cast<view::real>(get_x(en)) / sets::scale_real,
              static_cast<view::real>(get_y(en)) / sets::scale_real };
@@ -243,14 +280,6 @@ namespace quadwar_app::object {
     return static_cast<view::real>(get_radius(en)) / sets::scale_real;
   }
 
-  auto unit::make_footprint(sl::whole radius) -> footprint_data {
-    const auto size = 1 + radius * 2;
-
-    return { .size   = { size, size },
-             .center = { radius, radius },
-             .bytes  = sl::vector<int8_t>(size * size, 1) };
-  }
-
   void unit::do_search(entity map) noexcept {
     if (pathmap::resolution == 0) {
       error_("Invalid pathmap resolution.", __FUNCTION__);
@@ -276,16 +305,16 @@ namespace quadwar_app::object {
       const auto radius = as_index(
           eval::div(get(n_radius), scale, 1));
 
-      const auto footprint = make_footprint(radius);
+      const auto &foot = footprint_of(radius);
 
       const auto src = [&]() {
         auto v = map.bytes_get_all();
 
-        const auto cx = footprint.center.x();
-        const auto cy = footprint.center.y();
+        const auto cx = foot.center.x();
+        const auto cy = foot.center.y();
 
-        const auto sx = footprint.size.x();
-        const auto sy = footprint.size.y();
+        const auto sx = foot.size.x();
+        const auto sy = foot.size.y();
 
         const auto px0 = x0 - cx;
         const auto py0 = y0 - cy;
@@ -297,8 +326,7 @@ namespace quadwar_app::object {
 
         for (sl::index j = j0; j < j1; j++)
           for (sl::index i = i0; i < i1; i++) {
-            v[(py0 + j) * width + px0 + i] -=
-                footprint.bytes[j * sx + i];
+            v[(py0 + j) * width + px0 + i] -= foot.bytes[j * sx + i];
           }
 
         return v;
@@ -307,8 +335,8 @@ namespace quadwar_app::object {
       m_pathmap.resize(width * height);
       for (auto &x : m_pathmap) { x = 0; }
 
-      grid::convolve(m_size, m_pathmap, src, footprint.size,
-                     footprint.center, footprint.bytes);
+      grid::convolve(m_size, m_pathmap, src, foot.size, foot.center,
+                     foot.bytes);
 
       m_destination = grid::nearest(p1, m_size, m_pathmap);
 
@@ -316,29 +344,288 @@ namespace quadwar_app::object {
           m_size, 16, m_pathmap,
           [](const int8_t x) { return x <= 0; }, p0, m_destination);
 
-      m_searching = true;
-      m_movement  = true;
+      m_searching  = true;
+      m_movement   = true;
+      m_replanning = false;
+      m_stall      = 0;
+      m_revisions  = pathmap::get_block_revisions(map);
 
+      reset_corridor();
       apply_delta(n_target_order, -1);
     }
 
+    if (m_replanning) {
+      do_replan(map, p0);
+      return;
+    }
+
     if (!m_searching) {
       return;
     }
 
+    auto status = eval::astar::status::progress;
+
     for (sl::index i = 0; i < 20; i++)
-      if (grid::path_search_loop(m_search) !=
-          eval::astar::status::progress) {
+      if (status = grid::path_search_loop(m_search);
+          status != eval::astar::status::progress) {
         m_searching = false;
         break;
       }
 
-    m_current   = -1;
     m_waypoints = grid::path_search_finish(m_search);
 
+    find_waypoint(p0);
+
+    if (status == eval::astar::status::success) {
+      /*  Keep the incremental search state, so the path can be
+       *  repaired when the pathmap is changed.
+       */
+      m_replan = grid::replan_init(
+          m_size, 16, m_pathmap,
+          [](const int8_t x) { return x <= 0; }, p0, m_destination);
+
+      m_searching  = true;
+      m_replanning = true;
+
+      update_corridor(map, p0);
+    }
+  }
+
+  void unit::do_replan(entity map, vec2z position) noexcept {
+    /*  The pathmap notifies the unit when a block of the
+     *  corridor was changed.
+     */
+    if (const auto n = get(n_path_changed); n > 0) {
+      apply_delta(n_path_changed, -n);
+      do_refresh(map, position);
+    }
+
+    if (!m_replanning) {
+      return;
+    }
+
+    if (const auto source = position.y() * m_size.x() + position.x();
+        source != m_replan.dstar.source) {
+      grid::replan_move(m_replan, position);
+      m_searching = true;
+    }
+
+    if (!m_searching) {
+      return;
+    }
+
+    auto status = eval::astar::status::progress;
+
+    for (sl::index i = 0; i < 20; i++)
+      if (status = grid::replan_loop(m_replan);
+          status != eval::astar::status::progress) {
+        break;
+      }
+
+    if (status == eval::astar::status::failed) {
+      /*  No path to the destination. Search again for the
+       *  nearest position.
+       */
+      stop_replanning();
+      apply_delta(n_target_order, 1);
+      return;
+    }
+
+    /*  Until the search is done, the unit follows the current
+     *  path.
+     */
+
+    if (status == eval::astar::status::success) {
+      m_searching = false;
+      m_waypoints = grid::replan_finish(m_replan);
+
+      find_waypoint(position);
+      update_corridor(map, position);
+    }
+  }
+
+  void unit::do_refresh(entity map, vec2z position) noexcept {
+    if (map.vec_get_size() != m_revisions.size()) {
+      stop_replanning();
+      apply_delta(n_target_order, 1);
+      return;
+    }
+
+    auto changed = sl::vector<vec2z> {};
+
+    for (const auto n : m_corridor) {
+      if (const auto revision = map.vec_get(n);
+          revision != m_revisions[n]) {
+        m_revisions[n] = revision;
+        do_refresh_block(map, position, n, changed);
+      }
+    }
+
+    if (!changed.empty()) {
+      grid::replan_update(m_replan, changed);
+      m_searching = true;
+    }
+  }
+
+  void unit::do_refresh_block(entity             map,
+                              vec2z              position,
+                              sl::index          n,
+                              sl::vector<vec2z> &changed) noexcept {
+    /*  Read the block with the margin, subtract own footprint
+     *  and convolve it again.
+     */
+
+    const auto scale  = sets::scale_real / pathmap::resolution;
+    const auto width  = m_size.x();
+    const auto height = m_size.y();
+
+    const auto radius = as_index(eval::div(get(n_radius), scale, 1));
+
+    const auto &foot = footprint_of(radius);
+
+    const auto block    = pathmap::block_size;
+    const auto blocks_x = (width + block - 1) / block;
+
+    const auto bx0 = (n % blocks_x) * block;
+    const auto by0 = (n / blocks_x) * block;
+    const auto bx1 = min(bx0 + block, width);
+    const auto by1 = min(by0 + block, height);
+
+    const auto x0 = max<sl::index>(bx0 - foot.center.x(), 0);
+    const auto y0 = max<sl::index>(by0 - foot.center.y(), 0);
+    const auto x1 = min(bx1 + foot.center.x() + 1, width);
+    const auto y1 = min(by1 + foot.center.y() + 1, height);
+
+    const auto size = vec2z { x1 - x0, y1 - y0 };
+
+    auto src = sl::vector<int8_t>(size.x() * size.y());
+    auto dst = sl::vector<int8_t>(src.size());
+
+    for (sl::index j = 0; j < size.y(); j++) {
+      const auto row = src.begin() + j * size.x();
+      map.bytes_read((y0 + j) * width + x0, { row, row + size.x() });
+    }
+
+    const auto px0 = position.x() - foot.center.x();
+    const auto py0 = position.y() - foot.center.y();
+
+    for (sl::index j = 0; j < foot.size.y(); j++)
+      for (sl::index i = 0; i < foot.size.x(); i++) {
+        const auto x = px0 + i;
+        const auto y = py0 + j;
+
+        if (x >= x0 && y >= y0 && x < x1 && y < y1) {
+          src[(y - y0) * size.x() + (x - x0)] -=
+              foot.bytes[j * foot.size.x() + i];
+        }
+      }
+
+    grid::convolve(size, dst, src, foot.size, foot.center,
+                   foot.bytes);
+
+    for (auto y = by0; y < by1; y++)
+      for (auto x = bx0; x < bx1; x++) {
+        const auto value = dst[(y - y0) * size.x() + (x - x0)];
+        auto      &cell  = m_pathmap[y * width + x];
+
+        if ((cell <= 0) != (value <= 0)) {
+          changed.emplace_back(vec2z { x, y });
+        }
+
+        cell = value;
+      }
+  }
+
+  void unit::update_corridor(entity map, vec2z position) noexcept {
+    m_corridor.clear();
+
+    const auto block    = pathmap::block_size;
+    const auto blocks_x = (m_size.x() + block - 1) / block;
+    const auto blocks_y = (m_size.y() + block - 1) / block;
+
+    if (m_current < 0 || m_current >= m_waypoints.size() ||
+        blocks_x <= 0 || blocks_y <= 0) {
+      reset_corridor();
+      return;
+    }
+
+    const auto scale  = sets::scale_real / pathmap::resolution;
+    const auto radius = as_index(eval::div(get(n_radius), scale, 1));
+    const auto margin = footprint_of(radius).center.x() + 1;
+
+    auto bmin = vec2z { blocks_x, blocks_y };
+    auto bmax = vec2z {};
+
+    /*  Sample each segment of the remaining path at the block
+     *  size step and take the blocks within the margin.
+     */
+    auto add_point = [&](const vec2z p) {
+      const auto x0 = max<sl::index>(p.x() - margin, 0) / block;
+      const auto y0 = max<sl::index>(p.y() - margin, 0) / block;
+      const auto x1 = min(p.x() + margin, m_size.x() - 1) / block + 1;
+      const auto y1 = min(p.y() + margin, m_size.y() - 1) / block + 1;
+
+      for (auto y = y0; y < y1; y++)
+        for (auto x = x0; x < x1; x++) {
+          m_corridor.emplace_back(y * blocks_x + x);
+        }
+
+      bmin = vec2z { min(bmin.x(), x0), min(bmin.y(), y0) };
+      bmax = vec2z { max(bmax.x(), x1), max(bmax.y(), y1) };
+    };
+
+    auto from = position;
+
+    for (auto i = m_current; i < m_waypoints.size(); i++) {
+      const auto to    = m_waypoints[i];
+      const auto d     = to - from;
+      const auto steps = max<sl::index>(
+          1, max(abs(d.x()), abs(d.y())) / block + 1);
+
+      for (sl::index k = 0; k <= steps; k++) {
+        add_point(from + d * k / steps);
+      }
+
+      from = to;
+    }
+
+    sort(m_corridor.begin(), m_corridor.end());
+    m_corridor.erase(unique(m_corridor.begin(), m_corridor.end()),
+                     m_corridor.end());
+
+    set(n_corridor_x0, bmin.x());
+    set(n_corridor_y0, bmin.y());
+    set(n_corridor_x1, bmax.x());
+    set(n_corridor_y1, bmax.y());
+
+    /*  The blocks out of the previous corridor may be not
+     *  refreshed.
+     */
+    do_refresh(map, position);
+  }
+
+  void unit::reset_corridor() noexcept {
+    m_corridor.clear();
+
+    set(n_corridor_x0, 0);
+    set(n_corridor_y0, 0);
+    set(n_corridor_x1, 0);
+    set(n_corridor_y1, 0);
+  }
+
+  void unit::stop_replanning() noexcept {
+    m_searching  = false;
+    m_replanning = false;
+
+    reset_corridor();
+  }
+
+  void unit::find_waypoint(vec2z position) noexcept {
+    m_current = -1;
+
     for (sl::index i = m_waypoints.size() - 1; i >= 0; i--)
       if (grid::trace_line(
-              m_size, p0, m_waypoints[i], [&](const vec2z p) {
+              m_size, position, m_waypoints[i], [&](const vec2z p) {
                 if (p.x() < 0 || p.y() < 0 || p.x() >= m_size.x() ||
                     p.y() >= m_size.y()) {
                   return false;
@@ -355,6 +642,65 @@ namespace quadwar_app::object {
     }
   }
 
+  void unit::do_separation(world w, entity lookup) noexcept {
+    m_separation = vec2i {};
+
+    if (!m_movement || !lookup.exist()) {
+      return;
+    }
+
+    const auto x      = get(n_x);
+    const auto y      = get(n_y);
+    const auto radius = get(n_radius);
+
+    auto push_x = intval {};
+    auto push_y = intval {};
+
+    for (const auto id : crowd::get_near(lookup, { x, y })) {
+      if (id == get_id()) {
+        continue;
+      }
+
+      auto u = w.get_entity(id);
+
+      if (!u.exist()) {
+        continue;
+      }
+
+      const auto dx     = x - get_x(u);
+      const auto dy     = y - get_y(u);
+      const auto range  = radius + get_radius(u);
+      const auto square = dx * dx + dy * dy;
+
+      if (square >= range * range) {
+        continue;
+      }
+
+      if (square == 0) {
+        /*  Same position. Push apart by the id order.
+         */
+        push_x += id < get_id() ? range : -range;
+        continue;
+      }
+
+      const auto distance = eval::sqrt(square, 1);
+
+      push_x += eval::div(dx * (range - distance), distance, 1);
+      push_y += eval::div(dy * (range - distance), distance, 1);
+    }
+
+    const auto limit  = get(n_movement_speed) / separation_divisor;
+    const auto length = eval::sqrt(push_x * push_x + push_y * push_y,
+                                   1);
+
+    if (length > limit) {
+      push_x = eval::div(push_x * limit, length, 1);
+      push_y = eval::div(push_y * limit, length, 1);
+    }
+
+    m_separation = vec2i { push_x, push_y };
+  }
+
   void unit::do_movement(entity map) noexcept {
     if (!m_movement) {
       return;
@@ -377,6 +723,12 @@ namespace quadwar_app::object {
 
     while (delta > 0) {
       if (m_current < 0 || m_current >= m_waypoints.size()) {
+        if (!m_searching) {
+          /*  Arrived, or the new search is ordered.
+           */
+          stop_replanning();
+        }
+
         m_movement = m_searching;
         break;
       }
@@ -409,40 +761,85 @@ namespace quadwar_app::object {
       delta -= distance;
     }
 
-    if (ox != ox0 || oy != oy0) {
-      const auto x0 = as_index(eval::div(ox0, scale, 1));
-      const auto y0 = as_index(eval::div(oy0, scale, 1));
+    if (ox == ox0 && oy == oy0) {
+      return;
+    }
+
+    /*  Try the step with the separation, then the step turned
+     *  by 45 degrees to each side, starting from the side the
+     *  separation pushes to.
+     */
 
-      const auto x = as_index(eval::div(ox, scale, 1));
-      const auto y = as_index(eval::div(oy, scale, 1));
+    const auto sx = ox - ox0;
+    const auto sy = oy - oy0;
 
-      if (x0 != x || y0 != y) {
-        const auto radius_min = as_index(
-            eval::div(get(n_collision_radius), scale, 1));
+    const auto sep_x = m_separation.x();
+    const auto sep_y = m_separation.y();
 
-        const auto radius_max = as_index(
-            eval::div(get(n_radius), scale, 1));
+    const auto side   = sx * sep_y - sy * sep_x < 0 ? -1 : 1;
+    const auto sqrt2  = eval::sqrt2(sets::scale_real);
+    const auto rotate = [&](const intval sign) {
+      return vec2i {
+        ox0 + eval::div(sx - sign * sy, sqrt2, sets::scale_real),
+        oy0 + eval::div(sign * sx + sy, sqrt2, sets::scale_real)
+      };
+    };
 
-        const auto foot_max = make_footprint(radius_max);
-        const auto foot_min = make_footprint(radius_min);
+    const vec2i steps[] = { { ox + sep_x, oy + sep_y },
+                            rotate(side),
+                            rotate(-side) };
 
-        if (!pathmap::check_move(
-                map, { x0, y0 }, foot_max.size, foot_max.bytes,
-                { x, y }, foot_min.size, foot_min.bytes)) {
-          /*  Collision.
-           */
-          m_searching = false;
-          m_movement  = false;
-          return;
-        }
+    for (const auto &step : steps) {
+      if (try_move(map, { ox0, oy0 }, step)) {
+        m_stall = 0;
 
-        pathmap::subtract(
-            map, { x0, y0 }, foot_min.size, foot_min.bytes);
-        pathmap::add(map, { x, y }, foot_min.size, foot_min.bytes);
+        set(n_x, step.x());
+        set(n_y, step.y());
+        return;
       }
+    }
+
+    /*  Collision. Wait for the path to be repaired.
+     */
+    if (m_replanning && m_stall < stall_limit) {
+      m_stall++;
+      return;
+    }
+
+    stop_replanning();
+    m_movement = false;
+  }
 
-      set(n_x, ox);
-      set(n_y, oy);
+  auto unit::try_move(entity       map,
+                      const vec2i &from,
+                      const vec2i &to) noexcept -> bool {
+    const auto scale = sets::scale_real / pathmap::resolution;
+
+    const auto x0 = as_index(eval::div(from.x(), scale, 1));
+    const auto y0 = as_index(eval::div(from.y(), scale, 1));
+
+    const auto x = as_index(eval::div(to.x(), scale, 1));
+    const auto y = as_index(eval::div(to.y(), scale, 1));
+
+    if (x0 == x && y0 == y) {
+      return true;
+    }
+
+    const auto radius_min = as_index(
+        eval::div(get(n_collision_radius), scale, 1));
+
+    const auto radius_max = as_index(
+        eval::div(get(n_radius), scale, 1));
+
+    const auto &foot_max = footprint_of(radius_max);
+    const auto &foot_min = footprint_of(radius_min);
+
+    if (!pathmap::check_move(
+            map, { x0, y0 }, foot_max, { x, y }, foot_min)) {
+      return false;
     }
+
+    pathmap::move(map, { x0, y0 }, { x, y }, foot_min);
+    return true;
   }
 }
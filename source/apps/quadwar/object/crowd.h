@@ -0,0 +1,64 @@
+/*  apps/quadwar/object/crowd.h
+ *
+ *      Spatial grid of the units for the neighbor lookup.
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#ifndef quadwar_object_crowd_h
+#define quadwar_object_crowd_h
+
+#include "../../../laplace/engine/basic_entity.h"
+#include "defs.h"
+
+namespace quadwar_app::object {
+  /*  The grid is rebuilt each tick from the committed unit
+   *  positions, so the units read it one tick behind.
+   *
+   *  Vector layout: cell offsets, then unit ids sorted by
+   *  cell and by id.
+   */
+  class crowd : public engine::basic_entity, helper {
+  public:
+    /*  Units closer than the cell size are in the adjacent
+     *  cells. Includes the margin for the movement during
+     *  one tick.
+     */
+    static const engine::intval cell_size;
+
+    crowd();
+    ~crowd() override = default;
+
+    void tick(engine::access::world w) override;
+
+    static auto create(world w, sl::whole unit_count) -> sl::index;
+
+    /*  Returns the units in 3x3 cells around the position.
+     */
+    [[nodiscard]] static auto get_near(
+        entity en, const engine::vec2i position)
+        -> sl::vector<sl::index>;
+
+  private:
+    crowd(proto_tag);
+
+    [[nodiscard]] static auto cell_of(
+        const engine::intval x,
+        const sl::whole      size) noexcept -> sl::index;
+
+    static sl::index n_width;
+    static sl::index n_height;
+    static sl::index n_capacity;
+
+    static crowd m_proto;
+  };
+}
+
+#endif
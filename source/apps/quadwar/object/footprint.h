@@ -0,0 +1,76 @@
+/*  apps/quadwar/object/footprint.h
+ *
+ *      Unit footprints on the pathmap. Footprints are built
+ *      once per radius and shared by all the units.
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#ifndef quadwar_object_footprint_h
+#define quadwar_object_footprint_h
+
+#include "defs.h"
+#include <array>
+
+namespace quadwar_app::object {
+  struct footprint {
+    static constexpr sl::whole direction_count = 8;
+
+    /*  Nonzero cells of a row are in range
+     *  [start, start + length).
+     */
+    struct row_span {
+      sl::index start  = {};
+      sl::whole length = {};
+    };
+
+    /*  Cells of a row from the first changed one to the
+     *  last. Coordinates are relative to the top-left corner
+     *  of the moved footprint, so they may be from -1 to size.
+     */
+    struct edge_span {
+      sl::index x      = {};
+      sl::index y      = {};
+      sl::whole length = {};
+      sl::index offset = {};
+    };
+
+    /*  Cell deltas for the move by one cell.
+     */
+    struct edge_data {
+      sl::vector<edge_span> spans;
+      sl::vector<int8_t>    deltas;
+    };
+
+    engine::vec2z        size;
+    engine::vec2z        center;
+    sl::vector<int8_t>   bytes;
+    sl::vector<row_span> rows;
+
+    /*  All the cells of each row span are nonzero.
+     */
+    bool is_solid = false;
+
+    std::array<edge_data, direction_count> edges;
+  };
+
+  /*  Returns the shared footprint for the radius. The
+   *  reference is valid until the program exits.
+   */
+  [[nodiscard]] auto footprint_of(sl::whole radius)
+      -> const footprint &;
+
+  /*  Returns the edge index for the move by one cell, or -1.
+   */
+  [[nodiscard]] auto direction_of(engine::vec2z delta) noexcept
+      -> sl::index;
+}
+
+#endif
@@ -15,6 +15,7 @@
 
 #include "../../../laplace/engine/basic_entity.h"
 #include "defs.h"
+#include "footprint.h"
 
 namespace quadwar_app::object {
   class pathmap : public engine::basic_entity, helper {
@@ -23,9 +24,18 @@ namespace quadwar_app::object {
     static const sl::whole spawn_distance;
     static const sl::whole search_scale;
 
+    /*  Changes are counted per square block of cells.
+     */
+    static const sl::whole block_size;
+
     pathmap();
     ~pathmap() override = default;
 
+    /*  Notifies the units which corridors have the blocks
+     *  changed since the last tick.
+     */
+    void tick(engine::access::world w) override;
+
     static auto create(world w) -> sl::index;
 
     static void set_tiles(
@@ -39,6 +49,18 @@ namespace quadwar_app::object {
     [[nodiscard]] static auto get_tiles(entity en)
         -> sl::vector<int8_t>;
 
+    /*  Total count of the changes. Searches compare the
+     *  revision to find out if the pathmap was changed.
+     */
+    [[nodiscard]] static auto get_revision(entity en)
+        -> engine::intval;
+
+    /*  Count of the changes for each block. Blocks are stored
+     *  in rows.
+     */
+    [[nodiscard]] static auto get_block_revisions(entity en)
+        -> sl::vector<engine::intval>;
+
     [[nodiscard]] static auto check_move(
         entity                        en,
         const engine::vec2z           position,
@@ -48,6 +70,16 @@ namespace quadwar_app::object {
         const engine::vec2z           new_size,
         const std::span<const int8_t> new_footprint) noexcept -> bool;
 
+    /*  Only the cells of the new footprint out of the current
+     *  one are checked.
+     */
+    [[nodiscard]] static auto check_move(
+        entity              en,
+        const engine::vec2z position,
+        const footprint    &foot,
+        const engine::vec2z new_position,
+        const footprint    &new_foot) noexcept -> bool;
+
     static void add(
         entity                        en,
         const engine::vec2z           position,
@@ -60,6 +92,22 @@ namespace quadwar_app::object {
         const engine::vec2z           size,
         const std::span<const int8_t> footprint) noexcept;
 
+    static void add(entity              en,
+                    const engine::vec2z position,
+                    const footprint    &foot) noexcept;
+
+    static void subtract(entity              en,
+                         const engine::vec2z position,
+                         const footprint    &foot) noexcept;
+
+    /*  Same as subtract and add. For the move by one cell only
+     *  the edge cells are changed.
+     */
+    static void move(entity              en,
+                     const engine::vec2z position,
+                     const engine::vec2z new_position,
+                     const footprint    &foot) noexcept;
+
     [[nodiscard]] static auto find_empty(
         entity                        en,
         const engine::vec2z           position,
@@ -75,6 +123,10 @@ namespace quadwar_app::object {
       engine::vec2z max = {};
     };
 
+    static void mark_changed(entity              en,
+                             const engine::vec2z min,
+                             const engine::vec2z max) noexcept;
+
     [[nodiscard]] static auto adjust_rect(
         const engine::vec2z min,
         const engine::vec2z max,
@@ -82,8 +134,14 @@ namespace quadwar_app::object {
 
     static sl::index n_width;
     static sl::index n_height;
+    static sl::index n_revision;
 
     static pathmap m_proto;
+
+    /*  Block revisions seen on the last tick.
+     */
+    sl::vector<engine::intval> m_seen;
+    sl::vector<sl::index>      m_changed;
   };
 }
 
@@ -28,12 +28,14 @@ namespace quadwar_app::object {
     static void status_changed(entity en);
     static void set_landscape(entity en, sl::index id_landscape);
     static void set_pathmap(entity en, sl::index id_pathmap);
+    static void set_crowd(entity en, sl::index id_crowd);
 
     [[nodiscard]] static auto get_version(entity en) -> sl::index;
     [[nodiscard]] static auto is_loading(entity en) -> bool;
     [[nodiscard]] static auto is_launched(entity en) -> bool;
     [[nodiscard]] static auto get_landscape(entity en) -> sl::index;
     [[nodiscard]] static auto get_pathmap(entity en) -> sl::index;
+    [[nodiscard]] static auto get_crowd(entity en) -> sl::index;
     [[nodiscard]] static auto get_slots(entity en) -> sl::index;
     [[nodiscard]] static auto get_units(entity en) -> sl::index;
 
@@ -46,6 +48,7 @@ namespace quadwar_app::object {
     static sl::index n_is_launched;
     static sl::index n_landscape;
     static sl::index n_pathmap;
+    static sl::index n_crowd;
     static sl::index n_slots;
     static sl::index n_units;
 
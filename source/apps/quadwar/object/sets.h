@@ -26,6 +26,7 @@ namespace quadwar_app::object::sets {
     root_launch,
     root_landscape,
     root_pathmap,
+    root_crowd,
     root_slots,
     root_units,
 
@@ -47,9 +48,19 @@ namespace quadwar_app::object::sets {
     unit_target_order,
     unit_target_x,
     unit_target_y,
+    unit_corridor_x0,
+    unit_corridor_y0,
+    unit_corridor_x1,
+    unit_corridor_y1,
+    unit_path_changed,
 
     pathmap_width,
     pathmap_height,
+    pathmap_revision,
+
+    crowd_width,
+    crowd_height,
+    crowd_capacity,
 
     _count
   };
@@ -23,6 +23,13 @@ namespace quadwar_app::object {
   public:
     enum order : sl::index { o_move };
 
+    /*  Pathmap blocks around the remaining path, [min, max).
+     */
+    struct corridor {
+      engine::vec2z min;
+      engine::vec2z max;
+    };
+
     static const engine::intval default_health;
     static const engine::intval default_radius;
     static const engine::intval default_collision_radius;
@@ -53,6 +60,12 @@ namespace quadwar_app::object {
     [[nodiscard]] static auto get_radius(entity en) -> engine::intval;
     [[nodiscard]] static auto get_health(entity en) -> engine::intval;
 
+    /*  The pathmap notifies the units whose corridor has
+     *  changed blocks.
+     */
+    [[nodiscard]] static auto get_corridor(entity en) -> corridor;
+    static void notify_path_changed(entity en);
+
     [[nodiscard]] static auto get_position_scaled(entity en)
         -> view::vec2;
 
@@ -63,18 +76,39 @@ namespace quadwar_app::object {
     unit(proto_tag);
 
   private:
-    struct footprint_data {
-      engine::vec2z      size;
-      engine::vec2z      center;
-      sl::vector<int8_t> bytes;
-    };
+    /*  Ticks to wait for the repaired path after a collision.
+     */
+    static const sl::whole stall_limit;
 
-    [[nodiscard]] static auto make_footprint(sl::whole radius)
-        -> footprint_data;
+    /*  Separation is limited to the movement speed divided by
+     *  the value.
+     */
+    static const engine::intval separation_divisor;
 
     void do_search(entity map) noexcept;
+    void do_replan(entity map, engine::vec2z position) noexcept;
+    void do_refresh(entity map, engine::vec2z position) noexcept;
+    void do_refresh_block(
+        entity                     map,
+        engine::vec2z              position,
+        sl::index                  n,
+        sl::vector<engine::vec2z> &changed) noexcept;
+    void update_corridor(entity map, engine::vec2z position) noexcept;
+    void reset_corridor() noexcept;
+    void stop_replanning() noexcept;
+    void do_separation(world w, entity lookup) noexcept;
     void do_movement(entity map) noexcept;
 
+    /*  Check and move the footprint. Returns false on
+     *  collision.
+     */
+    [[nodiscard]] auto try_move(
+        entity               map,
+        const engine::vec2i &from,
+        const engine::vec2i &to) noexcept -> bool;
+
+    void find_waypoint(engine::vec2z position) noexcept;
+
     static unit m_proto;
 
     static sl::index n_health;
@@ -88,15 +122,26 @@ namespace quadwar_app::object {
     static sl::index n_target_order;
     static sl::index n_target_x;
     static sl::index n_target_y;
-
-    bool                       m_searching = false;
-    bool                       m_movement  = false;
-    sl::index                  m_current   = {};
-    engine::vec2z              m_destination;
-    engine::eval::grid::_state m_search;
-    sl::vector<int8_t>         m_pathmap;
-    engine::vec2z              m_size;
-    sl::vector<engine::vec2z>  m_waypoints;
+    static sl::index n_corridor_x0;
+    static sl::index n_corridor_y0;
+    static sl::index n_corridor_x1;
+    static sl::index n_corridor_y1;
+    static sl::index n_path_changed;
+
+    bool                              m_searching  = false;
+    bool                              m_movement   = false;
+    bool                              m_replanning = false;
+    sl::index                         m_current    = {};
+    sl::whole                         m_stall      = {};
+    engine::vec2z                     m_destination;
+    engine::vec2i                     m_separation;
+    engine::eval::grid::_state        m_search;
+    engine::eval::grid::_replan_state m_replan;
+    sl::vector<int8_t>                m_pathmap;
+    engine::vec2z                     m_size;
+    sl::vector<engine::vec2z>         m_waypoints;
+    sl::vector<engine::intval>        m_revisions;
+    sl::vector<sl::index>             m_corridor;
   };
 }
 
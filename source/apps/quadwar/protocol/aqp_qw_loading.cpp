@@ -14,6 +14,7 @@
 
 #include "../action/pathmap_reset.h"
 #include "../action/unit_place.h"
+#include "../object/crowd.h"
 #include "../object/game_clock.h"
 #include "../object/landscape.h"
 #include "../object/pathmap.h"
@@ -23,7 +24,7 @@
 
 namespace quadwar_app::protocol {
   using std::make_shared, engine::basic_entity, object::root,
-      object::pathmap, object::player, object::unit,
+      object::pathmap, object::crowd, object::player, object::unit,
       object::game_clock, object::landscape, action::pathmap_reset,
       action::unit_place, engine::id_undefined, engine::ptr_impact;
 
@@ -41,6 +42,8 @@ namespace quadwar_app::protocol {
     auto id_path = pathmap::create(w);
     auto units   = unit::spawn_start_units(w, m_unit_count);
 
+    crowd::create(w, units.size());
+
     auto ev          = ptr_impact {};
     auto child_count = sl::whole {};
 
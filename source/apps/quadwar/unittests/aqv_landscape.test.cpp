@@ -0,0 +1,75 @@
+/*  apps/quadwar/unittests/aqv_landscape.test.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../view/landscape.h"
+#include <gtest/gtest.h>
+#include <limits>
+
+namespace quadwar_app::test {
+  using view::landscape, view::camera, view::real, view::vec2;
+
+  /*  4 by 3 chunks of 32 tiles. With the tile size 1 chunk n
+   *  covers [32 n - .25, 32 (n + 1) - .25).
+   */
+  static auto visible(vec2 v0, vec2 v1, real tile_size = 1.f)
+      -> landscape::chunk_range {
+    return landscape::get_visible_chunks({ .min = v0, .max = v1 },
+                                         tile_size, 4, 3);
+  }
+
+  static auto is_empty(const landscape::chunk_range &r) -> bool {
+    return r.x1 < r.x0 || r.y1 < r.y0;
+  }
+
+  TEST(quadwar, view_landscape_visible_all) {
+    const auto inf = std::numeric_limits<real>::max();
+
+    const auto a = visible({ -10.f, -10.f }, { 1000.f, 1000.f });
+    const auto b = visible({ -inf, -inf }, { inf, inf });
+
+    for (const auto &r : { a, b }) {
+      EXPECT_EQ(r.x0, 0);
+      EXPECT_EQ(r.y0, 0);
+      EXPECT_EQ(r.x1, 3);
+      EXPECT_EQ(r.y1, 2);
+    }
+  }
+
+  TEST(quadwar, view_landscape_visible_part) {
+    const auto r = visible({ 40.f, 70.f }, { 70.f, 90.f });
+
+    EXPECT_EQ(r.x0, 1);
+    EXPECT_EQ(r.y0, 2);
+    EXPECT_EQ(r.x1, 2);
+    EXPECT_EQ(r.y1, 2);
+
+    const auto edge = visible({ 31.75f, 0.f }, { 63.f, 0.f });
+
+    EXPECT_EQ(edge.x0, 1);
+    EXPECT_EQ(edge.x1, 1);
+
+    const auto scaled = visible({ 130.f, 0.f }, { 200.f, 10.f }, 2.f);
+
+    EXPECT_EQ(scaled.x0, 2);
+    EXPECT_EQ(scaled.x1, 3);
+    EXPECT_EQ(scaled.y0, 0);
+    EXPECT_EQ(scaled.y1, 0);
+  }
+
+  TEST(quadwar, view_landscape_visible_none) {
+    EXPECT_TRUE(is_empty(visible({ -50.f, 0.f }, { -1.f, 10.f })));
+    EXPECT_TRUE(is_empty(visible({ 200.f, 0.f }, { 300.f, 10.f })));
+    EXPECT_TRUE(is_empty(visible({ 0.f, -50.f }, { 10.f, -1.f })));
+    EXPECT_TRUE(is_empty(visible({ 0.f, 100.f }, { 10.f, 200.f })));
+    EXPECT_TRUE(is_empty(visible({ 0.f, 0.f }, { 10.f, 10.f }, 0.f)));
+  }
+}
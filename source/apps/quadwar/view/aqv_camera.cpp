@@ -12,8 +12,10 @@
 
 #include "camera.h"
 
+#include <limits>
+
 namespace quadwar_app::view {
-  using std::min, std::max;
+  using std::min, std::max, std::numeric_limits;
 
   const real camera::default_grid_scale = 50.f;
   const real camera::default_scale      = 1.f;
@@ -70,4 +72,19 @@ namespace quadwar_app::view {
 
     return { f - p * s, { s, s } };
   }
+
+  auto camera::get_visible_bounds() const noexcept
+      -> camera::bounds {
+    const auto s = get_scale();
+
+    if (s <= numeric_limits<real>::epsilon()) {
+      const auto inf = numeric_limits<real>::max();
+      return { { -inf, -inf }, { inf, inf } };
+    }
+
+    const auto f = get_frame() / (2.f * s);
+    const auto p = get_position();
+
+    return { p - f, p + f };
+  }
 }
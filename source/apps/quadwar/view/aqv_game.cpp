@@ -97,12 +97,18 @@ namespace quadwar_app::view {
     m_selection.clear();
   }
 
+  void game::publish(world w) {
+    m_snapshot.publish(w);
+  }
+
   void game::render(engine::access::world w) {
+    m_snapshot.acquire();
+
     update_bounds(w);
     update_highlight();
 
     m_landscape.render(m_camera, w);
-    m_units.render(m_camera, w, m_highlight, m_selection);
+    m_units.render(m_camera, m_snapshot, m_highlight, m_selection);
   }
 
   auto game::get_scale() const -> real {
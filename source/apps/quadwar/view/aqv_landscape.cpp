@@ -16,97 +16,226 @@
 #include "../object/landscape.h"
 #include "../object/pathmap.h"
 #include "../object/root.h"
+#include <algorithm>
 
 namespace quadwar_app::view {
-  using std::span, graphics::flat::solid_shader;
+  using std::min, std::equal, std::swap, std::make_unique,
+      graphics::flat::solid_buffer;
 
-  const real landscape::tile_border = .2f;
+  const real      landscape::tile_border = .2f;
+  const sl::whole landscape::chunk_size  = 32;
 
   void landscape::render(const camera &cam, world w) {
-    const auto r    = w.get_entity(w.get_root());
-    const auto land = w.get_entity(object::root::get_landscape(r));
+    update(cam, w);
+
+    auto cont = render::context::get_default();
+
+    if (!cont || m_chunks.empty())
+      return;
+
+    const auto r = get_visible_chunks(cam.get_visible_bounds(),
+                                      m_tile_size, m_chunks_x,
+                                      m_chunks_y);
 
-    const auto ver = object::landscape::get_version(land);
+    const auto [p, s] = cam.get_transform();
 
-    if (m_state_version != ver) {
+    for (sl::index j = r.y0; j <= r.y1; j++) {
+      for (sl::index i = r.x0; i <= r.x1; i++) {
+        auto &c = m_chunks[j * m_chunks_x + i];
 
-      const auto width  = object::landscape::get_width(land);
-      const auto height = object::landscape::get_height(land);
-      const auto tiles  = object::landscape::get_tiles(land);
+        if (c.vertices.empty())
+          continue;
 
-      if (tiles.size() != width * height)
-        return;
+        if (!c.mesh) {
+          c.mesh = make_unique<solid_buffer>();
+        }
 
-      const auto c_tile   = vec4 { .3f, .25f, .2f, 1.f };
-      const auto c_border = vec4 { .2f, .15f, .15f, .7f };
+        if (c.is_dirty) {
+          c.mesh->upload(c.vertices);
+          c.is_dirty = false;
+        }
 
-      const auto fw = static_cast<real>(width);
-      const auto fh = static_cast<real>(height);
+        cont->render(*c.mesh, p, s);
+      }
+    }
+  }
 
-      const auto tile_size   = cam.get_grid_scale();
-      const auto border_size = tile_size * tile_border;
+  auto landscape::get_visible_chunks(const camera::bounds &visible,
+                                     real      tile_size,
+                                     sl::whole chunks_x,
+                                     sl::whole chunks_y) noexcept
+      -> chunk_range {
+    /*  Tile (i, j) starts at (i - bias, j - bias) scaled.
+     */
+    const auto bias = .5f / object::pathmap::resolution;
+    const auto size = tile_size * static_cast<real>(chunk_size);
+
+    if (size <= 0.f)
+      return {};
+
+    auto chunk_of = [&](const real x) {
+      return (x + bias * tile_size) / size;
+    };
+
+    auto first = [&](const real x, const sl::whole count) {
+      const auto n = chunk_of(x);
+
+      if (n <= 0.f)
+        return sl::index { 0 };
+      if (n >= static_cast<real>(count))
+        return count;
+      return static_cast<sl::index>(n);
+    };
+
+    auto last = [&](const real x, const sl::whole count) {
+      const auto n = chunk_of(x);
+
+      if (n < 0.f)
+        return sl::index { -1 };
+      if (n >= static_cast<real>(count - 1))
+        return count - 1;
+      return static_cast<sl::index>(n);
+    };
+
+    return { .x0 = first(visible.min.x(), chunks_x),
+             .y0 = first(visible.min.y(), chunks_y),
+             .x1 = last(visible.max.x(), chunks_x),
+             .y1 = last(visible.max.y(), chunks_y) };
+  }
 
-      const auto bias = .5f / object::pathmap::resolution;
+  void landscape::update(const camera &cam, world w) {
+    const auto r    = w.get_entity(w.get_root());
+    const auto land = w.get_entity(object::root::get_landscape(r));
 
-      m_vertices.reserve(12 * width * height);
-      m_vertices.clear();
+    const auto ver       = object::landscape::get_version(land);
+    const auto tile_size = cam.get_grid_scale();
 
-      for (sl::index j = 0; j < height; j++) {
-        for (sl::index i = 0; i < width; i++) {
+    if (m_state_version == ver && m_tile_size == tile_size)
+      return;
 
-          if (tiles[j * width + i] != object::landscape::tile_walkable) {
+    const auto width  = object::landscape::get_width(land);
+    const auto height = object::landscape::get_height(land);
 
-            const auto x0 = (static_cast<real>(i) - bias) * tile_size;
-            const auto y0 = (static_cast<real>(j) - bias) * tile_size;
+    if (width < 0 || height < 0 ||
+        land.bytes_get_size() != width * height)
+      return;
 
-            const auto x1 = x0 + tile_size;
-            const auto y1 = y0 + tile_size;
+    m_next.resize(width * height);
+    land.bytes_read(0, m_next);
 
-            const auto x2 = x0 + border_size;
-            const auto y2 = y0 + border_size;
+    const auto is_reset = m_width != width || m_height != height ||
+                          m_tile_size != tile_size;
 
-            const auto x3 = x1 - border_size;
-            const auto y3 = y1 - border_size;
+    if (is_reset) {
+      m_width     = width;
+      m_height    = height;
+      m_tile_size = tile_size;
+      m_chunks_x  = (width + chunk_size - 1) / chunk_size;
+      m_chunks_y  = (height + chunk_size - 1) / chunk_size;
 
-            m_vertices.emplace_back(
-                vertex { .position = { x0, y0 }, .color = c_border });
-            m_vertices.emplace_back(
-                vertex { .position = { x1, y0 }, .color = c_border });
-            m_vertices.emplace_back(
-                vertex { .position = { x0, y1 }, .color = c_border });
-            m_vertices.emplace_back(
-                vertex { .position = { x0, y1 }, .color = c_border });
-            m_vertices.emplace_back(
-                vertex { .position = { x1, y0 }, .color = c_border });
-            m_vertices.emplace_back(
-                vertex { .position = { x1, y1 }, .color = c_border });
+      m_chunks.clear();
+      m_chunks.resize(m_chunks_x * m_chunks_y);
+    }
 
-            m_vertices.emplace_back(
-                vertex { .position = { x2, y2 }, .color = c_tile });
-            m_vertices.emplace_back(
-                vertex { .position = { x3, y2 }, .color = c_tile });
-            m_vertices.emplace_back(
-                vertex { .position = { x2, y3 }, .color = c_tile });
-            m_vertices.emplace_back(
-                vertex { .position = { x2, y3 }, .color = c_tile });
-            m_vertices.emplace_back(
-                vertex { .position = { x3, y2 }, .color = c_tile });
-            m_vertices.emplace_back(
-                vertex { .position = { x3, y3 }, .color = c_tile });
-          }
+    for (sl::index j = 0; j < m_chunks_y; j++) {
+      for (sl::index i = 0; i < m_chunks_x; i++) {
+        if (is_reset || is_chunk_changed(i, j)) {
+          update_chunk(i, j);
         }
       }
+    }
+
+    swap(m_tiles, m_next);
+    m_state_version = ver;
+  }
 
-      m_state_version = ver;
-      m_width         = width;
-      m_height        = height;
+  void landscape::update_chunk(sl::index x, sl::index y) {
+    const auto c_tile   = vec4 { .3f, .25f, .2f, 1.f };
+    const auto c_border = vec4 { .2f, .15f, .15f, .7f };
+
+    const auto tile_size   = m_tile_size;
+    const auto border_size = tile_size * tile_border;
+
+    const auto bias = .5f / object::pathmap::resolution;
+
+    const auto i0 = x * chunk_size;
+    const auto j0 = y * chunk_size;
+    const auto i1 = min(i0 + chunk_size, m_width);
+    const auto j1 = min(j0 + chunk_size, m_height);
+
+    auto &c = m_chunks[y * m_chunks_x + x];
+    auto &v = c.vertices;
+
+    c.is_dirty = true;
+    v.clear();
+
+    for (sl::index j = j0; j < j1; j++) {
+      for (sl::index i = i0; i < i1; i++) {
+
+        const auto tile = m_next[j * m_width + i];
+
+        if (tile == object::landscape::tile_walkable)
+          continue;
+
+        const auto x0 = (static_cast<real>(i) - bias) * tile_size;
+        const auto y0 = (static_cast<real>(j) - bias) * tile_size;
+
+        const auto x1 = x0 + tile_size;
+        const auto y1 = y0 + tile_size;
+
+        const auto x2 = x0 + border_size;
+        const auto y2 = y0 + border_size;
+
+        const auto x3 = x1 - border_size;
+        const auto y3 = y1 - border_size;
+
+        v.emplace_back(
+            vertex { .position = { x0, y0 }, .color = c_border });
+        v.emplace_back(
+            vertex { .position = { x1, y0 }, .color = c_border });
+        v.emplace_back(
+            vertex { .position = { x0, y1 }, .color = c_border });
+        v.emplace_back(
+            vertex { .position = { x0, y1 }, .color = c_border });
+        v.emplace_back(
+            vertex { .position = { x1, y0 }, .color = c_border });
+        v.emplace_back(
+            vertex { .position = { x1, y1 }, .color = c_border });
+
+        v.emplace_back(
+            vertex { .position = { x2, y2 }, .color = c_tile });
+        v.emplace_back(
+            vertex { .position = { x3, y2 }, .color = c_tile });
+        v.emplace_back(
+            vertex { .position = { x2, y3 }, .color = c_tile });
+        v.emplace_back(
+            vertex { .position = { x2, y3 }, .color = c_tile });
+        v.emplace_back(
+            vertex { .position = { x3, y2 }, .color = c_tile });
+        v.emplace_back(
+            vertex { .position = { x3, y3 }, .color = c_tile });
+      }
     }
+  }
 
-    auto cont = render::context::get_default();
+  auto landscape::is_chunk_changed(sl::index x, sl::index y) const
+      -> bool {
+    if (m_tiles.size() != m_next.size())
+      return true;
 
-    if (cont) {
-      const auto [p, s] = cam.get_transform();
-      cont->render(m_vertices, p, s);
+    const auto i0 = x * chunk_size;
+    const auto i1 = min(i0 + chunk_size, m_width);
+    const auto j0 = y * chunk_size;
+    const auto j1 = min(j0 + chunk_size, m_height);
+
+    for (sl::index j = j0; j < j1; j++) {
+      const auto a = m_tiles.begin() + j * m_width;
+      const auto b = m_next.begin() + j * m_width;
+
+      if (!equal(a + i0, a + i1, b + i0))
+        return true;
     }
+
+    return false;
   }
 }
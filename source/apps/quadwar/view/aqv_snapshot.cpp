@@ -0,0 +1,106 @@
+/*  apps/quadwar/view/aqv_snapshot.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "snapshot.h"
+
+#include "../../../laplace/core/utils.h"
+#include "../../../laplace/engine/access/world.h"
+#include "../object/root.h"
+#include "../object/unit.h"
+#include <algorithm>
+
+namespace quadwar_app::view {
+  using object::root, object::unit, std::sort, std::span,
+      std::chrono::duration;
+
+  void snapshot::publish(world w) {
+    auto &s = m_buffers[m_back];
+
+    const auto r     = w.get_entity(w.get_root());
+    const auto units = w.get_entity(root::get_units(r));
+
+    s.time = clock::now();
+    s.units.resize(units.vec_get_size());
+
+    for (sl::index i = 0; i < s.units.size(); i++) {
+      const auto id = as_index(units.vec_get(i, -1));
+      const auto u  = w.get_entity(id);
+      const auto p  = unit::get_position_scaled(u);
+
+      s.units[i] = { .id     = id,
+                     .x      = p.x(),
+                     .y      = p.y(),
+                     .radius = unit::get_radius_scaled(u),
+                     .color  = unit::get_color(u),
+                     .health = unit::get_health(u) };
+    }
+
+    sort(s.units.begin(), s.units.end(),
+         [](const unit_state &a, const unit_state &b) {
+           return a.id < b.id;
+         });
+
+    swap_back();
+  }
+
+  void snapshot::publish(span<const unit_state> units) {
+    auto &s = m_buffers[m_back];
+
+    s.time = clock::now();
+    s.units.assign(units.begin(), units.end());
+
+    swap_back();
+  }
+
+  auto snapshot::acquire() -> bool {
+    if ((m_middle.load(std::memory_order_relaxed) & fresh_flag) ==
+        0) {
+      return false;
+    }
+
+    const auto n = m_middle.exchange(m_previous,
+                                     std::memory_order_acq_rel);
+
+    m_previous = m_current;
+    m_current  = n & index_mask;
+    return true;
+  }
+
+  auto snapshot::get_current() const noexcept -> const state & {
+    return m_buffers[m_current];
+  }
+
+  auto snapshot::get_previous() const noexcept -> const state & {
+    return m_buffers[m_previous];
+  }
+
+  void snapshot::swap_back() noexcept {
+    m_back = m_middle.exchange(m_back | fresh_flag,
+                               std::memory_order_acq_rel) &
+             index_mask;
+  }
+
+  auto snapshot::get_factor(time_point t) const noexcept -> real {
+    const auto &a = get_previous();
+    const auto &b = get_current();
+
+    if (b.time <= a.time)
+      return 1.f;
+    if (t <= b.time)
+      return 0.f;
+
+    const auto period = duration<real>(b.time - a.time).count();
+    const auto passed = duration<real>(t - b.time).count();
+
+    return std::min(passed / period, 1.f);
+  }
+}
@@ -13,122 +13,133 @@
 #include "units.h"
 
 #include "../../../laplace/core/utils.h"
+#include "../../../laplace/graphics/flat/instance_buffer.h"
 #include "../../../laplace/render/context.h"
-#include "../object/root.h"
-#include "../object/unit.h"
 
 namespace quadwar_app::view {
-  using object::root, object::unit, std::find, std::span;
-
-  const vec4 units::colors[] = { vec4 { .1f, .6f, .1f, 1.f },
-                                 vec4 { .6f, .1f, .1f, 1.f },
-                                 vec4 { .1f, .1f, .6f, 1.f },
-                                 vec4 { .5f, .5f, .0f, 1.f } };
-
-  const vec4 units::highlight_color = vec4 { .9f, .9f, .9f, .8f };
-  const vec4 units::selection_color = vec4 { .7f, .7f, .7f, .8f };
-  const real units::unit_scaling    = .7f;
-  const real units::selection_delta = 8.f;
-
-  void units::render(const camera &cam, world w,
+  using std::span, graphics::flat::instance_buffer;
+
+  const vec4 units::palette[] = { vec4 { .1f, .6f, .1f, 1.f },
+                                  vec4 { .6f, .1f, .1f, 1.f },
+                                  vec4 { .1f, .1f, .6f, 1.f },
+                                  vec4 { .5f, .5f, .0f, 1.f },
+                                  vec4 { .9f, .9f, .9f, .8f },
+                                  vec4 { .7f, .7f, .7f, .8f } };
+
+  const sl::whole units::color_count     = 4;
+  const uint32_t  units::highlight_index = 4;
+  const uint32_t  units::selection_index = 5;
+  const real      units::unit_scaling    = .7f;
+  const real      units::selection_delta = 8.f;
+
+  void units::render(const camera &cam, const snapshot &s,
                      span<const sl::index> highlight,
                      span<const sl::index> selection) {
 
-    update_units(cam, w);
-    update_buffer(highlight, selection);
+    update(cam, s, highlight, selection);
 
     auto cont = render::context::get_default();
 
     if (cont) {
       const auto [p, s] = cam.get_transform();
-      cont->render(m_marks, p, s);
-      cont->render(m_units, p, s);
+      cont->render(m_marks, p, s, palette);
+      cont->render(m_units, p, s, palette);
     }
   }
 
+  void units::update(const camera &cam, const snapshot &s,
+                     span<const sl::index> highlight,
+                     span<const sl::index> selection) {
+
+    update_units(cam, s);
+    update_buffer(highlight, selection);
+  }
+
   auto units::get_units() const -> span<const unit_info> {
     return m_info;
   }
 
-  void units::update_units(const camera &cam, world w) {
-    const auto r     = w.get_entity(w.get_root());
-    const auto units = w.get_entity(root::get_units(r));
+  void units::update_units(const camera &cam, const snapshot &s) {
+    const auto &prev = s.get_previous().units;
+    const auto &cur  = s.get_current().units;
+
+    const auto t = s.get_factor(snapshot::clock::now());
 
-    m_info.resize(units.vec_get_size());
+    m_info.resize(cur.size());
+
+    sl::index j = 0;
 
     for (sl::index i = 0; i < m_info.size(); i++) {
-      const auto id = as_index(units.vec_get(i, -1));
-      const auto u  = w.get_entity(id);
+      auto x = cur[i].x;
+      auto y = cur[i].y;
+
+      while (j < prev.size() && prev[j].id < cur[i].id) { j++; }
 
-      const auto p = unit::get_position_scaled(u) *
-                     cam.get_grid_scale();
+      if (j < prev.size() && prev[j].id == cur[i].id) {
+        x = prev[j].x + (x - prev[j].x) * t;
+        y = prev[j].y + (y - prev[j].y) * t;
+      }
 
-      const auto s = unit::get_radius_scaled(u) *
-                     cam.get_grid_scale() * unit_scaling;
+      const auto p = vec2 { x, y } * cam.get_grid_scale();
 
-      m_info[i].id          = id;
-      m_info[i].color_index = unit::get_color(u);
-      m_info[i].rect[0]     = p - vec2 { s, s };
-      m_info[i].rect[1]     = p + vec2 { s, s };
+      const auto r = cur[i].radius * cam.get_grid_scale() *
+                     unit_scaling;
+
+      m_info[i].id          = cur[i].id;
+      m_info[i].color_index = cur[i].color;
+      m_info[i].rect[0]     = p - vec2 { r, r };
+      m_info[i].rect[1]     = p + vec2 { r, r };
     }
   }
 
   void units::update_buffer(span<const sl::index> highlight,
                             span<const sl::index> selection) {
-    static_assert(sizeof colors > 0);
-
-    auto add_rect = [](sl::vector<vertex> &v, sl::index n,
-                       const vec2 min, const vec2 max,
-                       const float delta, const vec4 color) {
-      if (n >= v.size()) {
-        v.resize(n + 6);
-      }
-
-      const auto x0 = min.x() - delta;
-      const auto y0 = min.y() - delta;
-      const auto x1 = max.x() + delta;
-      const auto y1 = max.y() + delta;
+    const auto delta = vec2 { selection_delta, selection_delta };
 
-      v[n].position     = vec2 { x0, y0 };
-      v[n + 1].position = vec2 { x1, y0 };
-      v[n + 2].position = vec2 { x0, y1 };
-      v[n + 3].position = vec2 { x1, y0 };
-      v[n + 4].position = vec2 { x1, y1 };
-      v[n + 5].position = vec2 { x0, y1 };
-
-      v[n].color     = color;
-      v[n + 1].color = color;
-      v[n + 2].color = color;
-      v[n + 3].color = color;
-      v[n + 4].color = color;
-      v[n + 5].color = color;
-    };
-
-    m_units.resize(m_info.size() * 6, vertex {});
+    m_units.resize(m_info.size());
 
     m_marks.clear();
 
+    set_marks(selection, mark_selection);
+    set_marks(highlight, mark_highlight);
+
     for (sl::index i = 0; i < m_info.size(); i++) {
 
+      const auto id  = m_info[i].id;
       const auto min = m_info[i].rect[0];
       const auto max = m_info[i].rect[1];
 
-      if (find(highlight.begin(), highlight.end(), m_info[i].id) !=
-          highlight.end()) {
-        add_rect(m_marks, m_marks.size(), min, max, selection_delta,
-                 highlight_color);
+      const auto mark = id >= 0 && id < m_mark_of.size()
+                            ? m_mark_of[id]
+                            : mark_none;
 
-      } else if (find(selection.begin(), selection.end(),
-                      m_info[i].id) != selection.end()) {
-        add_rect(m_marks, m_marks.size(), min, max, selection_delta,
-                 selection_color);
+      if (mark == mark_highlight) {
+        m_marks.emplace_back(instance_buffer::pack(
+            min - delta, max + delta, highlight_index));
+
+      } else if (mark == mark_selection) {
+        m_marks.emplace_back(instance_buffer::pack(
+            min - delta, max + delta, selection_index));
       }
 
-      const auto color_index = m_info[i].color_index %
-                               (sizeof colors / sizeof *colors);
-      const auto color = colors[color_index];
+      const auto color = static_cast<uint32_t>(
+          static_cast<uint32_t>(m_info[i].color_index) % color_count);
+
+      m_units[i] = instance_buffer::pack(min, max, color);
+    }
+
+    set_marks(selection, mark_none);
+    set_marks(highlight, mark_none);
+  }
+
+  void units::set_marks(span<const sl::index> ids, mark value) {
+    for (const auto id : ids) {
+      if (id < 0)
+        continue;
+      if (id >= m_mark_of.size())
+        m_mark_of.resize(id + 1, mark_none);
 
-      add_rect(m_units, i * 6, min, max, 0.f, color);
+      m_mark_of[id] = value;
     }
   }
 }
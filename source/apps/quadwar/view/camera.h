@@ -39,6 +39,15 @@ namespace quadwar_app::view {
 
     [[nodiscard]] auto get_transform() const noexcept -> transform;
 
+    struct bounds {
+      vec2 min;
+      vec2 max;
+    };
+
+    /*  Get the visible area in grid scaled coordinates.
+     */
+    [[nodiscard]] auto get_visible_bounds() const noexcept -> bounds;
+
   private:
     void adjust_position(const vec2 v) noexcept;
 
@@ -32,6 +32,14 @@ namespace quadwar_app::view {
     void scale(const real delta);
     void click();
 
+    /*  Publish the unit render state. Called from the World
+     *  tick callback, possibly from a scheduler thread.
+     */
+    void publish(world w);
+
+    /*  Units are rendered from the published states, so the
+     *  World is only read for the landscape.
+     */
     void render(engine::access::world w);
 
   private:
@@ -44,6 +52,7 @@ namespace quadwar_app::view {
     camera    m_camera;
     landscape m_landscape;
     units     m_units;
+    snapshot  m_snapshot;
     vec2      m_cursor;
 
     sl::vector<sl::index> m_highlight;
@@ -13,25 +13,69 @@
 #ifndef quadwar_view_landscape_h
 #define quadwar_view_landscape_h
 
-#include "../../../laplace/graphics/flat/solid_shader.h"
+#include "../../../laplace/graphics/flat/solid_buffer.h"
 #include "camera.h"
 #include "defs.h"
+#include <memory>
 
 namespace quadwar_app::view {
+  /*  The tiles are split into square chunks. A chunk mesh is
+   *  rebuilt only if a tile inside it was changed, and only the
+   *  visible chunks are rendered. A chunk is uploaded when it
+   *  is visible for the first time after the rebuild.
+   */
   class landscape : engine::helper {
   public:
-    static const real tile_border;
+    static const real      tile_border;
+    static const sl::whole chunk_size;
+
+    /*  Chunks [x0, x1] by [y0, y1]. Empty if x1 < x0 or
+     *  y1 < y0.
+     */
+    struct chunk_range {
+      sl::index x0 = 0;
+      sl::index y0 = 0;
+      sl::index x1 = -1;
+      sl::index y1 = -1;
+    };
 
     void render(const camera &cam, world w);
 
+    /*  Get the chunks that overlap the visible area.
+     */
+    [[nodiscard]] static auto get_visible_chunks(
+        const camera::bounds &visible, real tile_size,
+        sl::whole chunks_x, sl::whole chunks_y) noexcept
+        -> chunk_range;
+
   private:
-    using vertex = graphics::flat::solid_shader::vertex;
+    using vertex = graphics::flat::solid_buffer::vertex;
+
+    struct chunk {
+      sl::vector<vertex>                            vertices;
+      std::unique_ptr<graphics::flat::solid_buffer> mesh;
+      bool                                          is_dirty = true;
+    };
+
+    void update(const camera &cam, world w);
+    void update_chunk(sl::index x, sl::index y);
+
+    [[nodiscard]] auto is_chunk_changed(sl::index x,
+                                        sl::index y) const -> bool;
 
     sl::index m_state_version = 0;
     sl::whole m_width         = 0;
     sl::whole m_height        = 0;
+    sl::whole m_chunks_x      = 0;
+    sl::whole m_chunks_y      = 0;
+    real      m_tile_size     = 0.f;
+
+    /*  The tiles the meshes were built for, and the new ones.
+     */
+    sl::vector<int8_t> m_tiles;
+    sl::vector<int8_t> m_next;
 
-    std::vector<vertex> m_vertices;
+    sl::vector<chunk> m_chunks;
   };
 }
 
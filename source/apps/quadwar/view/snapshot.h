@@ -0,0 +1,101 @@
+/*  apps/quadwar/view/snapshot.h
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#ifndef quadwar_view_snapshot_h
+#define quadwar_view_snapshot_h
+
+#include "defs.h"
+#include <atomic>
+#include <chrono>
+
+namespace quadwar_app::view {
+  /*  Render state of the units. The World publishes it once per
+   *  tick, and the view reads the last two states without
+   *  locking.
+   *
+   *  One thread may publish and one thread may read at a time.
+   */
+  class snapshot : engine::helper {
+  public:
+    using clock      = std::chrono::steady_clock;
+    using time_point = clock::time_point;
+
+    struct unit_state {
+      sl::index      id     = {};
+      real           x      = {};
+      real           y      = {};
+      real           radius = {};
+      sl::index      color  = {};
+      engine::intval health = {};
+    };
+
+    /*  Units are sorted by id.
+     */
+    struct state {
+      time_point             time;
+      sl::vector<unit_state> units;
+    };
+
+    snapshot()  = default;
+    ~snapshot() = default;
+
+    snapshot(const snapshot &) = delete;
+    auto operator=(const snapshot &) -> snapshot & = delete;
+
+    /*  Publish the current World state. The buffers are reused,
+     *  so it does not allocate once the unit count is stable.
+     */
+    void publish(world w);
+
+    /*  Publish the units. They shall be sorted by id.
+     */
+    void publish(std::span<const unit_state> units);
+
+    /*  Take the last published state, if there is a new one.
+     *  The previous current state becomes the previous one.
+     *
+     *  Returns true if the states were changed.
+     */
+    auto acquire() -> bool;
+
+    [[nodiscard]] auto get_current() const noexcept
+        -> const state &;
+    [[nodiscard]] auto get_previous() const noexcept
+        -> const state &;
+
+    /*  Get the interpolation factor from the previous state to
+     *  the current one, in [0, 1]. The view is one tick behind
+     *  the simulation.
+     */
+    [[nodiscard]] auto get_factor(time_point t) const noexcept
+        -> real;
+
+  private:
+    static constexpr uint8_t index_mask = 3;
+    static constexpr uint8_t fresh_flag = 4;
+
+    /*  Make the back buffer the middle one.
+     */
+    void swap_back() noexcept;
+
+    /*  The middle buffer is exchanged between the publisher
+     *  and the reader.
+     */
+    state                m_buffers[4];
+    std::atomic<uint8_t> m_middle   = 1;
+    uint8_t              m_back     = 0;
+    uint8_t              m_current  = 2;
+    uint8_t              m_previous = 3;
+  };
+}
+
+#endif
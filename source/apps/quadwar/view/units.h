@@ -13,20 +13,31 @@
 #ifndef quadwar_view_units_h
 #define quadwar_view_units_h
 
-#include "../../../laplace/graphics/flat/solid_shader.h"
+#include "../../../laplace/graphics/flat/instance_shader.h"
 #include "camera.h"
 #include "defs.h"
+#include "snapshot.h"
 
 namespace quadwar_app::view {
   class units : engine::helper {
   public:
-    static const vec4 colors[];
-    static const vec4 highlight_color;
-    static const vec4 selection_color;
-    static const real unit_scaling;
-    static const real selection_delta;
+    /*  Player colors, then the highlight and the selection
+     *  colors.
+     */
+    static const vec4      palette[];
+    static const sl::whole color_count;
+    static const uint32_t  highlight_index;
+    static const uint32_t  selection_index;
+    static const real      unit_scaling;
+    static const real      selection_delta;
 
-    void render(const camera &cam, world w,
+    void render(const camera &cam, const snapshot &s,
+                std::span<const sl::index> highlight,
+                std::span<const sl::index> selection);
+
+    /*  Update the instances without rendering.
+     */
+    void update(const camera &cam, const snapshot &s,
                 std::span<const sl::index> highlight,
                 std::span<const sl::index> selection);
 
@@ -39,16 +50,27 @@ namespace quadwar_app::view {
     [[nodiscard]] auto get_units() const -> std::span<const unit_info>;
 
   private:
-    void update_units(const camera &cam, world w);
+    enum mark : uint8_t { mark_none, mark_highlight, mark_selection };
+
+    /*  Interpolate the units between the last two states.
+     */
+    void update_units(const camera &cam, const snapshot &s);
 
     void update_buffer(std::span<const sl::index> highlight,
                        std::span<const sl::index> selection);
 
-    using vertex = graphics::flat::solid_shader::vertex;
+    void set_marks(std::span<const sl::index> ids, mark value);
+
+    using instance = graphics::flat::instance_shader::instance;
 
-    sl::vector<vertex>    m_marks;
-    sl::vector<vertex>    m_units;
+    sl::vector<instance>  m_marks;
+    sl::vector<instance>  m_units;
     sl::vector<unit_info> m_info;
+
+    /*  Highlight and selection flags indexed by unit id. All
+     *  are reset after each update.
+     */
+    sl::vector<mark> m_mark_of;
   };
 }
 
@@ -16,12 +16,42 @@
 
 #include "utils.h"
 #include <algorithm>
+#include <bit>
+#include <limits>
 
 namespace laplace::core {
-  using std::min, std::move, std::lower_bound, std::string_view,
-      std::wstring_view, std::u8string_view, std::u16string_view,
-      std::u32string_view, std::numeric_limits, std::pair,
-      std::vector, std::monostate, std::u8string;
+  using std::min, std::move, std::lower_bound, std::sort,
+      std::is_sorted, std::string_view, std::wstring_view,
+      std::u8string_view, std::u16string_view, std::u32string_view,
+      std::numeric_limits, std::pair, std::vector, std::monostate,
+      std::u8string, std::make_unique, std::hash, std::bit_ceil,
+      std::bit_cast, std::max;
+
+  const sl::whole family::index_threshold = 16;
+
+  family::indexed_composite::indexed_composite(
+      const indexed_composite &value) noexcept :
+      fields(value.fields) {
+    if (value.index) {
+      index = make_unique<key_index>(*value.index);
+    }
+  }
+
+  auto family::indexed_composite::operator=(
+      const indexed_composite &value) noexcept
+      -> indexed_composite & {
+    if (this != &value) {
+      fields = value.fields;
+
+      if (value.index) {
+        index = make_unique<key_index>(*value.index);
+      } else {
+        index.reset();
+      }
+    }
+
+    return *this;
+  }
 
   family::family(cref_vfamily value) noexcept {
     assign(value);
@@ -31,6 +61,14 @@ namespace laplace::core {
     assign(value);
   }
 
+  family::family(vfamily &&value) noexcept {
+    assign(move(value));
+  }
+
+  family::family(composite &&value) noexcept {
+    assign(move(value));
+  }
+
   family::family(bool value) noexcept {
     assign(value);
   }
@@ -139,6 +177,16 @@ namespace laplace::core {
     return *this;
   }
 
+  auto family::operator=(vfamily &&value) noexcept -> ref_family {
+    assign(move(value));
+    return *this;
+  }
+
+  auto family::operator=(composite &&value) noexcept -> ref_family {
+    assign(move(value));
+    return *this;
+  }
+
   auto family::operator=(bool value) noexcept -> ref_family {
     assign(value);
     return *this;
@@ -415,7 +463,7 @@ namespace laplace::core {
     }
 
     if (m_data.index() == n_composite) {
-      return get<n_composite>(m_data).size();
+      return get<n_composite>(m_data).fields.size();
     }
 
     if (m_data.index() == n_string) {
@@ -430,16 +478,20 @@ namespace laplace::core {
       return false;
     }
 
+    if (is_indexed()) {
+      return find_index(key, hash_of(key)) >= 0;
+    }
+
     bool result = true;
 
     auto i = lower_bound(
-        get<n_composite>(m_data).begin(),
-        get<n_composite>(m_data).end(), key,
+        get<n_composite>(m_data).fields.begin(),
+        get<n_composite>(m_data).fields.end(), key,
         [](const pair<family, family> &x, const family &k) {
           return x.first.compare(k) < 0;
         });
 
-    if (i == get<n_composite>(m_data).end()) {
+    if (i == get<n_composite>(m_data).fields.end()) {
       result = false;
     } else if (i->first != key) {
       result = false;
@@ -451,41 +503,51 @@ namespace laplace::core {
   void family::set_key(signed long long n, cref_family k) noexcept {
     if (m_data.index() != n_composite)
       return;
-    if (get<n_composite>(m_data).size() <= n)
+
+    auto &fields = get<n_composite>(m_data).fields;
+
+    if (fields.size() <= n)
       return;
 
-    get<n_composite>(m_data).erase(get<n_composite>(m_data).begin() + n);
+    fields.erase(fields.begin() + n);
 
     auto i = lower_bound(
-        get<n_composite>(m_data).begin(),
-        get<n_composite>(m_data).end(), k,
+        fields.begin(), fields.end(), k,
         [](const pair<family, family> &x, const family &k) {
           return x.first.compare(k) < 0;
         });
 
-    if (i == get<n_composite>(m_data).end()) {
-      get<n_composite>(m_data).emplace_back(pair { k, family() });
+    if (i == fields.end()) {
+      fields.emplace_back(pair { k, family() });
     } else if (i->first != k) {
-      get<n_composite>(m_data).emplace(i, pair { k, family() });
+      fields.emplace(i, pair { k, family() });
     }
+
+    update_index();
   }
 
   void family::key(cref_family k) noexcept {
     if (m_data.index() != n_composite) {
-      m_data = vector<pair<family, family>>();
+      m_data = indexed_composite {};
+    }
+
+    if (is_indexed() && find_index(k, hash_of(k)) >= 0) {
+      return;
     }
 
+    auto &fields = get<n_composite>(m_data).fields;
+
     auto i = lower_bound(
-        get<n_composite>(m_data).begin(),
-        get<n_composite>(m_data).end(), k,
+        fields.begin(), fields.end(), k,
         [](const pair<family, family> &x, const family &k) {
           return x.first.compare(k) < 0;
         });
 
-    if (i == get<n_composite>(m_data).end()) {
-      get<n_composite>(m_data).emplace_back(pair { k, family() });
-    } else if (i->first != k) {
-      get<n_composite>(m_data).emplace(i, pair { k, family() });
+    const auto n = i - fields.begin();
+
+    if (i == fields.end() || i->first != k) {
+      fields.emplace(i, pair { k, family() });
+      insert_index(n);
     }
   }
 
@@ -503,20 +565,30 @@ namespace laplace::core {
 
   auto family::value(cref_family key) noexcept -> ref_family {
     if (m_data.index() != n_composite) {
-      m_data = vector<pair<family, family>>();
+      m_data = indexed_composite {};
+    }
+
+    auto &data = get<n_composite>(m_data).fields;
+
+    if (is_indexed()) {
+      const auto n = find_index(key, hash_of(key));
+
+      if (n >= 0) {
+        return data[n].second;
+      }
     }
 
     auto i = lower_bound(
-        get<n_composite>(m_data).begin(),
-        get<n_composite>(m_data).end(), key,
+        data.begin(), data.end(), key,
         [](const pair<family, family> &x, const family &k) {
           return x.first.compare(k) < 0;
         });
 
-    if (i == get<n_composite>(m_data).end() || i->first != key) {
-      return get<n_composite>(m_data)
-          .emplace(i, pair { key, family() })
-          ->second;
+    if (i == data.end() || i->first != key) {
+      const auto n = i - data.begin();
+      data.emplace(i, pair { key, family() });
+      insert_index(n);
+      return data[n].second;
     }
 
     return i->second;
@@ -528,11 +600,11 @@ namespace laplace::core {
       return logic_error();
     }
 
-    if (get<n_composite>(m_data).size() <= n) {
+    if (get<n_composite>(m_data).fields.size() <= n) {
       return out_of_range();
     }
 
-    return get<n_composite>(m_data)[n].first;
+    return get<n_composite>(m_data).fields[n].first;
   }
 
   auto family::get_value(signed long long n) const noexcept
@@ -554,14 +626,24 @@ namespace laplace::core {
       return logic_error();
     }
 
+    if (is_indexed()) {
+      const auto n = find_index(key, hash_of(key));
+
+      if (n < 0) {
+        return out_of_range();
+      }
+
+      return get<n_composite>(m_data).fields[n].second;
+    }
+
     auto i = lower_bound(
-        get<n_composite>(m_data).begin(),
-        get<n_composite>(m_data).end(), key,
+        get<n_composite>(m_data).fields.begin(),
+        get<n_composite>(m_data).fields.end(), key,
         [](const pair<family, family> &x, const family &k) {
           return x.first.compare(k) < 0;
         });
 
-    if (i == get<n_composite>(m_data).end()) {
+    if (i == get<n_composite>(m_data).fields.end()) {
       return out_of_range();
     } else if (i->first != key) {
       return out_of_range();
@@ -572,12 +654,21 @@ namespace laplace::core {
 
   auto family::by_key(signed long long key) noexcept -> ref_family {
     if (m_data.index() != n_composite) {
-      m_data = composite {};
+      m_data = indexed_composite {};
+    }
+
+    auto &data = get<n_composite>(m_data).fields;
+
+    if (is_indexed()) {
+      const auto n = find_index(key);
+
+      if (n >= 0) {
+        return data[n].second;
+      }
     }
 
     auto i = lower_bound(
-        get<n_composite>(m_data).begin(),
-        get<n_composite>(m_data).end(), key,
+        data.begin(), data.end(), key,
         [](const pair<family, family> &x, signed long long k) {
           if (x.first.m_data.index() != n_int) {
             return x.first.m_data.index() < n_int;
@@ -586,17 +677,15 @@ namespace laplace::core {
           return get<n_int>(x.first.m_data) < k;
         });
 
-    if (i == get<n_composite>(m_data).end()) {
-      return get<n_composite>(m_data)
-          .emplace_back(pair { key, family() })
-          .second;
-    } else if (!i->first.is_uint() || i->first.get_uint() != key) {
-      return get<n_composite>(m_data)
-          .emplace(i, pair { key, family() })
-          ->second;
-    } else {
-      return i->second;
+    if (i == data.end() || i->first.m_data.index() != n_int ||
+        get<n_int>(i->first.m_data) != key) {
+      const auto n = i - data.begin();
+      data.emplace(i, pair { key, family() });
+      insert_index(n);
+      return data[n].second;
     }
+
+    return i->second;
   }
 
   auto family::by_key(signed long long key) const noexcept
@@ -605,9 +694,19 @@ namespace laplace::core {
       return logic_error();
     }
 
+    if (is_indexed()) {
+      const auto n = find_index(key);
+
+      if (n < 0) {
+        return out_of_range();
+      }
+
+      return get<n_composite>(m_data).fields[n].second;
+    }
+
     auto i = lower_bound(
-        get<n_composite>(m_data).begin(),
-        get<n_composite>(m_data).end(), key,
+        get<n_composite>(m_data).fields.begin(),
+        get<n_composite>(m_data).fields.end(), key,
         [](const pair<family, family> &x, signed long long k) {
           if (x.first.m_data.index() != n_int) {
             return x.first.m_data.index() < n_int;
@@ -616,9 +715,10 @@ namespace laplace::core {
           return get<n_int>(x.first.m_data) < k;
         });
 
-    if (i == get<n_composite>(m_data).end()) {
+    if (i == get<n_composite>(m_data).fields.end()) {
       return out_of_range();
-    } else if (!i->first.is_uint() || i->first.get_uint() != key) {
+    } else if (i->first.m_data.index() != n_int ||
+               get<n_int>(i->first.m_data) != key) {
       return out_of_range();
     }
 
@@ -712,22 +812,22 @@ namespace laplace::core {
     }
 
     if (m_data.index() == n_composite) {
-      auto na = get<n_composite>(m_data).size();
-      auto nb = get<n_composite>(value.m_data).size();
+      auto na = get<n_composite>(m_data).fields.size();
+      auto nb = get<n_composite>(value.m_data).fields.size();
 
       auto n = min(na, nb);
 
       for (sl::index i = 0; i < n; i++) {
-        auto x = get<n_composite>(m_data)[i].first.compare(
-            get<n_composite>(value.m_data)[i].first);
+        auto x = get<n_composite>(m_data).fields[i].first.compare(
+            get<n_composite>(value.m_data).fields[i].first);
 
         if (x < 0)
           return -1;
         if (x > 0)
           return 1;
 
-        x = get<n_composite>(m_data)[i].second.compare(
-            get<n_composite>(value.m_data)[i].second);
+        x = get<n_composite>(m_data).fields[i].second.compare(
+            get<n_composite>(value.m_data).fields[i].second);
 
         if (x < 0)
           return -1;
@@ -749,7 +849,7 @@ namespace laplace::core {
     bool result = true;
 
     if (m_data.index() != n_composite) {
-      m_data = vector<pair<family, family>>();
+      m_data = indexed_composite {};
       result = false;
     }
 
@@ -794,15 +894,47 @@ namespace laplace::core {
 
   void family::assign(family::cref_composite value) noexcept {
     if (value.size() > 0) {
-      m_data = value;
+      m_data.emplace<n_composite>().fields = value;
 
-      sort(get<n_composite>(m_data).begin(),
-           get<n_composite>(m_data).end(),
+      sort(get<n_composite>(m_data).fields.begin(),
+           get<n_composite>(m_data).fields.end(),
            [](const pair<family, family> &a,
               const pair<family, family> &b) {
              return a.first.compare(b.first) < 0;
            });
 
+      update_index();
+
+    } else {
+      m_data = monostate();
+    }
+  }
+
+  void family::assign(vfamily &&value) noexcept {
+    if (value.size() > 0) {
+      m_data = move(value);
+    } else {
+      m_data = monostate();
+    }
+  }
+
+  /*  The keys are sorted only if needed, so the composite built
+   *  in order is moved as is.
+   */
+  void family::assign(composite &&value) noexcept {
+    const auto op = [](const pair<family, family> &a,
+                       const pair<family, family> &b) {
+      return a.first.compare(b.first) < 0;
+    };
+
+    if (value.size() > 0) {
+      if (!is_sorted(value.begin(), value.end(), op)) {
+        sort(value.begin(), value.end(), op);
+      }
+
+      m_data.emplace<n_composite>().fields = move(value);
+      update_index();
+
     } else {
       m_data = monostate();
     }
@@ -847,4 +979,172 @@ namespace laplace::core {
   void family::assign(span_cbyte value) noexcept {
     m_data = move(vbyte(value.begin(), value.end()));
   }
+
+  /*  Mixes the value and the type, so equal numbers of different
+   *  types fall apart.
+   */
+  static auto mix_hash(uint64_t x, sl::index type) noexcept
+      -> uint64_t {
+    x ^= static_cast<uint64_t>(type) * 0x9e3779b97f4a7c15;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccd;
+    x ^= x >> 33;
+    return x;
+  }
+
+  auto family::hash_of(cref_family key) noexcept -> uint64_t {
+    const auto type = static_cast<sl::index>(key.m_data.index());
+
+    switch (type) {
+      case n_uint: return mix_hash(get<n_uint>(key.m_data), type);
+      case n_bool: return mix_hash(get<n_bool>(key.m_data), type);
+      case n_int: return hash_of(get<n_int>(key.m_data));
+
+      case n_real: {
+        /*  Equal reals may differ in bits only for zeros.
+         */
+        const auto x = get<n_real>(key.m_data);
+        return mix_hash(x == 0. ? 0 : bit_cast<uint64_t>(x), type);
+      }
+
+      case n_string:
+        return mix_hash(
+            hash<u8string_view> {}(get<n_string>(key.m_data)), type);
+
+      case n_bytes: {
+        const auto &v = get<n_bytes>(key.m_data);
+        const auto s  = string_view {
+          reinterpret_cast<const char *>(v.data()), v.size()
+        };
+        return mix_hash(hash<string_view> {}(s), type);
+      }
+    }
+
+    /*  Vectors and composites as keys are rare. They are told
+     *  apart by the comparison.
+     */
+    return mix_hash(0, type);
+  }
+
+  auto family::hash_of(signed long long key) noexcept -> uint64_t {
+    return mix_hash(static_cast<uint64_t>(key), n_int);
+  }
+
+  auto family::is_indexed() const noexcept -> bool {
+    return m_data.index() == n_composite &&
+           get<n_composite>(m_data).index;
+  }
+
+  auto family::find_index(cref_family key, uint64_t hash)
+      const noexcept -> sl::index {
+    const auto &index = *get<n_composite>(m_data).index;
+    const auto &data  = get<n_composite>(m_data).fields;
+    const auto  tag   = static_cast<uint32_t>(hash >> 32);
+    const auto  mask  = index.positions.size() - 1;
+
+    for (auto n = hash & mask;; n = (n + 1) & mask) {
+      const auto position = index.positions[n];
+
+      if (position < 0) {
+        return -1;
+      }
+
+      if (index.tags[n] == tag && data[position].first == key) {
+        return position;
+      }
+    }
+  }
+
+  auto family::find_index(signed long long key) const noexcept
+      -> sl::index {
+    const auto &index = *get<n_composite>(m_data).index;
+    const auto &data  = get<n_composite>(m_data).fields;
+    const auto  hash  = hash_of(key);
+    const auto  tag   = static_cast<uint32_t>(hash >> 32);
+    const auto  mask  = index.positions.size() - 1;
+
+    for (auto n = hash & mask;; n = (n + 1) & mask) {
+      const auto position = index.positions[n];
+
+      if (position < 0) {
+        return -1;
+      }
+
+      const auto &k = data[position].first.m_data;
+
+      if (index.tags[n] == tag && k.index() == n_int &&
+          get<n_int>(k) == key) {
+        return position;
+      }
+    }
+  }
+
+  void family::update_index() noexcept {
+    if (m_data.index() != n_composite) {
+      return;
+    }
+
+    auto &c = get<n_composite>(m_data);
+
+    if (c.fields.size() < index_threshold) {
+      c.index.reset();
+      return;
+    }
+
+    if (!c.index) {
+      c.index = make_unique<key_index>();
+    }
+
+    /*  Load factor is kept not above 1/2.
+     */
+    const auto size = bit_ceil(
+        static_cast<uint64_t>(c.fields.size() * 2));
+    const auto mask = size - 1;
+
+    auto &index = *c.index;
+
+    index.tags.assign(size, 0);
+    index.positions.assign(size, -1);
+
+    for (sl::index i = 0; i < c.fields.size(); i++) {
+      const auto hash = hash_of(c.fields[i].first);
+
+      auto n = hash & mask;
+      while (index.positions[n] >= 0) { n = (n + 1) & mask; }
+
+      index.tags[n]      = static_cast<uint32_t>(hash >> 32);
+      index.positions[n] = static_cast<int32_t>(i);
+    }
+  }
+
+  void family::insert_index(sl::index n) noexcept {
+    auto &c = get<n_composite>(m_data);
+
+    if (!c.index || c.fields.size() * 2 > c.index->positions.size()) {
+      update_index();
+      return;
+    }
+
+    auto &index = *c.index;
+
+    /*  Positions after the new key are shifted by one, the same
+     *  as the ordered storage.
+     */
+    if (n + 1 < c.fields.size()) {
+      const auto first = static_cast<int32_t>(n);
+
+      for (auto &position : index.positions) {
+        position += position >= first ? 1 : 0;
+      }
+    }
+
+    const auto hash = hash_of(c.fields[n].first);
+    const auto mask = index.positions.size() - 1;
+
+    auto i = hash & mask;
+    while (index.positions[i] >= 0) { i = (i + 1) & mask; }
+
+    index.tags[i]      = static_cast<uint32_t>(hash >> 32);
+    index.positions[i] = static_cast<int32_t>(n);
+  }
 }
@@ -69,7 +69,11 @@ namespace laplace::core {
   void parser::apply(bool is_ok) noexcept {
     if (!m_buffer_offset.empty()) {
       if (is_ok && m_buffer_offset.size() == 1) {
-        m_buffer.clear();
+        /*  Keep the chars read ahead.
+         */
+        const auto n = min<sl::index>(
+            m_buffer_offset.back().offset, m_buffer.size());
+        m_buffer.erase(m_buffer.begin(), m_buffer.begin() + n);
 
         m_line   = m_buffer_offset.back().line;
         m_column = m_buffer_offset.back().column;
@@ -699,11 +703,18 @@ namespace laplace::core {
             if (c == '\0') {
               result  = false;
               is_done = true;
+              break;
             }
 
             c = get_char();
           }
 
+          /*  The terminator is matched by the format.
+           */
+          if (!is_done) {
+            unget_char();
+          }
+
           if (is_empty) {
             result  = false;
             is_done = true;
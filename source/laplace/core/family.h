@@ -29,6 +29,11 @@ namespace laplace::core {
     using cref_vfamily   = const vfamily &;
     using cref_composite = const composite &;
 
+    /*  Composites of this size and larger keep a hash index of
+     *  the keys beside the ordered storage.
+     */
+    static const sl::whole index_threshold;
+
     family() noexcept  = default;
     ~family() noexcept = default;
 
@@ -40,6 +45,8 @@ namespace laplace::core {
 
     family(cref_vfamily value) noexcept;
     family(cref_composite value) noexcept;
+    family(vfamily &&value) noexcept;
+    family(composite &&value) noexcept;
     family(bool value) noexcept;
     family(signed char value) noexcept;
     family(signed short value) noexcept;
@@ -67,6 +74,8 @@ namespace laplace::core {
 
     auto operator=(cref_vfamily value) noexcept -> ref_family;
     auto operator=(cref_composite value) noexcept -> ref_family;
+    auto operator=(vfamily &&value) noexcept -> ref_family;
+    auto operator=(composite &&value) noexcept -> ref_family;
     auto operator=(bool value) noexcept -> ref_family;
     auto operator=(signed char value) noexcept -> ref_family;
     auto operator=(signed short value) noexcept -> ref_family;
@@ -300,8 +309,59 @@ namespace laplace::core {
     static auto out_of_range() noexcept -> cref_family;
 
   private:
+    /*  Open addressing with linear probing. Empty slots have
+     *  negative position. The tags are the high halves of the
+     *  hashes. Positions are kept apart, so the shift after an
+     *  insertion is a tight loop.
+     */
+    struct key_index {
+      sl::vector<uint32_t> tags;
+      sl::vector<int32_t>  positions;
+    };
+
+    /*  Composite storage. The index is copied with the fields.
+     */
+    struct indexed_composite {
+      composite                  fields;
+      std::unique_ptr<key_index> index;
+
+      indexed_composite() noexcept = default;
+      indexed_composite(const indexed_composite &value) noexcept;
+      indexed_composite(indexed_composite &&) noexcept = default;
+
+      auto operator=(const indexed_composite &value) noexcept
+          -> indexed_composite &;
+      auto operator=(indexed_composite &&) noexcept
+          -> indexed_composite & = default;
+    };
+
+    [[nodiscard]] static auto hash_of(cref_family key) noexcept
+        -> uint64_t;
+    [[nodiscard]] static auto hash_of(signed long long key) noexcept
+        -> uint64_t;
+
+    [[nodiscard]] auto is_indexed() const noexcept -> bool;
+
+    /*  Returns the key position, or -1.
+     */
+    [[nodiscard]] auto find_index(cref_family key,
+                                  uint64_t    hash) const noexcept
+        -> sl::index;
+    [[nodiscard]] auto find_index(signed long long key) const noexcept
+        -> sl::index;
+
+    /*  Rebuild the index if the composite is large enough.
+     */
+    void update_index() noexcept;
+
+    /*  Update the index after a key was inserted by position.
+     */
+    void insert_index(sl::index n) noexcept;
+
     void assign(cref_vfamily value) noexcept;
     void assign(cref_composite value) noexcept;
+    void assign(vfamily &&value) noexcept;
+    void assign(composite &&value) noexcept;
     void assign(bool value) noexcept;
     void assign(signed long long value) noexcept;
     void assign(unsigned long long value) noexcept;
@@ -326,7 +386,8 @@ namespace laplace::core {
 
     using field_type =
         std::variant<std::monostate, uint64_t, bool, int64_t, double,
-                     std::u8string, vbyte, vfamily, composite>;
+                     std::u8string, vbyte, vfamily,
+                     indexed_composite>;
 
     field_type m_data;
   };
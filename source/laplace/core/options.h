@@ -38,6 +38,10 @@ static_assert(sizeof(unsigned long long) == 8);
  */
 //  #define LAPLACE_PLATFORM_DUMMY
 
+/*  Disable SIMD kernels.
+ */
+//  #define LAPLACE_NO_SIMD
+
 /*  Windows preprocessor definitions.
  */
 //  #define _WIN32 1
@@ -98,7 +98,7 @@ namespace laplace::engine::access {
 
   auto world::has_entity(sl::index id) const -> bool {
     if (is_allowed(read_only, m_mode)) {
-      return m_world.get().get_entity(id) ? true : false;
+      return m_world.get().has_entity(id);
     }
 
     return false;
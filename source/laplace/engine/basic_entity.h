@@ -28,6 +28,8 @@
 namespace laplace::engine {
   class basic_entity {
   public:
+    friend class world;
+
     class dummy_tag { };
     class proto_tag { };
 
@@ -66,7 +68,8 @@ namespace laplace::engine {
      */
     void set_tick_period(uint64_t tick_period);
 
-    /*  Set the Entity clock current time.
+    /*  Set the Entity clock current time. The World will
+     *  reschedule the Entity.
      *  Thread-safe.
      */
     void set_clock(uint64_t clock_msec);
@@ -76,6 +79,13 @@ namespace laplace::engine {
      */
     void reset_clock();
 
+    /*  Returns the number of ticks to skip before the next
+     *  Entity tick. The value is updated by the World only
+     *  when the Entity leaves the live loop.
+     *  Thread-safe.
+     */
+    [[nodiscard]] auto get_clock() -> uint64_t;
+
     /*  Set the Entity id. Do not modify the
      *  id set by the World.
      */
@@ -169,7 +179,8 @@ namespace laplace::engine {
     virtual void tick(access::world w);
 
     /*  Decrement the clock timer. Returns true
-     *  if the tick period has expired.
+     *  if the tick period has expired. The World
+     *  does not use it, see world::wheel_size.
      *
      *  Thread-safe.
      */
@@ -240,6 +251,9 @@ namespace laplace::engine {
     void assign(cref_entity en) noexcept;
     void assign(basic_entity &&en) noexcept;
 
+    void store_clock(uint64_t clock) noexcept;
+    void reclock();
+
     std::shared_timed_mutex m_lock;
     std::weak_ptr<world>    m_world;
     vsets_row               m_sets;
@@ -132,7 +132,10 @@ namespace laplace::engine {
     } else {
       error_("Lock timeout.", __FUNCTION__);
       desync();
+      return;
     }
+
+    reclock();
   }
 
   void basic_entity::reset_clock() {
@@ -144,7 +147,20 @@ namespace laplace::engine {
     } else {
       error_("Lock timeout.", __FUNCTION__);
       desync();
+      return;
     }
+
+    reclock();
+  }
+
+  auto basic_entity::get_clock() -> uint64_t {
+    if (auto _sl = shared_lock(m_lock, lock_timeout); _sl) {
+      return m_clock;
+    }
+
+    error_("Lock timeout.", __FUNCTION__);
+    desync();
+    return {};
   }
 
   void basic_entity::set_id(sl::index id) {
@@ -499,11 +515,11 @@ namespace laplace::engine {
       for (sl::index i = 0; i < dst.size(); i++) {
         dst[i] = m_vec[n + i].value;
       }
-    }
 
-    error_("Lock timeout.", __FUNCTION__);
-    desync();
-    return;
+    } else {
+      error_("Lock timeout.", __FUNCTION__);
+      desync();
+    }
   }
 
   void basic_entity::vec_write(sl::index          n,
@@ -520,11 +536,11 @@ namespace laplace::engine {
       }
 
       m_is_vec_changed = true;
-    }
 
-    error_("Lock timeout.", __FUNCTION__);
-    desync();
-    return;
+    } else {
+      error_("Lock timeout.", __FUNCTION__);
+      desync();
+    }
   }
 
   void basic_entity::vec_write_delta(sl::index          n,
@@ -541,11 +557,11 @@ namespace laplace::engine {
       }
 
       m_is_vec_changed = true;
-    }
 
-    error_("Lock timeout.", __FUNCTION__);
-    desync();
-    return;
+    } else {
+      error_("Lock timeout.", __FUNCTION__);
+      desync();
+    }
   }
 
   void basic_entity::vec_erase_delta(sl::index          n,
@@ -562,11 +578,11 @@ namespace laplace::engine {
       }
 
       m_is_vec_changed = true;
-    }
 
-    error_("Lock timeout.", __FUNCTION__);
-    desync();
-    return;
+    } else {
+      error_("Lock timeout.", __FUNCTION__);
+      desync();
+    }
   }
 
   void basic_entity::vec_resize(sl::whole size) noexcept {
@@ -693,6 +709,8 @@ namespace laplace::engine {
   }
 
   void basic_entity::adjust() {
+    bool is_respawn = false;
+
     if (auto _ul = unique_lock(m_lock, lock_timeout); _ul) {
       if (m_is_changed) {
         const auto is_dynamic_old = m_sets[n_is_dynamic].value > 0;
@@ -702,14 +720,8 @@ namespace laplace::engine {
           s.delta = 0;
         }
 
-        /*  Respawn if dynamic status changed.
-         */
-
-        if (is_dynamic_old != (m_sets[n_is_dynamic].value > 0)) {
-          if (auto w = m_world.lock(); w) {
-            w->respawn(m_id);
-          }
-        }
+        is_respawn = is_dynamic_old !=
+                     (m_sets[n_is_dynamic].value > 0);
 
         m_is_changed = false;
       }
@@ -735,6 +747,16 @@ namespace laplace::engine {
       error_("Lock timeout.", __FUNCTION__);
       desync();
     }
+
+    /*  Respawn if dynamic status changed. The World will
+     *  lock the Entity, so do it after unlocking.
+     */
+
+    if (is_respawn) {
+      if (auto w = m_world.lock(); w) {
+        w->respawn(m_id);
+      }
+    }
   }
 
   void basic_entity::tick(access::world w) { }
@@ -795,6 +817,20 @@ namespace laplace::engine {
     w.queue(make_shared<action::remove>(this->get_id()));
   }
 
+  void basic_entity::store_clock(uint64_t clock) noexcept {
+    if (auto _ul = unique_lock(m_lock, lock_timeout); _ul) {
+      m_clock = clock;
+    } else {
+      error_("Lock timeout.", __FUNCTION__);
+    }
+  }
+
+  void basic_entity::reclock() {
+    if (auto w = m_world.lock(); w) {
+      w->reclock(m_id);
+    }
+  }
+
   void basic_entity::desync() {
     if (auto w = m_world.lock(); w) {
       w->desync();
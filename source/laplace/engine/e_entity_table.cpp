@@ -0,0 +1,218 @@
+/*  laplace/engine/e_entity_table.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "entity_table.h"
+
+#include <bit>
+
+namespace laplace::engine {
+  using std::make_unique, std::countr_zero;
+
+  void entity_table::set(sl::index id, ptr_entity en) {
+    if (id < 0) {
+      error_("Invalid entity id.", __FUNCTION__);
+      return;
+    }
+
+    const auto n_page = id / page_size;
+    const auto n      = id % page_size;
+    const auto word   = n / word_bits;
+    const auto bit    = uint64_t { 1 } << (n % word_bits);
+
+    if (n_page >= m_pages.size()) {
+      if (!en) {
+        return;
+      }
+
+      m_pages.resize(n_page + 1);
+
+      const auto words = (m_pages.size() + word_bits - 1) / word_bits;
+
+      m_full.resize(words, 0);
+      m_live.resize(words, 0);
+    }
+
+    auto &p = m_pages[n_page];
+
+    if (!p) {
+      if (!en) {
+        return;
+      }
+
+      p = make_unique<page>();
+    }
+
+    const bool was_live = (p->occupancy[word] & bit) != 0;
+
+    if (en) {
+      if (!was_live) {
+        p->occupancy[word] |= bit;
+        p->count++;
+        m_count++;
+      }
+
+      m_size = std::max<sl::whole>(m_size, id + 1);
+    } else if (was_live) {
+      p->occupancy[word] &= ~bit;
+      p->count--;
+      m_count--;
+    }
+
+    p->entities[n] = std::move(en);
+
+    set_bit(m_full, n_page, p->count == page_size);
+    set_bit(m_live, n_page, p->count > 0);
+  }
+
+  void entity_table::clear() noexcept {
+    m_pages.clear();
+    m_full.clear();
+    m_live.clear();
+
+    m_size  = 0;
+    m_count = 0;
+  }
+
+  auto entity_table::get(sl::index id) const noexcept -> ptr_entity {
+    if (id < 0 || id >= m_size) {
+      return {};
+    }
+
+    const auto &p = m_pages[id / page_size];
+
+    return p ? p->entities[id % page_size] : ptr_entity {};
+  }
+
+  auto entity_table::contains(sl::index id) const noexcept -> bool {
+    if (id < 0 || id >= m_size) {
+      return false;
+    }
+
+    const auto &p = m_pages[id / page_size];
+    const auto  n = id % page_size;
+
+    return p && (p->occupancy[n / word_bits] &
+                 (uint64_t { 1 } << (n % word_bits))) != 0;
+  }
+
+  auto entity_table::get_size() const noexcept -> sl::whole {
+    return m_size;
+  }
+
+  auto entity_table::get_count() const noexcept -> sl::whole {
+    return m_count;
+  }
+
+  auto entity_table::next_free(sl::index id) const noexcept
+      -> sl::index {
+    if (id < 0) {
+      id = 0;
+    }
+
+    for (;;) {
+      const auto n_page = id / page_size;
+
+      if (n_page >= m_pages.size() || !m_pages[n_page]) {
+        return id;
+      }
+
+      const auto &p = *m_pages[n_page];
+
+      if (p.count < page_size) {
+        for (auto n = id % page_size; n < page_size;) {
+          const auto word = n / word_bits;
+          const auto bits = ~p.occupancy[word] >> (n % word_bits);
+
+          if (bits != 0) {
+            return n_page * page_size + n + countr_zero(bits);
+          }
+
+          n = (word + 1) * word_bits;
+        }
+      }
+
+      /*  Skip full pages 64 at a time.
+       */
+      auto i = (n_page + 1) / word_bits;
+      auto b = (n_page + 1) % word_bits;
+
+      id = static_cast<sl::index>(m_pages.size()) * page_size;
+
+      for (; i < m_full.size(); i++, b = 0) {
+        const auto bits = ~m_full[i] >> b;
+
+        if (bits != 0) {
+          const auto k = std::min<sl::index>(
+              i * word_bits + b + countr_zero(bits), m_pages.size());
+
+          id = k * page_size;
+          break;
+        }
+      }
+    }
+  }
+
+  auto entity_table::next_live(sl::index id) const noexcept
+      -> sl::index {
+    if (id < 0) {
+      id = 0;
+    }
+
+    while (id < m_size) {
+      const auto  n_page = id / page_size;
+      const auto &p      = m_pages[n_page];
+
+      if (p && p->count > 0) {
+        for (auto n = id % page_size; n < page_size;) {
+          const auto word = n / word_bits;
+          const auto bits = p->occupancy[word] >> (n % word_bits);
+
+          if (bits != 0) {
+            return n_page * page_size + n + countr_zero(bits);
+          }
+
+          n = (word + 1) * word_bits;
+        }
+      }
+
+      /*  Skip empty pages 64 at a time.
+       */
+      auto i = (n_page + 1) / word_bits;
+      auto b = (n_page + 1) % word_bits;
+
+      id = m_size;
+
+      for (; i < m_live.size(); i++, b = 0) {
+        const auto bits = m_live[i] >> b;
+
+        if (bits != 0) {
+          id = (i * word_bits + b + countr_zero(bits)) * page_size;
+          break;
+        }
+      }
+    }
+
+    return id_undefined;
+  }
+
+  void entity_table::set_bit(sl::vector<uint64_t> &bits,
+                             sl::index             n,
+                             bool                  value) {
+    const auto mask = uint64_t { 1 } << (n % word_bits);
+
+    if (value) {
+      bits[n / word_bits] |= mask;
+    } else {
+      bits[n / word_bits] &= ~mask;
+    }
+  }
+}
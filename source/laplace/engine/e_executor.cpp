@@ -0,0 +1,173 @@
+/*  laplace/engine/e_executor.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "executor.h"
+
+namespace laplace::engine {
+  using std::unique_lock, std::jthread, std::thread, std::move;
+
+  executor::executor(sl::whole thread_count) {
+    auto count = thread_count;
+
+    if (count <= 0) {
+      count = static_cast<sl::whole>(thread::hardware_concurrency());
+    }
+
+    if (count <= 0) {
+      count = 1;
+    }
+
+    m_threads.reserve(count);
+
+    for (sl::index i = 0; i < count; i++) {
+      m_threads.emplace_back([this, i] {
+        this->worker(i);
+      });
+    }
+  }
+
+  executor::~executor() {
+    auto _ul = unique_lock(m_lock);
+    m_done   = true;
+    _ul.unlock();
+
+    m_sync.notify_all();
+
+    for (auto &t : m_threads) { t.join(); }
+  }
+
+  auto executor::add_lane() -> sl::index {
+    auto _ul = unique_lock(m_lock);
+
+    for (sl::index i = 0; i < m_lanes.size(); i++) {
+      if (!m_lanes[i].is_used) {
+        m_lanes[i].is_used = true;
+        return i;
+      }
+    }
+
+    m_lanes.emplace_back().is_used = true;
+    return static_cast<sl::index>(m_lanes.size()) - 1;
+  }
+
+  void executor::remove_lane(sl::index lane) {
+    auto _ul = unique_lock(m_lock);
+
+    if (lane < 0 || lane >= m_lanes.size()) {
+      error_("Invalid lane.", __FUNCTION__);
+      return;
+    }
+
+    m_pending -= static_cast<sl::whole>(m_lanes[lane].tasks.size());
+    m_lanes[lane] = {};
+  }
+
+  void executor::submit(sl::index lane, task fn) {
+    auto _ul = unique_lock(m_lock);
+
+    if (lane < 0 || lane >= m_lanes.size() ||
+        !m_lanes[lane].is_used) {
+      error_("Invalid lane.", __FUNCTION__);
+      return;
+    }
+
+    m_lanes[lane].tasks.emplace_back(move(fn));
+    m_pending++;
+    _ul.unlock();
+
+    m_sync.notify_one();
+  }
+
+  void executor::set_thread_init(thread_init fn) {
+    auto _ul = unique_lock(m_lock);
+    m_init   = move(fn);
+    m_init_version++;
+    _ul.unlock();
+
+    m_sync.notify_all();
+  }
+
+  auto executor::get_thread_count() const noexcept -> sl::whole {
+    return static_cast<sl::whole>(m_threads.size());
+  }
+
+  auto executor::get_default() -> executor & {
+    static auto pool = executor {};
+    return pool;
+  }
+
+  auto executor::locked_next(task &fn) -> bool {
+    if (m_done && m_pending == 0) {
+      return false;
+    }
+
+    const auto count = static_cast<sl::whole>(m_lanes.size());
+
+    for (sl::index i = 0; i < count; i++) {
+      auto &lane = m_lanes[(m_next + i) % count];
+
+      if (!lane.tasks.empty()) {
+        fn = move(lane.tasks.front());
+        lane.tasks.pop_front();
+        m_pending--;
+
+        m_next = (m_next + i + 1) % count;
+        return true;
+      }
+    }
+
+    return true;
+  }
+
+  void executor::worker(sl::index n) {
+    auto _ul     = unique_lock(m_lock);
+    auto version = sl::index {};
+
+    for (;;) {
+      m_sync.wait(_ul, [this, &version] {
+        return m_pending > 0 || m_done || version != m_init_version;
+      });
+
+      if (version != m_init_version) {
+        version   = m_init_version;
+        auto init = m_init;
+
+        if (init) {
+          _ul.unlock();
+          init(n);
+          init = nullptr;
+          _ul.lock();
+        }
+
+        continue;
+      }
+
+      auto fn = task {};
+
+      if (!locked_next(fn)) {
+        break;
+      }
+
+      if (fn) {
+        _ul.unlock();
+
+        fn();
+
+        /*  The captures are released out of the lock.
+         */
+        fn = nullptr;
+
+        _ul.lock();
+      }
+    }
+  }
+}
@@ -13,42 +13,32 @@
 #include "loader.h"
 
 namespace laplace::engine {
-  using std::shared_lock, std::unique_lock, std::jthread;
+  using std::unique_lock, std::jthread, std::span;
 
-  loader::loader() {
-    m_thread = jthread([this]() {
-      auto _ul = unique_lock(m_lock);
+  const sl::whole loader::default_thread_count = 0;
 
-      while (!m_is_done) {
-        while (!m_queue.empty()) {
-          auto task = ptr_impact { m_queue.front() };
-          m_queue.erase(m_queue.begin());
+  loader::loader(sl::whole thread_count) {
+    if (thread_count == 0) {
+      thread_count = std::thread::hardware_concurrency();
+    }
 
-          if (m_world) {
-            _ul.unlock();
+    if (thread_count == 0) {
+      thread_count = 1;
+    }
 
-            task->perform({ *m_world, access::data });
+    m_threads.reserve(thread_count);
 
-            _ul.lock();
-            m_progress++;
-          } else {
-            error_("No world.", __FUNCTION__);
-          }
-        }
-
-        m_is_ready = true;
-
-        if (m_is_done) {
-          break;
-        }
-
-        m_sync.wait(_ul);
-      }
-    });
+    for (sl::index i = 0; i < thread_count; i++) {
+      m_threads.emplace_back([this]() { tick_thread(); });
+    }
   }
 
   loader::~loader() {
     done();
+
+    /*  Join the threads before the data is destroyed.
+     */
+    m_threads.clear();
   }
 
   void loader::set_world(ptr_world w) {
@@ -56,11 +46,33 @@ namespace laplace::engine {
     m_world  = w;
   }
 
-  void loader::add_task(ptr_impact task) {
-    auto _ul   = unique_lock(m_lock);
-    m_is_ready = false;
-    m_queue.emplace_back(task);
-    m_sync.notify_all();
+  void loader::on_progress(fn_progress fn) {
+    auto _ul      = unique_lock(m_lock);
+    m_on_progress = std::move(fn);
+  }
+
+  auto loader::add_task(ptr_impact task) -> sl::index {
+    auto _ul = unique_lock(m_lock);
+
+    if (m_tasks.empty()) {
+      return locked_add_task(task, {});
+    }
+
+    const auto previous = static_cast<sl::index>(m_tasks.size() - 1);
+
+    return locked_add_task(task, span<const sl::index>(&previous, 1));
+  }
+
+  auto loader::add_task(ptr_impact            task,
+                        span<const sl::index> dependencies)
+      -> sl::index {
+    auto _ul = unique_lock(m_lock);
+    return locked_add_task(task, dependencies);
+  }
+
+  void loader::wait() {
+    auto _ul = unique_lock(m_lock);
+    m_sync.wait(_ul, [this]() { return m_is_ready; });
   }
 
   auto loader::is_ready() -> bool {
@@ -73,10 +85,118 @@ namespace laplace::engine {
     return m_progress;
   }
 
-  void loader::set_ready(bool is_ready) {
-    auto _ul   = unique_lock(m_lock);
-    m_is_ready = is_ready;
+  auto loader::get_task_count() -> sl::whole {
+    auto _ul = unique_lock(m_lock);
+    return m_tasks.size();
+  }
+
+  auto loader::get_thread_count() const noexcept -> sl::whole {
+    return m_threads.size();
+  }
+
+  void loader::tick_thread() {
+    auto _ul = unique_lock(m_lock);
+
+    for (;;) {
+      while (m_ready_next == m_ready.size()) {
+        if (m_is_done && m_progress == m_tasks.size()) {
+          return;
+        }
+
+        m_sync.wait(_ul);
+      }
+
+      const auto n    = m_ready[m_ready_next++];
+      auto       task = ptr_impact { m_tasks[n].impact };
+      auto       w    = ptr_world { m_world };
+
+      if (m_ready_next == m_ready.size()) {
+        m_ready.clear();
+        m_ready_next = 0;
+      }
+
+      _ul.unlock();
+
+      if (w) {
+        task->perform({ *w, access::data });
+      } else {
+        error_("No world.", __FUNCTION__);
+      }
+
+      task.reset();
+      w.reset();
+
+      _ul.lock();
+
+      auto &t = m_tasks[n];
+
+      t.impact.reset();
+      t.is_done = true;
+      m_progress++;
+
+      for (auto k : t.next) {
+        if (--m_tasks[k].pending == 0) {
+          m_ready.emplace_back(k);
+        }
+      }
+
+      t.next.clear();
+
+      if (m_on_progress) {
+        m_sync.notify_all();
+
+        auto       fn       = fn_progress { m_on_progress };
+        const auto progress = m_progress;
+        const auto total    = m_tasks.size();
+
+        m_callback_count++;
+        _ul.unlock();
+
+        fn(progress, total);
+
+        _ul.lock();
+        m_callback_count--;
+      }
+
+      /*  The loader is ready when all progress callbacks are
+       *  returned.
+       */
+      if (m_progress == m_tasks.size() && m_callback_count == 0) {
+        m_is_ready = true;
+      }
+
+      m_sync.notify_all();
+    }
+  }
+
+  auto loader::locked_add_task(ptr_impact            task,
+                               span<const sl::index> dependencies)
+      -> sl::index {
+    const auto n = static_cast<sl::index>(m_tasks.size());
+
+    auto &t  = m_tasks.emplace_back();
+    t.impact = task;
+
+    for (auto dep : dependencies) {
+      if (dep < 0 || dep >= n) {
+        error_("Invalid dependency.", __FUNCTION__);
+        continue;
+      }
+
+      if (!m_tasks[dep].is_done) {
+        m_tasks[dep].next.emplace_back(n);
+        t.pending++;
+      }
+    }
+
+    if (t.pending == 0) {
+      m_ready.emplace_back(n);
+    }
+
+    m_is_ready = false;
     m_sync.notify_all();
+
+    return n;
   }
 
   void loader::done() {
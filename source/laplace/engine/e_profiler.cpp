@@ -0,0 +1,324 @@
+/*  laplace/engine/e_profiler.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <map>
+
+namespace laplace::engine {
+  using std::unique_lock, std::make_unique, std::string_view,
+      std::ostream, std::ofstream, std::map, std::type_info,
+      std::max, std::atomic_ref, std::atomic_thread_fence,
+      std::memory_order_relaxed, std::memory_order_acquire,
+      std::memory_order_release, std::chrono::steady_clock,
+      std::chrono::nanoseconds, std::chrono::duration_cast;
+
+  const sl::whole profiler::default_capacity = 0x10000;
+
+  profiler::ring::ring(sl::whole capacity) :
+      m_samples(capacity > 0 ? capacity : 1) { }
+
+  void profiler::ring::push(const sample &s) noexcept {
+    const auto n = m_count.load(memory_order_relaxed);
+
+    /*  Announce the slot before writing, so the readers can
+     *  skip it.
+     */
+    m_started.store(n + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    auto &x = m_samples[n % m_samples.size()];
+
+    atomic_ref(x.type).store(s.type, memory_order_relaxed);
+    atomic_ref(x.begin).store(s.begin, memory_order_relaxed);
+    atomic_ref(x.end).store(s.end, memory_order_relaxed);
+    atomic_ref(x.what).store(s.what, memory_order_relaxed);
+
+    m_count.store(n + 1, memory_order_release);
+  }
+
+  void profiler::ring::resize(sl::whole capacity) {
+    auto _ul = unique_lock(m_lock);
+
+    m_samples.resize(capacity > 0 ? capacity : 1);
+    m_first.store(m_count.load(memory_order_relaxed),
+                  memory_order_relaxed);
+  }
+
+  void profiler::ring::clear() noexcept {
+    m_first.store(m_count.load(memory_order_acquire),
+                  memory_order_relaxed);
+  }
+
+  auto profiler::ring::get_all() -> sl::vector<sample> {
+    auto _ul = unique_lock(m_lock);
+
+    const auto capacity = static_cast<sl::whole>(m_samples.size());
+    const auto count    = m_count.load(memory_order_acquire);
+    const auto first    = max({ m_first.load(memory_order_relaxed),
+                                count - capacity, sl::whole {} });
+
+    auto load = [](auto &value) {
+      return atomic_ref(value).load(memory_order_relaxed);
+    };
+
+    auto v = sl::vector<sample>(max<sl::whole>(0, count - first));
+
+    for (sl::index i = 0; i < v.size(); i++) {
+      auto &x = m_samples[(first + i) % capacity];
+
+      v[i] = { .type  = load(x.type),
+               .begin = load(x.begin),
+               .end   = load(x.end),
+               .what  = load(x.what) };
+    }
+
+    /*  Drop the samples overwritten while copying.
+     */
+    atomic_thread_fence(memory_order_acquire);
+
+    const auto overwritten = m_started.load(memory_order_relaxed) -
+                             capacity - first;
+
+    if (overwritten > 0) {
+      v.erase(v.begin(),
+              v.begin() + std::min<sl::whole>(overwritten, v.size()));
+    }
+
+    return v;
+  }
+
+  profiler::scope::scope(ring            *r,
+                         kind             what,
+                         const type_info *type) noexcept :
+      m_ring(r), m_type(type), m_begin(r ? now() : 0),
+      m_what(what) { }
+
+  profiler::scope::~scope() {
+    if (m_ring) {
+      m_ring->push({ .type  = m_type,
+                     .begin = m_begin,
+                     .end   = now(),
+                     .what  = m_what });
+    }
+  }
+
+  void profiler::enable(bool is_enabled) noexcept {
+    m_is_enabled.store(is_enabled, memory_order_relaxed);
+  }
+
+  void profiler::enable_detailed(bool is_enabled) noexcept {
+    m_is_detailed.store(is_enabled, memory_order_relaxed);
+  }
+
+  void profiler::set_capacity(sl::whole capacity) {
+    auto _ul = unique_lock(m_lock);
+
+    m_capacity = capacity;
+
+    for (auto &r : m_rings) { r->resize(capacity); }
+  }
+
+  auto profiler::is_enabled() const noexcept -> bool {
+    return m_is_enabled.load(memory_order_relaxed);
+  }
+
+  auto profiler::is_detailed() const noexcept -> bool {
+    return m_is_detailed.load(memory_order_relaxed);
+  }
+
+  auto profiler::get_ring(sl::index thread_index) -> ring * {
+    if (!is_enabled() || thread_index < 0) {
+      return nullptr;
+    }
+
+    auto _ul = unique_lock(m_lock);
+
+    while (m_rings.size() <= thread_index) {
+      m_rings.emplace_back(make_unique<ring>(m_capacity));
+    }
+
+    return m_rings[thread_index].get();
+  }
+
+  auto profiler::detailed(ring *r) const noexcept -> ring * {
+    return is_detailed() ? r : nullptr;
+  }
+
+  void profiler::clear() {
+    auto _ul = unique_lock(m_lock);
+
+    for (auto &r : m_rings) { r->clear(); }
+  }
+
+  auto profiler::get_thread_count() -> sl::whole {
+    auto _ul = unique_lock(m_lock);
+    return m_rings.size();
+  }
+
+  auto profiler::get_samples(sl::index thread_index)
+      -> sl::vector<sample> {
+    auto _ul = unique_lock(m_lock);
+
+    if (thread_index < 0 || thread_index >= m_rings.size()) {
+      return {};
+    }
+
+    return m_rings[thread_index]->get_all();
+  }
+
+  auto profiler::get_stats(kind what) -> stats {
+    auto _ul = unique_lock(m_lock);
+    auto s   = stats {};
+
+    for (auto &r : m_rings) {
+      for (const auto &x : r->get_all()) {
+        if (x.what == what) {
+          const auto dt = x.end - x.begin;
+
+          s.count++;
+          s.total += dt;
+          s.max = std::max(s.max, dt);
+        }
+      }
+    }
+
+    return s;
+  }
+
+  auto profiler::get_type_stats() -> sl::vector<type_stats> {
+    auto _ul = unique_lock(m_lock);
+
+    auto types = map<const type_info *, type_stats> {};
+
+    for (auto &r : m_rings) {
+      for (const auto &x : r->get_all()) {
+        if (x.type == nullptr) {
+          continue;
+        }
+
+        auto &t = types[x.type];
+
+        if (t.cost.count == 0) {
+          t.name = x.type->name();
+          t.what = x.what;
+        }
+
+        const auto dt = x.end - x.begin;
+
+        t.cost.count++;
+        t.cost.total += dt;
+        t.cost.max = std::max(t.cost.max, dt);
+      }
+    }
+
+    auto v = sl::vector<type_stats> {};
+    v.reserve(types.size());
+
+    for (auto &t : types) { v.emplace_back(std::move(t.second)); }
+
+    std::sort(v.begin(), v.end(),
+              [](const type_stats &a, const type_stats &b) {
+                return a.cost.total > b.cost.total;
+              });
+
+    return v;
+  }
+
+  void profiler::dump_trace(ostream &out) {
+    auto _ul = unique_lock(m_lock);
+
+    auto samples = sl::vector<sl::vector<sample>>(m_rings.size());
+    auto origin  = std::numeric_limits<int64_t>::max();
+
+    for (sl::index i = 0; i < samples.size(); i++) {
+      samples[i] = m_rings[i]->get_all();
+
+      if (!samples[i].empty()) {
+        origin = std::min(origin, samples[i][0].begin);
+      }
+    }
+
+    _ul.unlock();
+
+    /*  Chrome trace timestamps are in microseconds.
+     */
+    auto usec = [origin](int64_t ns) {
+      return static_cast<double>(ns - origin) / 1000.;
+    };
+
+    out << "{\"traceEvents\":[";
+
+    bool first = true;
+
+    for (sl::index tid = 0; tid < samples.size(); tid++) {
+      for (const auto &x : samples[tid]) {
+        if (!first) {
+          out << ",";
+        }
+
+        first = false;
+
+        out << "\n{\"name\":\"";
+
+        if (x.type != nullptr) {
+          out << x.type->name();
+        } else {
+          out << get_name(x.what);
+        }
+
+        out << "\",\"cat\":\"" << get_name(x.what)
+            << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << tid
+            << ",\"ts\":" << usec(x.begin)
+            << ",\"dur\":" << usec(x.end) - usec(x.begin) << "}";
+      }
+    }
+
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+  }
+
+  auto profiler::save_trace(string_view file_name) -> bool {
+    auto out = ofstream(std::string(file_name));
+
+    if (!out) {
+      error_("Unable to open file.", __FUNCTION__);
+      return false;
+    }
+
+    dump_trace(out);
+    return true;
+  }
+
+  auto profiler::get_name(kind what) noexcept -> string_view {
+    switch (what) {
+      case sync_queue: return "sync_queue";
+      case async_queue: return "async_queue";
+      case dynamic_tick: return "dynamic_tick";
+      case adjust: return "adjust";
+      case barrier_wait: return "barrier_wait";
+      case impact: return "impact";
+      case entity: return "entity";
+      default:;
+    }
+
+    return "unknown";
+  }
+
+  auto profiler::now() noexcept -> int64_t {
+    return duration_cast<nanoseconds>(
+               steady_clock::now().time_since_epoch())
+        .count();
+  }
+}
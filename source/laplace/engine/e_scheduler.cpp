@@ -14,50 +14,64 @@
 
 #include "basic_impact.h"
 #include "world.h"
-#include <mutex>
 #include <sstream>
 
 namespace laplace::engine {
-  using std::unique_lock, std::lock, std::adopt_lock, std::jthread,
-      std::thread, std::function, std::ostringstream;
+  using std::unique_lock, std::thread, std::ostringstream;
 
   const sl::whole scheduler::overthreading_limit = 8;
   const sl::whole scheduler::concurrency_limit   = 0x1000;
 
-  scheduler::scheduler(world &w) : m_world(w) { }
+  scheduler::scheduler(world &w, executor &pool) :
+      m_world(w), m_pool(pool), m_lane(pool.add_lane()) { }
 
   scheduler::~scheduler() {
-    set_done();
+    auto _ul = unique_lock(m_lock);
+
+    m_done = true;
+
+    m_sync.wait(_ul, [this] {
+      return !m_is_running;
+    });
+
+    _ul.unlock();
+
+    m_pool.remove_lane(m_lane);
   }
 
   void scheduler::schedule(sl::whole delta) {
-    lock(m_lock_ex, m_lock_in);
-    auto _ul_ex = unique_lock(m_lock_ex, adopt_lock);
-    auto _ul    = unique_lock(m_lock_in, adopt_lock);
+    auto _ul = unique_lock(m_lock);
+
+    /*  The World is frozen during the ticks, except for the
+     *  sync phases.
+     */
+    if (m_tick_count == 0 && delta > 0 && m_thread_count > 0) {
+      m_world.freeze();
+    }
 
     m_tick_count += delta;
+
+    if (m_is_running || m_tick_count <= 0 || m_thread_count <= 0) {
+      return;
+    }
+
+    locked_begin(m_thread_count);
     _ul.unlock();
 
-    m_sync.notify_all();
+    m_pool.submit(m_lane, [this] {
+      this->next_queue(0);
+    });
   }
 
   void scheduler::join() {
-    lock(m_lock_ex, m_lock_in);
-    auto _ul_ex = unique_lock(m_lock_ex, adopt_lock);
-    auto _ul    = unique_lock(m_lock_in, adopt_lock);
+    auto _ul = unique_lock(m_lock);
 
-    if (!m_threads.empty()) {
-      m_sync.wait(_ul, [this] {
-        return m_tick_count == 0u || m_threads.empty();
-      });
-    }
+    m_sync.wait(_ul, [this] {
+      return !m_is_running;
+    });
   }
 
   void scheduler::set_thread_count(const sl::whole thread_count) {
-    lock(m_lock_ex, m_lock_in);
-    auto _ul_ex = unique_lock(m_lock_ex, adopt_lock);
-    auto _ul    = unique_lock(m_lock_in, adopt_lock);
-
     const auto thread_count_limit = []() -> sl::whole {
       const auto limit = thread::hardware_concurrency() *
                          overthreading_limit;
@@ -86,148 +100,204 @@ namespace laplace::engine {
       count = thread_count_limit;
     }
 
-    sl::whole n = m_threads.size();
+    /*  The phase task count is fixed while running.
+     */
+    join();
 
-    if (count < n) {
-      m_done = true;
-      _ul.unlock();
+    auto _ul = unique_lock(m_lock);
 
-      m_sync.notify_all();
+    const auto is_pending = m_thread_count == 0 && m_tick_count > 0;
 
-      for (auto &t : m_threads) { t.join(); }
+    m_thread_count = count;
 
-      _ul.lock();
-      m_done = false;
+    if (is_pending && count > 0) {
+      m_world.freeze();
 
-      n = 0;
-    } else if (count > n) {
-      m_threads.resize(count);
-    }
+      locked_begin(count);
+      _ul.unlock();
 
-    for (auto i = n; i < m_threads.size(); i++) {
-      m_threads[i] = jthread([this] {
-        this->tick_thread();
+      m_pool.submit(m_lane, [this] {
+        this->next_queue(0);
       });
     }
   }
 
   auto scheduler::get_thread_count() -> sl::whole {
-    auto _ul = unique_lock(m_lock_ex);
-    return m_threads.size();
+    auto _ul = unique_lock(m_lock);
+    return m_thread_count;
   }
 
-  void scheduler::set_done() {
-    lock(m_lock_ex, m_lock_in);
-    auto _ul_ex = unique_lock(m_lock_ex, adopt_lock);
-    auto _ul    = unique_lock(m_lock_in, adopt_lock);
+  void scheduler::next_queue(sl::index thread_index) {
+    if (m_world.no_queue()) {
+      start(dynamic_tick);
+      return;
+    }
 
-    m_done = true;
-    _ul.unlock();
+    /*  Execute the sync queue.
+     */
 
-    m_sync.notify_all();
-  }
+    auto *const prof = m_rings[thread_index];
+    auto *const info = m_world.get_profiler().detailed(prof);
 
-  void scheduler::sync(function<void()> fn) {
-    auto _ul = unique_lock(m_lock_in);
+    {
+      auto _p = profiler::scope(prof, profiler::sync_queue);
 
-    m_in++;
+      m_world.unfreeze();
 
-    if (m_in >= m_threads.size()) {
-      m_out = 0;
-      _ul.unlock();
+      while (auto ev = m_world.next_sync_impact()) {
+        auto _i = profiler::scope(info, profiler::impact,
+                                  &typeid(*ev));
 
-      fn();
+        ev->perform({ m_world, access::sync });
+      }
 
-      m_sync.notify_all();
+      m_world.clean_sync_queue();
+      m_world.freeze();
+    }
 
-      _ul.lock();
-    } else {
-      m_sync.wait(_ul, [this] {
-        return m_in >= m_threads.size();
-      });
+    start(async_queue);
+  }
+
+  void scheduler::locked_begin(sl::whole count) {
+    auto &stats = m_world.get_profiler();
+
+    m_is_running  = true;
+    m_phase_count = count;
+    m_rings.resize(count);
+    m_idle_since.assign(count, 0);
+
+    for (sl::index i = 0; i < count; i++) {
+      m_rings[i] = stats.get_ring(i);
     }
+  }
 
-    m_out++;
+  void scheduler::start(phase_type phase) {
+    auto _ul = unique_lock(m_lock);
 
-    if (m_out >= m_threads.size()) {
-      m_in = 0;
-      _ul.unlock();
+    const auto count = m_phase_count;
+    m_active         = count;
+    _ul.unlock();
 
-      m_sync.notify_all();
-    } else {
-      m_sync.wait(_ul, [this] {
-        return m_out >= m_threads.size();
+    for (sl::index i = 0; i < count; i++) {
+      m_pool.submit(m_lane, [this, phase, i] {
+        this->perform(phase, i);
       });
     }
   }
 
-  void scheduler::tick_thread() {
-    auto _ul = unique_lock(m_lock_in);
+  void scheduler::perform(phase_type phase, sl::index thread_index) {
+    auto *const prof = m_rings[thread_index];
+    auto *const info = m_world.get_profiler().detailed(prof);
 
-    while (m_sync.wait(_ul,
-                       [this] {
-                         return m_tick_count > 0 || m_done;
-                       }),
-           !m_done) {
-      while (m_tick_count > 0) {
-        _ul.unlock();
+    auto &idle_since = m_idle_since[thread_index];
 
-        while (!m_world.no_queue()) {
-          /*  Execute the sync queue.
-           */
+    if (prof != nullptr && idle_since != 0) {
+      prof->push({ .type  = nullptr,
+                   .begin = idle_since,
+                   .end   = profiler::now(),
+                   .what  = profiler::barrier_wait });
+    }
 
-          sync([this] {
-            while (auto ev = m_world.next_sync_impact()) {
-              ev->perform({ m_world, access::sync });
-            }
+    if (phase == async_queue) {
+      /*  Execute the async queue.
+       */
 
-            m_world.clean_sync_queue();
-          });
+      auto _p = profiler::scope(prof, profiler::async_queue);
+      auto _r = world::read_scope(m_world);
 
-          /*  Execute the async queue.
-           */
+      while (auto ev = m_world.next_async_impact()) {
+        auto _i = profiler::scope(info, profiler::impact,
+                                  &typeid(*ev));
 
-          while (auto ev = m_world.next_async_impact()) {
-            ev->perform({ m_world, access::async });
-          }
+        ev->perform({ m_world, access::async });
+      }
 
-          sync([this] {
-            m_world.clean_async_queue();
-          });
-        }
+    } else if (phase == dynamic_tick) {
+      /*  Update the dynamic entities.
+       */
 
-        /*  Update the dynamic entities.
-         */
+      auto _p = profiler::scope(prof, profiler::dynamic_tick);
+      auto _r = world::read_scope(m_world);
 
-        while (auto en = m_world.next_dynamic_entity()) {
-          if (en->clock()) {
-            en->tick({ m_world, access::async });
-          }
-        }
+      while (auto en = m_world.next_dynamic_entity()) {
+        auto _i = profiler::scope(info, profiler::entity,
+                                  &typeid(*en));
 
-        sync([this] {
-          m_world.reset_index();
-        });
+        en->tick({ m_world, access::async });
+      }
 
-        /*  Adjust all the entities.
-         */
+    } else {
+      /*  Adjust all the entities.
+       */
 
-        while (auto en = m_world.next_entity()) { en->adjust(); }
+      auto _p = profiler::scope(prof, profiler::adjust);
+      auto _r = world::read_scope(m_world);
 
-        sync([this] {
-          m_world.reset_index();
+      while (auto en = m_world.next_entity()) { en->adjust(); }
+    }
 
-          m_tick_count--;
-        });
+    if (prof != nullptr) {
+      idle_since = profiler::now();
+    }
 
-        _ul.lock();
-      }
+    auto _ul = unique_lock(m_lock);
 
-      _ul.unlock();
+    if (--m_active > 0) {
+      return;
+    }
+
+    _ul.unlock();
+
+    finish(phase, thread_index);
+  }
+
+  void scheduler::finish(phase_type phase, sl::index thread_index) {
+    auto _ul = unique_lock(m_lock);
 
+    if (m_done) {
+      m_is_running = false;
       m_sync.notify_all();
+      return;
+    }
+
+    _ul.unlock();
 
-      _ul.lock();
+    if (phase == async_queue) {
+      m_world.clean_async_queue();
+      next_queue(thread_index);
+      return;
     }
+
+    if (phase == dynamic_tick) {
+      m_world.reset_index();
+      m_world.reset_due();
+      start(adjust);
+      return;
+    }
+
+    m_world.reset_index();
+    m_world.notify_tick();
+
+    /*  Apply the deferred changes.
+     */
+    m_world.unfreeze();
+
+    _ul.lock();
+
+    m_tick_count--;
+
+    if (m_tick_count > 0 && !m_done) {
+      m_world.freeze();
+      _ul.unlock();
+
+      next_queue(thread_index);
+      return;
+    }
+
+    /*  Notify under the lock, so the scheduler is not destroyed
+     *  before.
+     */
+    m_is_running = false;
+    m_sync.notify_all();
   }
 }
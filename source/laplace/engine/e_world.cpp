@@ -18,10 +18,29 @@
 namespace laplace::engine {
   using std::make_shared, std::unique_lock, std::shared_lock;
 
-  const bool world::default_allow_relaxed_spawn = false;
+  const bool      world::default_allow_relaxed_spawn = false;
+  const sl::whole world::wheel_size                  = 0x100;
+
+  thread_local world *world::m_reader = nullptr;
+
+  world::read_scope::read_scope(world &w) noexcept :
+      m_previous(m_reader) {
+    m_reader = &w;
+  }
+
+  world::read_scope::~read_scope() {
+    m_reader = m_previous;
+  }
 
   world::world() {
     m_scheduler = make_unique<scheduler>(*this);
+    m_wheel.resize(wheel_size);
+  }
+
+  world::~world() {
+    /*  Stop the ticks before the Entities are destroyed.
+     */
+    m_scheduler.reset();
   }
 
   auto world::reserve(sl::index id) -> sl::index {
@@ -31,125 +50,41 @@ namespace laplace::engine {
   void world::emplace(ptr_entity ent, sl::index id) {
     auto _ul = unique_lock(m_lock);
 
-    if (ent) {
-      if (id == id_undefined) {
-        id = m_next_id;
-      }
-
-      if (id >= m_entities.size()) {
-        m_entities.resize(id + 1);
-      }
-
-      if (m_entities[id]) {
-        if (m_entities[id]->is_dynamic()) {
-          locked_erase_dynamic(id);
-        }
-
-        m_entities[id]->reset_world();
-      }
-
-      m_entities[id] = ent;
-
-      ent->set_id(id);
-      ent->set_world(shared_from_this());
-
-      while (m_next_id < m_entities.size() && m_entities[m_next_id]) {
-        m_next_id++;
-      }
-
-      if (ent->is_dynamic()) {
-        locked_add_dynamic(id);
-      }
+    if (m_is_frozen) {
+      locked_defer(deferred_op::emplace, ent, id);
     } else {
-      error_("Unable to spawn null entity.", __FUNCTION__);
+      locked_spawn(ent, id, true);
     }
   }
 
   auto world::spawn(ptr_entity ent, sl::index id) -> sl::index {
     auto _ul = unique_lock(m_lock);
 
-    if (ent) {
-      if (id == id_undefined) {
-        id = m_next_id;
-      }
-
-      if (id >= m_entities.size()) {
-        m_entities.resize(id + 1);
-      }
-
-      if (m_entities[id]) {
-        if (!m_allow_relaxed_spawn) {
-          error_("Id is not free.", __FUNCTION__);
-          locked_desync();
-
-          return id_undefined;
-        }
-
-        if (m_entities[id]->is_dynamic()) {
-          locked_erase_dynamic(id);
-        }
-
-        m_entities[id]->reset_world();
-      }
-
-      m_entities[id] = ent;
-
-      ent->set_id(id);
-      ent->set_world(shared_from_this());
-
-      while (m_next_id < m_entities.size() && m_entities[m_next_id]) {
-        m_next_id++;
-      }
-
-      if (ent->is_dynamic()) {
-        locked_add_dynamic(id);
-      }
-
-      return id;
-    } else {
-      error_("Unable to spawn null entity.", __FUNCTION__);
+    if (m_is_frozen) {
+      return locked_defer(deferred_op::spawn, ent, id);
     }
 
-    return id_undefined;
+    return locked_spawn(ent, id, m_allow_relaxed_spawn);
   }
 
   void world::remove(sl::index id) {
     auto _ul = unique_lock(m_lock);
 
-    if (id < m_entities.size()) {
-      if (m_entities[id]) {
-        if (m_entities[id]->is_dynamic()) {
-          locked_erase_dynamic(id);
-        }
-
-        m_entities[id]->reset_world();
-        m_entities[id].reset();
-      } else {
-        if (m_allow_relaxed_spawn) {
-          error_("No entity.", __FUNCTION__);
-          locked_desync();
-        }
-      }
-
-      if (m_next_id > id) {
-        m_next_id = id;
-      }
+    if (m_is_frozen) {
+      locked_defer(deferred_op::remove, {}, id);
     } else {
-      error_("Invalid entity id.", __FUNCTION__);
-      locked_desync();
+      locked_remove(id);
     }
   }
 
   void world::respawn(sl::index id) {
     auto _ul = unique_lock(m_lock);
 
-    if (id < m_entities.size()) {
-      if (m_entities[id]) {
-        locked_erase_dynamic(id);
+    if (auto en = m_entities.get(id); en) {
+      locked_erase_dynamic(id);
 
-        if (m_entities[id]->is_dynamic()) {
-          locked_add_dynamic(id);
-        }
+      if (en->is_dynamic()) {
+        locked_add_dynamic(id);
       }
     }
   }
@@ -157,18 +92,21 @@ namespace laplace::engine {
   void world::clear() {
     auto _ul = unique_lock(m_lock);
 
-    for (auto &ent : m_entities) {
-      if (ent) {
-        ent->reset_world();
-      }
+    if (m_is_frozen) {
+      locked_defer(deferred_op::clear, {}, id_undefined);
+    } else {
+      locked_clear();
     }
+  }
 
-    m_entities.clear();
-    m_dynamic_ids.clear();
+  void world::freeze() {
+    auto _ul = unique_lock(m_lock);
+    locked_freeze();
+  }
 
-    m_root    = id_undefined;
-    m_next_id = 0;
-    m_desync  = false;
+  void world::unfreeze() {
+    auto _ul = unique_lock(m_lock);
+    locked_unfreeze();
   }
 
   void world::queue(ptr_impact ev) {
@@ -203,44 +141,108 @@ namespace laplace::engine {
     if (get_thread_count() <= 0) {
       auto _ul = unique_lock(m_lock);
 
+      auto *const prof = m_profiler.get_ring(0);
+      auto *const info = m_profiler.detailed(prof);
+
       for (uint64_t t = 0; t < delta; t++) {
         while (!m_sync_queue.empty() || !m_queue.empty()) {
-          for (sl::index i = 0; i < m_sync_queue.size(); i++) {
-            _ul.unlock();
+          {
+            auto _p = profiler::scope(prof, profiler::sync_queue);
 
-            m_sync_queue[i]->perform({ *this, access::sync });
+            for (sl::index i = 0; i < m_sync_queue.size(); i++) {
+              auto ev = m_sync_queue[i];
+              _ul.unlock();
 
-            _ul.lock();
+              {
+                auto _i = profiler::scope(info, profiler::impact,
+                                          &typeid(*ev));
+
+                ev->perform({ *this, access::sync });
+              }
+
+              _ul.lock();
+            }
+
+            m_sync_queue.clear();
+          }
+
+          {
+            auto _p = profiler::scope(prof, profiler::async_queue);
+            auto _r = read_scope(*this);
+
+            locked_freeze();
+
+            for (sl::index i = 0; i < m_queue.size(); i++) {
+              auto ev = m_queue[i];
+              _ul.unlock();
+
+              {
+                auto _i = profiler::scope(info, profiler::impact,
+                                          &typeid(*ev));
+
+                ev->perform({ *this, access::async });
+              }
+
+              _ul.lock();
+            }
+
+            m_queue.clear();
           }
 
-          m_sync_queue.clear();
+          locked_unfreeze();
+        }
+
+        {
+          auto _p = profiler::scope(prof, profiler::dynamic_tick);
+          auto _r = read_scope(*this);
 
-          for (sl::index i = 0; i < m_queue.size(); i++) {
+          locked_freeze();
+          locked_collect_due();
+
+          for (sl::index i = 0; i < m_due_ids.size(); i++) {
+            auto en = m_entities.get(m_due_ids[i]);
             _ul.unlock();
 
-            m_queue[i]->perform({ *this, access::async });
+            {
+              auto _i = profiler::scope(info, profiler::entity,
+                                        &typeid(*en));
+
+              en->tick({ *this, access::async });
+            }
 
             _ul.lock();
           }
 
-          m_queue.clear();
+          m_due_ids.clear();
         }
 
-        for (sl::index i = 0; i < m_dynamic_ids.size(); i++) {
-          _ul.unlock();
+        {
+          auto _p = profiler::scope(prof, profiler::adjust);
+          auto _r = read_scope(*this);
 
-          auto &en = m_entities[m_dynamic_ids[i]];
+          auto id = m_entities.next_live(0);
 
-          if (en->clock())
-            en->tick({ *this, access::async });
+          while (id != id_undefined) {
+            auto en = m_entities.get(id);
+            _ul.unlock();
+            en->adjust();
+            _ul.lock();
 
-          _ul.lock();
+            id = m_entities.next_live(id + 1);
+          }
         }
 
-        for (auto &e : m_entities) {
-          if (e)
-            e->adjust();
+        if (m_on_tick) {
+          auto fn = fn_tick { m_on_tick };
+          auto _r = read_scope(*this);
+          _ul.unlock();
+
+          fn({ *this, access::read_only });
+
+          _ul.lock();
         }
+
+        locked_unfreeze();
       }
 
     } else {
@@ -260,6 +262,11 @@ namespace laplace::engine {
     }
   }
 
+  void world::on_tick(fn_tick fn) {
+    auto _ul  = unique_lock(m_lock);
+    m_on_tick = std::move(fn);
+  }
+
   auto world::get_thread_count() -> sl::whole {
     if (check_scheduler()) {
       return m_scheduler->get_thread_count();
@@ -273,6 +280,10 @@ namespace laplace::engine {
   }
 
   auto world::get_root() -> sl::index {
+    if (m_reader == this) {
+      return m_root;
+    }
+
     auto _sl = shared_lock(m_lock);
     return m_root;
   }
@@ -292,14 +303,39 @@ namespace laplace::engine {
     return m_rand;
   }
 
+  auto world::get_profiler() -> profiler & {
+    return m_profiler;
+  }
+
   auto world::get_entity(sl::index id) -> ptr_entity {
+    if (m_reader == this) {
+      return m_entities.get(id);
+    }
+
     auto _sl = shared_lock(m_lock);
+    return m_entities.get(id);
+  }
 
-    if (id < 0 || id >= m_entities.size()) {
-      return {};
+  auto world::has_entity(sl::index id) -> bool {
+    if (m_reader == this) {
+      return m_entities.contains(id);
+    }
+
+    auto _sl = shared_lock(m_lock);
+    return m_entities.contains(id);
+  }
+
+  void world::reclock(sl::index id) {
+    auto _ul = unique_lock(m_lock);
+
+    if (id >= 0 && id < m_due.size() && m_due[id] != due_static) {
+      locked_schedule(id, locked_due_of(*m_entities.get(id)));
     }
+  }
 
-    return m_entities[id];
+  auto world::get_tick() -> uint64_t {
+    auto _sl = shared_lock(m_lock);
+    return m_tick;
   }
 
   void world::desync() {
@@ -317,24 +353,249 @@ namespace laplace::engine {
     return m_scheduler ? true : false;
   }
 
+  auto world::locked_spawn(ptr_entity ent,
+                           sl::index  id,
+                           bool       is_relaxed) -> sl::index {
+    if (!ent) {
+      error_("Unable to spawn null entity.", __FUNCTION__);
+      return id_undefined;
+    }
+
+    if (id == id_undefined) {
+      id = m_entities.next_free();
+    }
+
+    if (id >= m_due.size()) {
+      m_due.resize(id + 1, due_static);
+    }
+
+    if (auto en = m_entities.get(id); en) {
+      if (!is_relaxed) {
+        error_("Id is not free.", __FUNCTION__);
+        locked_desync();
+
+        return id_undefined;
+      }
+
+      if (en->is_dynamic()) {
+        locked_erase_dynamic(id);
+      }
+
+      en->reset_world();
+    }
+
+    m_entities.set(id, ent);
+
+    ent->set_id(id);
+    ent->set_world(shared_from_this());
+
+    if (ent->is_dynamic()) {
+      locked_add_dynamic(id);
+    }
+
+    return id;
+  }
+
+  void world::locked_remove(sl::index id) {
+    if (id < m_entities.get_size()) {
+      if (auto en = m_entities.get(id); en) {
+        if (en->is_dynamic()) {
+          locked_erase_dynamic(id);
+        }
+
+        en->reset_world();
+        m_entities.set(id, {});
+      } else {
+        if (m_allow_relaxed_spawn) {
+          error_("No entity.", __FUNCTION__);
+          locked_desync();
+        }
+      }
+    } else {
+      error_("Invalid entity id.", __FUNCTION__);
+      locked_desync();
+    }
+  }
+
+  void world::locked_clear() {
+    auto id = m_entities.next_live(0);
+
+    while (id != id_undefined) {
+      m_entities.get(id)->reset_world();
+      id = m_entities.next_live(id + 1);
+    }
+
+    m_entities.clear();
+    m_due.clear();
+    m_due_ids.clear();
+
+    for (auto &slot : m_wheel) { slot.clear(); }
+
+    m_root   = id_undefined;
+    m_desync = false;
+  }
+
+  auto world::locked_defer(deferred_op::kind what,
+                           ptr_entity        ent,
+                           sl::index         id) -> sl::index {
+    const auto is_spawn = what == deferred_op::spawn ||
+                          what == deferred_op::emplace;
+
+    if (is_spawn && !ent) {
+      error_("Unable to spawn null entity.", __FUNCTION__);
+      return id_undefined;
+    }
+
+    auto is_reserved = [this](sl::index n) {
+      return n < m_reserved.size() && m_reserved[n];
+    };
+
+    if (is_spawn && id == id_undefined) {
+      /*  Skip the ids taken by the deferred spawns. The table
+       *  does not change while frozen, so the search goes on
+       *  from the last deferred id.
+       */
+      id = m_entities.next_free(m_reserve_next);
+
+      while (is_reserved(id)) { id = m_entities.next_free(id + 1); }
+
+      m_reserve_next = id + 1;
+    }
+
+    if (is_spawn && id >= 0) {
+      if (id >= m_reserved.size()) {
+        m_reserved.resize(id + 1);
+      }
+
+      m_reserved[id] = true;
+    }
+
+    m_deferred.emplace_back(
+        deferred_op { .what = what, .id = id, .ent = ent });
+
+    return id;
+  }
+
+  void world::locked_freeze() {
+    m_is_frozen = true;
+  }
+
+  void world::locked_unfreeze() {
+    m_is_frozen = false;
+
+    /*  Swap the queues, so both keep the capacity.
+     */
+    std::swap(m_deferred, m_applying);
+
+    for (auto &op : m_applying) {
+      if (op.id >= 0 && op.id < m_reserved.size()) {
+        m_reserved[op.id] = false;
+      }
+    }
+
+    m_reserve_next = 0;
+
+    for (auto &op : m_applying) {
+      switch (op.what) {
+        case deferred_op::spawn:
+          locked_spawn(op.ent, op.id, m_allow_relaxed_spawn);
+          break;
+        case deferred_op::emplace:
+          locked_spawn(op.ent, op.id, true);
+          break;
+        case deferred_op::remove: locked_remove(op.id); break;
+        case deferred_op::clear: locked_clear(); break;
+      }
+    }
+
+    m_applying.clear();
+  }
+
   void world::locked_desync() {
     m_desync = true;
     verb(" :: DESYNC");
   }
 
   void world::locked_add_dynamic(sl::index id) {
-    auto it = lower_bound(m_dynamic_ids.begin(), m_dynamic_ids.end(),
-                          id);
-
-    m_dynamic_ids.emplace(it, id);
+    locked_schedule(id, locked_due_of(*m_entities.get(id)));
   }
 
   void world::locked_erase_dynamic(sl::index id) {
-    auto it = lower_bound(m_dynamic_ids.begin(), m_dynamic_ids.end(),
-                          id);
+    if (id < 0 || id >= m_due.size() || m_due[id] == due_static) {
+      return;
+    }
+
+    /*  Write back the clock so the Entity will continue from
+     *  the same state if it becomes dynamic again.
+     */
+    m_entities.get(id)->store_clock(
+        m_due[id] == due_never ? time_undefined : m_due[id] - m_tick);
+
+    m_due[id] = due_static;
+  }
+
+  auto world::locked_due_of(basic_entity &en) -> uint64_t {
+    const auto clock  = en.get_clock();
+    const auto period = en.get_tick_period();
+
+    if (clock == 0) {
+      return m_tick;
+    }
 
-    if (it != m_dynamic_ids.end() && *it == id) {
-      m_dynamic_ids.erase(it);
+    if (period == 0 || clock >= due_never - m_tick) {
+      return due_never;
+    }
+
+    return m_tick + clock;
+  }
+
+  void world::locked_schedule(sl::index id, uint64_t due) {
+    m_due[id] = due;
+
+    if (due != due_never) {
+      m_wheel[due % wheel_size].emplace_back(wheel_entry { due, id });
+    }
+  }
+
+  void world::locked_collect_due() {
+    /*  Entries that don't match the current due tick of
+     *  the Entity are outdated and will be dropped.
+     */
+
+    const auto now  = m_tick;
+    auto      &slot = m_wheel[now % wheel_size];
+
+    m_due_ids.clear();
+
+    sl::index n = 0;
+
+    for (auto &e : slot) {
+      if (m_due[e.id] != e.due) {
+        continue;
+      }
+
+      if (e.due == now) {
+        m_due_ids.emplace_back(e.id);
+      } else {
+        slot[n++] = e;
+      }
+    }
+
+    slot.resize(n);
+
+    sort(m_due_ids.begin(), m_due_ids.end());
+
+    m_due_ids.erase(unique(m_due_ids.begin(), m_due_ids.end()),
+                    m_due_ids.end());
+
+    m_tick++;
+
+    for (auto id : m_due_ids) {
+      const auto period = m_entities.get(id)->get_tick_period();
+
+      locked_schedule(id, period > 0 && period < due_never - now
+                              ? now + period
+                              : due_never);
     }
   }
 
@@ -384,24 +645,50 @@ namespace laplace::engine {
     return m_index < m_queue.size() ? m_queue[m_index++] : ptr_impact();
   }
 
+  void world::reset_due() {
+    auto _ul       = unique_lock(m_lock);
+    m_is_due_ready = false;
+    m_due_ids.clear();
+  }
+
   auto world::next_dynamic_entity() -> ptr_entity {
     auto _ul = unique_lock(m_lock);
 
-    return m_index < m_dynamic_ids.size()
-               ? m_entities[m_dynamic_ids[m_index++]]
+    if (!m_is_due_ready) {
+      locked_collect_due();
+      m_is_due_ready = true;
+    }
+
+    return m_index < m_due_ids.size()
+               ? m_entities.get(m_due_ids[m_index++])
                : ptr_entity();
   }
 
   auto world::next_entity() -> ptr_entity {
     auto _ul = unique_lock(m_lock);
 
-    while (m_index < m_entities.size()) {
-      auto &en = m_entities[m_index++];
+    const auto id = m_entities.next_live(m_index);
+
+    if (id == id_undefined) {
+      m_index = m_entities.get_size();
+      return {};
+    }
+
+    m_index = id + 1;
+    return m_entities.get(id);
+  }
 
-      if (en)
-        return en;
+  void world::notify_tick() {
+    auto _sl = shared_lock(m_lock);
+
+    if (!m_on_tick) {
+      return;
     }
 
-    return {};
+    auto fn = fn_tick { m_on_tick };
+    _sl.unlock();
+
+    auto _r = read_scope(*this);
+    fn({ *this, access::read_only });
   }
 }
@@ -0,0 +1,97 @@
+/*  laplace/engine/entity_table.h
+ *
+ *      Paged Entity storage. Pages are allocated on demand
+ *      and each one keeps an occupancy bitmap, so lookups,
+ *      insertions and removals are constant-time and the
+ *      iteration skips empty ranges word by word.
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#ifndef laplace_engine_entity_table_h
+#define laplace_engine_entity_table_h
+
+#include "basic_entity.predef.h"
+#include "defs.h"
+#include <array>
+
+namespace laplace::engine {
+  /*  Not thread-safe, the World guards it with its own lock.
+   */
+  class entity_table {
+  public:
+    static constexpr sl::whole page_size = 0x100;
+    static constexpr sl::whole word_bits = 64;
+
+    entity_table(const entity_table &) = delete;
+    auto operator=(const entity_table &) -> entity_table & = delete;
+
+    entity_table()  = default;
+    ~entity_table() = default;
+
+    /*  Put the Entity to the slot. Null Entity frees the slot.
+     */
+    void set(sl::index id, ptr_entity en);
+    void clear() noexcept;
+
+    /*  Returns null if the slot is free or out of range.
+     */
+    [[nodiscard]] auto get(sl::index id) const noexcept -> ptr_entity;
+
+    [[nodiscard]] auto contains(sl::index id) const noexcept -> bool;
+
+    /*  Upper bound of all the ids stored since the last
+     *  clear.
+     */
+    [[nodiscard]] auto get_size() const noexcept -> sl::whole;
+
+    /*  Live Entity count.
+     */
+    [[nodiscard]] auto get_count() const noexcept -> sl::whole;
+
+    /*  The lowest free id that is not less than the specified
+     *  one. Ids are assigned in the same order on each
+     *  machine.
+     */
+    [[nodiscard]] auto next_free(sl::index id = 0) const noexcept
+        -> sl::index;
+
+    /*  The lowest live id that is not less than the specified
+     *  one, or id_undefined.
+     */
+    [[nodiscard]] auto next_live(sl::index id) const noexcept
+        -> sl::index;
+
+  private:
+    static constexpr sl::whole page_words = page_size / word_bits;
+
+    struct page {
+      std::array<ptr_entity, page_size> entities;
+      std::array<uint64_t, page_words>  occupancy = {};
+      sl::whole                         count     = 0;
+    };
+
+    static void set_bit(sl::vector<uint64_t> &bits,
+                        sl::index             n,
+                        bool                  value);
+
+    sl::vector<std::unique_ptr<page>> m_pages;
+
+    /*  One bit per page.
+     */
+    sl::vector<uint64_t> m_full;
+    sl::vector<uint64_t> m_live;
+
+    sl::whole m_size  = 0;
+    sl::whole m_count = 0;
+  };
+}
+
+#endif
@@ -0,0 +1,70 @@
+/*  laplace/engine/eval/batch.h
+ *
+ *      Batch geometry tests. One query is tested against many
+ *      boxes stored as structure of arrays. The results are
+ *      bit-exact with the scalar functions.
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#ifndef laplace_engine_eval_batch_h
+#define laplace_engine_eval_batch_h
+
+#include "geometry.h"
+#include <span>
+
+namespace laplace::engine::eval {
+  struct box_soa {
+    std::vector<intval> min_x;
+    std::vector<intval> min_y;
+    std::vector<intval> min_z;
+    std::vector<intval> max_x;
+    std::vector<intval> max_y;
+    std::vector<intval> max_z;
+  };
+
+  /*  Bit i % 64 of word i / 64 is set if the test
+   *  passes for the box i.
+   */
+  using bitmask = std::vector<uint64_t>;
+
+  using ref_box_soa  = box_soa &;
+  using cref_box_soa = const box_soa &;
+  using cref_bitmask = const bitmask &;
+
+  auto soa_of(std::span<const box> v) -> box_soa;
+
+  void append(ref_box_soa a, cref_box b);
+
+  [[nodiscard]] auto size_of(cref_box_soa a) -> sl::whole;
+  [[nodiscard]] auto box_of(cref_box_soa a, sl::index i) -> box;
+  [[nodiscard]] auto is_set(cref_bitmask a, sl::index i) -> bool;
+
+  /*  Same as contains(box, point) for each box.
+   */
+  auto contains(cref_box_soa a, cref_vec3i point) -> bitmask;
+
+  /*  Same as intersects(box, box) for each box.
+   */
+  auto intersects(cref_box a, cref_box_soa b) -> bitmask;
+
+  /*  Same as intersects(box, sphere) for each box. Boxes
+   *  are rejected by bounds in batch, the rest are tested
+   *  one by one.
+   */
+  auto intersects(cref_sphere a, cref_box_soa b) -> bitmask;
+
+  /*  Same as intersects(ray, box) for each box. Ray tests
+   *  use integer square root, so there is no vector path.
+   */
+  auto intersects(cref_ray a, cref_box_soa b) -> bitmask;
+}
+
+#endif
@@ -0,0 +1,71 @@
+/*  laplace/engine/eval/bvh.h
+ *
+ *      Flat bounding volume hierarchy of triangles. Nodes are
+ *      stored in depth-first order in a contiguous array, the
+ *      left child of an inner node is the next node.
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#ifndef laplace_engine_eval_bvh_h
+#define laplace_engine_eval_bvh_h
+
+#include "geometry.h"
+
+namespace laplace::engine::eval {
+  struct bvh_node {
+    box bounds;
+
+    /*  Leaf node: index of the first triangle.
+     *  Inner node: index of the right child.
+     */
+    sl::index offset = 0;
+
+    /*  Leaf node: triangle count.
+     *  Inner node: zero.
+     */
+    sl::whole count = 0;
+  };
+
+  struct bvh {
+    static constexpr sl::whole leaf_size = 4;
+
+    std::vector<bvh_node> nodes;
+    std::vector<triangle> triangles;
+  };
+
+  using ref_bvh  = bvh &;
+  using cref_bvh = const bvh &;
+
+  /*  Build the hierarchy. Triangles are reordered, so the
+   *  triangles of each leaf are adjacent.
+   */
+  auto bvh_of(cref_vtriangle v) -> bvh;
+
+  auto is_empty(cref_bvh a) -> bool;
+  auto bounds_of(cref_bvh a) -> box;
+
+  auto contains(cref_bvh a, cref_vec3i point) -> bool;
+
+  auto intersects(cref_box a, cref_bvh b) -> bool;
+  auto intersects(cref_cylinder a, cref_bvh b) -> bool;
+  auto intersects(cref_sphere a, cref_bvh b) -> bool;
+  auto intersects(cref_triangle a, cref_bvh b) -> bool;
+  auto intersects(cref_octree a, cref_bvh b) -> bool;
+  auto intersects(cref_bvh a, cref_bvh b) -> bool;
+  auto intersects(cref_ray a, cref_bvh b) -> bool;
+
+  /*  Nearest hit. Children are visited front to back and
+   *  nodes farther than the current hit are skipped.
+   */
+  auto intersection(cref_ray a, cref_bvh b) -> intval;
+}
+
+#endif
@@ -0,0 +1,107 @@
+/*  laplace/engine/eval/dstar.h
+ *
+ *      D* Lite incremental path search. The search goes from
+ *      the destination to the source, so the source may move
+ *      and the edge costs may change without a full restart.
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#ifndef laplace_engine_eval_dstar_h
+#define laplace_engine_eval_dstar_h
+
+#include "astar.h"
+#include <unordered_map>
+
+namespace laplace::engine::eval::dstar {
+  using astar::status, astar::link, astar::fn_neighbors,
+      astar::fn_heuristic;
+
+  static constexpr sl::index _invalid_index = -1;
+
+  /*  Neighbors should be symmetric. If the cost of an edge is
+   *  changed, both of the nodes should be updated.
+   */
+
+  struct _key {
+    intval estimated = infinity;
+    intval length    = infinity;
+  };
+
+  struct _node {
+    /*  Length from current node to destination.
+     */
+    intval length = infinity;
+
+    /*  One-step lookahead length.
+     */
+    intval lookahead = infinity;
+
+    _key key;
+    bool is_open = false;
+  };
+
+  struct _open_entry {
+    _key      key;
+    sl::index index = _invalid_index;
+  };
+
+  struct _state {
+    sl::index source      = _invalid_index;
+    sl::index destination = _invalid_index;
+    sl::index last        = _invalid_index;
+
+    /*  Key modifier. Accumulates the heuristic distances the
+     *  source moved by.
+     */
+    intval modifier = {};
+
+    std::unordered_map<sl::index, _node> nodes;
+
+    /*  Binary heap. Outdated entries are skipped.
+     */
+    sl::vector<_open_entry> open;
+  };
+
+  [[nodiscard]] auto init(
+      const fn_heuristic heuristic,
+      const sl::index    source,
+      const sl::index    destination) noexcept -> _state;
+
+  /*  Expand one node. Returns success if the path from the
+   *  source is consistent.
+   */
+  [[nodiscard]] auto loop(
+      const fn_neighbors neighbors,
+      const fn_heuristic heuristic,
+      _state            &state) noexcept -> status;
+
+  /*  Update the nodes with changed edge costs.
+   */
+  void update(
+      const fn_neighbors               neighbors,
+      const fn_heuristic               heuristic,
+      _state                          &state,
+      const std::span<const sl::index> nodes) noexcept;
+
+  void move(
+      const fn_heuristic heuristic,
+      _state            &state,
+      const sl::index    source) noexcept;
+
+  /*  Returns the path from the source to the destination, or
+   *  an empty path if there is no consistent one.
+   */
+  [[nodiscard]] auto finish(
+      const fn_neighbors neighbors,
+      const _state      &state) noexcept -> sl::vector<sl::index>;
+}
+
+#endif
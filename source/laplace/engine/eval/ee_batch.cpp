@@ -0,0 +1,283 @@
+/*  laplace/engine/eval/ee_batch.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "batch.h"
+
+#include <bit>
+
+#if !defined(LAPLACE_NO_SIMD) && \
+    (defined(__x86_64__) || defined(_M_X64))
+#  define LAPLACE_EVAL_X64
+#  include <immintrin.h>
+#  ifdef _MSC_VER
+#    include <intrin.h>
+#  endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#  define LAPLACE_TARGET(x) __attribute__((target(x)))
+#else
+#  define LAPLACE_TARGET(x)
+#endif
+
+namespace laplace::engine::eval {
+  using std::span;
+
+  enum simd_level { simd_none, simd_sse42, simd_avx2 };
+
+  /*  Bounds and query planes for the overlap kernels.
+   *
+   *  Bit i is set if for each axis k
+   *      min[k][i] < hi[k] && max[k][i] > lo[k]
+   */
+  struct overlap_args {
+    const intval *min[3];
+    const intval *max[3];
+    intval        lo[3];
+    intval        hi[3];
+  };
+
+  static auto detect() -> simd_level {
+#ifdef LAPLACE_EVAL_X64
+#  ifdef _MSC_VER
+    int info[4] = {};
+
+    __cpuid(info, 1);
+
+    const bool has_sse42 = (info[2] & (1 << 20)) != 0;
+    const bool has_xsave = (info[2] & (1 << 27)) != 0;
+    const bool has_avx   = (info[2] & (1 << 28)) != 0;
+
+    if (has_xsave && has_avx && (_xgetbv(0) & 6) == 6) {
+      __cpuidex(info, 7, 0);
+
+      if ((info[1] & (1 << 5)) != 0) {
+        return simd_avx2;
+      }
+    }
+
+    return has_sse42 ? simd_sse42 : simd_none;
+#  else
+    if (__builtin_cpu_supports("avx2")) {
+      return simd_avx2;
+    }
+
+    if (__builtin_cpu_supports("sse4.2")) {
+      return simd_sse42;
+    }
+#  endif
+#endif
+
+    return simd_none;
+  }
+
+  static auto get_simd_level() -> simd_level {
+    static const auto level = detect();
+    return level;
+  }
+
+  static void overlap_scalar(const overlap_args &a,
+                             sl::index           begin,
+                             sl::index           end,
+                             uint64_t           *mask) {
+    for (auto i = begin; i < end; i++) {
+      bool f = true;
+
+      for (size_t k = 0; k < 3; k++) {
+        f = f && a.min[k][i] < a.hi[k] && a.max[k][i] > a.lo[k];
+      }
+
+      if (f) {
+        mask[i / 64] |= uint64_t { 1 } << (i % 64);
+      }
+    }
+  }
+
+#ifdef LAPLACE_EVAL_X64
+  LAPLACE_TARGET("sse4.2")
+  static auto overlap_sse42(const overlap_args &a,
+                            sl::whole           size,
+                            uint64_t           *mask) -> sl::index {
+    sl::index i = 0;
+
+    for (; i + 2 <= size; i += 2) {
+      auto m = _mm_set1_epi64x(-1);
+
+      for (size_t k = 0; k < 3; k++) {
+        const auto v_min = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(a.min[k] + i));
+        const auto v_max = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(a.max[k] + i));
+
+        m = _mm_and_si128(
+            m, _mm_cmpgt_epi64(_mm_set1_epi64x(a.hi[k]), v_min));
+        m = _mm_and_si128(
+            m, _mm_cmpgt_epi64(v_max, _mm_set1_epi64x(a.lo[k])));
+      }
+
+      const auto bits = _mm_movemask_pd(_mm_castsi128_pd(m));
+      mask[i / 64] |= static_cast<uint64_t>(bits) << (i % 64);
+    }
+
+    return i;
+  }
+
+  LAPLACE_TARGET("avx2")
+  static auto overlap_avx2(const overlap_args &a,
+                           sl::whole           size,
+                           uint64_t           *mask) -> sl::index {
+    sl::index i = 0;
+
+    for (; i + 4 <= size; i += 4) {
+      auto m = _mm256_set1_epi64x(-1);
+
+      for (size_t k = 0; k < 3; k++) {
+        const auto v_min = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(a.min[k] + i));
+        const auto v_max = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(a.max[k] + i));
+
+        m = _mm256_and_si256(
+            m,
+            _mm256_cmpgt_epi64(_mm256_set1_epi64x(a.hi[k]), v_min));
+        m = _mm256_and_si256(
+            m,
+            _mm256_cmpgt_epi64(v_max, _mm256_set1_epi64x(a.lo[k])));
+      }
+
+      const auto bits = _mm256_movemask_pd(_mm256_castsi256_pd(m));
+      mask[i / 64] |= static_cast<uint64_t>(bits) << (i % 64);
+    }
+
+    return i;
+  }
+#endif
+
+  static auto overlap(cref_box_soa  b,
+                      const intval *lo,
+                      const intval *hi) -> bitmask {
+    const auto size = size_of(b);
+
+    auto mask = bitmask((size + 63) / 64);
+    auto args = overlap_args {
+      .min = { b.min_x.data(), b.min_y.data(), b.min_z.data() },
+      .max = { b.max_x.data(), b.max_y.data(), b.max_z.data() },
+      .lo  = { lo[0], lo[1], lo[2] },
+      .hi  = { hi[0], hi[1], hi[2] }
+    };
+
+    sl::index i = 0;
+
+#ifdef LAPLACE_EVAL_X64
+    if (const auto level = get_simd_level(); level == simd_avx2) {
+      i = overlap_avx2(args, size, mask.data());
+    } else if (level == simd_sse42) {
+      i = overlap_sse42(args, size, mask.data());
+    }
+#endif
+
+    overlap_scalar(args, i, size, mask.data());
+    return mask;
+  }
+
+  auto soa_of(span<const box> v) -> box_soa {
+    auto a = box_soa {};
+
+    a.min_x.reserve(v.size());
+    a.min_y.reserve(v.size());
+    a.min_z.reserve(v.size());
+    a.max_x.reserve(v.size());
+    a.max_y.reserve(v.size());
+    a.max_z.reserve(v.size());
+
+    for (auto &b : v) { append(a, b); }
+
+    return a;
+  }
+
+  void append(ref_box_soa a, cref_box b) {
+    a.min_x.emplace_back(b.min.x());
+    a.min_y.emplace_back(b.min.y());
+    a.min_z.emplace_back(b.min.z());
+    a.max_x.emplace_back(b.max.x());
+    a.max_y.emplace_back(b.max.y());
+    a.max_z.emplace_back(b.max.z());
+  }
+
+  auto size_of(cref_box_soa a) -> sl::whole {
+    return static_cast<sl::whole>(a.min_x.size());
+  }
+
+  auto box_of(cref_box_soa a, sl::index i) -> box {
+    return box { { a.min_x[i], a.min_y[i], a.min_z[i] },
+                 { a.max_x[i], a.max_y[i], a.max_z[i] } };
+  }
+
+  auto is_set(cref_bitmask a, sl::index i) -> bool {
+    return ((a[i / 64] >> (i % 64)) & 1) != 0;
+  }
+
+  auto contains(cref_box_soa a, cref_vec3i point) -> bitmask {
+    const intval lo[] = { point.x() - epsilon, point.y() - epsilon,
+                          point.z() - epsilon };
+    const intval hi[] = { point.x() + epsilon, point.y() + epsilon,
+                          point.z() + epsilon };
+
+    return overlap(a, lo, hi);
+  }
+
+  auto intersects(cref_box a, cref_box_soa b) -> bitmask {
+    const intval lo[] = { a.min.x() - epsilon, a.min.y() - epsilon,
+                          a.min.z() - epsilon };
+    const intval hi[] = { a.max.x() + epsilon, a.max.y() + epsilon,
+                          a.max.z() + epsilon };
+
+    return overlap(b, lo, hi);
+  }
+
+  auto intersects(cref_sphere a, cref_box_soa b) -> bitmask {
+    const auto r = a.radius + epsilon;
+
+    const intval lo[] = { a.center.x() - r, a.center.y() - r,
+                          a.center.z() - r };
+    const intval hi[] = { a.center.x() + r, a.center.y() + r,
+                          a.center.z() + r };
+
+    auto mask = overlap(b, lo, hi);
+
+    for (sl::index n = 0; n < mask.size(); n++) {
+      for (auto bits = mask[n]; bits != 0; bits &= bits - 1) {
+        const auto i = n * 64 + std::countr_zero(bits);
+
+        if (!intersects(box_of(b, i), a)) {
+          mask[n] &= ~(uint64_t { 1 } << (i % 64));
+        }
+      }
+    }
+
+    return mask;
+  }
+
+  auto intersects(cref_ray a, cref_box_soa b) -> bitmask {
+    const auto size = size_of(b);
+
+    auto mask = bitmask((size + 63) / 64);
+
+    for (sl::index i = 0; i < size; i++) {
+      if (intersects(a, box_of(b, i))) {
+        mask[i / 64] |= uint64_t { 1 } << (i % 64);
+      }
+    }
+
+    return mask;
+  }
+}
@@ -0,0 +1,380 @@
+/*  laplace/engine/eval/ee_bvh.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "bvh.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace laplace::engine::eval {
+  using std::min, std::max, std::swap, std::array, std::vector;
+
+  /*  Median split keeps the tree balanced, so the depth is
+   *  bounded by the index width.
+   */
+  static constexpr sl::whole stack_size = 64;
+
+  /*  Hit points are rounded, so node bounds are extended
+   *  for ray traversal.
+   */
+  static constexpr intval ray_margin = safe_delta;
+
+  static void build(ref_bvh              tree,
+                    cref_vtriangle       v,
+                    const vector<vec3i> &centers,
+                    vector<sl::index>   &indices,
+                    sl::index            begin,
+                    sl::index            end) {
+    const auto n = static_cast<sl::index>(tree.nodes.size());
+    tree.nodes.emplace_back();
+
+    auto bounds        = box {};
+    auto center_bounds = box {};
+
+    for (auto i = begin; i < end; i++) {
+      append(bounds, v[indices[i]]);
+      append(center_bounds, centers[indices[i]]);
+    }
+
+    tree.nodes[n].bounds = bounds;
+
+    if (end - begin <= bvh::leaf_size) {
+      std::sort(indices.begin() + begin, indices.begin() + end);
+
+      tree.nodes[n].offset = begin;
+      tree.nodes[n].count  = end - begin;
+      return;
+    }
+
+    size_t axis = 0;
+
+    for (size_t k = 1; k < 3; k++) {
+      if (center_bounds.max[k] - center_bounds.min[k] >
+          center_bounds.max[axis] - center_bounds.min[axis]) {
+        axis = k;
+      }
+    }
+
+    const auto mid = begin + (end - begin) / 2;
+
+    std::nth_element(indices.begin() + begin, indices.begin() + mid,
+                     indices.begin() + end,
+                     [&](sl::index a, sl::index b) {
+                       const auto x = centers[a][axis];
+                       const auto y = centers[b][axis];
+                       return x < y || (x == y && a < b);
+                     });
+
+    build(tree, v, centers, indices, begin, mid);
+    tree.nodes[n].offset = static_cast<sl::index>(tree.nodes.size());
+    build(tree, v, centers, indices, mid, end);
+  }
+
+  /*  Clip the ray by the box. Returns the distance to the
+   *  nearest point of the box along the ray, or a negative
+   *  value if there is no intersection.
+   */
+  static auto clip(cref_ray a, intval len, cref_box b) -> intval {
+    auto s0 = -safe_limit;
+    auto s1 = safe_limit;
+
+    for (size_t i = 0; i < 3; i++) {
+      const auto lo   = b.min[i] - ray_margin;
+      const auto hi   = b.max[i] + ray_margin;
+      const auto base = a.base[i];
+      const auto d    = a.direction[i];
+
+      if (d == 0) {
+        if (base < lo || base > hi) {
+          return -safe_limit;
+        }
+
+        continue;
+      }
+
+      auto t0 = ((lo - base) * len) / d;
+      auto t1 = ((hi - base) * len) / d;
+
+      if (t0 > t1) {
+        swap(t0, t1);
+      }
+
+      s0 = max(s0, t0 - epsilon);
+      s1 = min(s1, t1 + epsilon);
+
+      if (s0 > s1) {
+        return -safe_limit;
+      }
+    }
+
+    if (s1 < 0) {
+      return -safe_limit;
+    }
+
+    return max<intval>(s0, 0);
+  }
+
+  static auto overlaps(cref_box a, cref_sphere b) -> bool {
+    if (b.radius < 0) {
+      return false;
+    }
+
+    intval d = 0;
+
+    for (size_t i = 0; i < 3; i++) {
+      const auto x = b.center[i];
+      const auto e = x < a.min[i]   ? a.min[i] - x
+                     : x > a.max[i] ? x - a.max[i]
+                                    : intval {};
+      d += e * e;
+    }
+
+    return d - epsilon <= b.radius * b.radius;
+  }
+
+  template <typename overlaps_, typename test_>
+  static auto any_of(cref_bvh b, overlaps_ overlaps, test_ test)
+      -> bool {
+    auto stack = array<sl::index, stack_size> {};
+    auto top   = sl::whole {};
+
+    if (!b.nodes.empty()) {
+      stack[top++] = 0;
+    }
+
+    while (top > 0) {
+      const auto  n    = stack[--top];
+      const auto &node = b.nodes[n];
+
+      if (!overlaps(node.bounds)) {
+        continue;
+      }
+
+      if (node.count > 0) {
+        const auto end = node.offset + node.count;
+
+        for (auto i = node.offset; i < end; i++) {
+          if (test(b.triangles[i])) {
+            return true;
+          }
+        }
+      } else {
+        stack[top++] = node.offset;
+        stack[top++] = n + 1;
+      }
+    }
+
+    return false;
+  }
+
+  auto bvh_of(cref_vtriangle v) -> bvh {
+    auto tree = bvh {};
+
+    if (v.empty()) {
+      return tree;
+    }
+
+    auto centers = vector<vec3i>(v.size());
+    auto indices = vector<sl::index>(v.size());
+
+    for (size_t i = 0; i < v.size(); i++) {
+      centers[i] = center_of(v[i]);
+    }
+
+    std::iota(indices.begin(), indices.end(), sl::index {});
+
+    tree.nodes.reserve(2 * v.size() / bvh::leaf_size + 1);
+    build(tree, v, centers, indices, 0,
+          static_cast<sl::index>(v.size()));
+
+    tree.triangles.reserve(v.size());
+
+    for (auto i : indices) { tree.triangles.emplace_back(v[i]); }
+
+    return tree;
+  }
+
+  auto is_empty(cref_bvh a) -> bool {
+    return a.nodes.empty();
+  }
+
+  auto bounds_of(cref_bvh a) -> box {
+    return a.nodes.empty() ? box {} : a.nodes[0].bounds;
+  }
+
+  auto contains(cref_bvh a, cref_vec3i point) -> bool {
+    auto stack = array<sl::index, stack_size> {};
+    auto top   = sl::whole {};
+
+    if (!a.nodes.empty()) {
+      stack[top++] = 0;
+    }
+
+    while (top > 0) {
+      const auto  n    = stack[--top];
+      const auto &node = a.nodes[n];
+
+      if (!contains(node.bounds, point)) {
+        continue;
+      }
+
+      if (node.count > 0) {
+        const auto end = node.offset + node.count;
+
+        auto is_inside = true;
+
+        for (auto i = node.offset; i < end; i++) {
+          if (orientation(a.triangles[i], point) - epsilon >= 0) {
+            is_inside = false;
+            break;
+          }
+        }
+
+        if (is_inside) {
+          return true;
+        }
+      } else {
+        stack[top++] = node.offset;
+        stack[top++] = n + 1;
+      }
+    }
+
+    return false;
+  }
+
+  auto intersects(cref_box a, cref_bvh b) -> bool {
+    return any_of(
+        b, [&](cref_box bounds) { return intersects(a, bounds); },
+        [&](cref_triangle tr) { return intersects(a, tr); });
+  }
+
+  auto intersects(cref_cylinder a, cref_bvh b) -> bool {
+    const auto a_bounds = bounds_of(a);
+
+    return any_of(
+        b,
+        [&](cref_box bounds) { return intersects(a_bounds, bounds); },
+        [&](cref_triangle tr) { return intersects(a, tr); });
+  }
+
+  auto intersects(cref_sphere a, cref_bvh b) -> bool {
+    return any_of(
+        b, [&](cref_box bounds) { return overlaps(bounds, a); },
+        [&](cref_triangle tr) { return intersects(a, tr); });
+  }
+
+  auto intersects(cref_triangle a, cref_bvh b) -> bool {
+    const auto a_bounds = bounds_of(a);
+
+    return any_of(
+        b,
+        [&](cref_box bounds) { return intersects(a_bounds, bounds); },
+        [&](cref_triangle tr) { return intersects(a, tr); });
+  }
+
+  auto intersects(cref_octree a, cref_bvh b) -> bool {
+    return any_of(
+        b,
+        [&](cref_box bounds) { return intersects(a.bounds, bounds); },
+        [&](cref_triangle tr) { return intersects(tr, a); });
+  }
+
+  auto intersects(cref_bvh a, cref_bvh b) -> bool {
+    const auto b_bounds = bounds_of(b);
+
+    return any_of(
+        a,
+        [&](cref_box bounds) { return intersects(b_bounds, bounds); },
+        [&](cref_triangle tr) { return intersects(tr, b); });
+  }
+
+  auto intersects(cref_ray a, cref_bvh b) -> bool {
+    const auto len = length(a.direction);
+
+    if (len == 0) {
+      return false;
+    }
+
+    return any_of(
+        b, [&](cref_box bounds) { return clip(a, len, bounds) >= 0; },
+        [&](cref_triangle tr) { return intersects(a, tr); });
+  }
+
+  auto intersection(cref_ray a, cref_bvh b) -> intval {
+    const auto len = length(a.direction);
+
+    if (len == 0 || b.nodes.empty()) {
+      return -safe_limit;
+    }
+
+    struct entry {
+      sl::index node;
+      intval    near;
+    };
+
+    auto stack  = array<entry, stack_size> {};
+    auto top    = sl::whole {};
+    auto result = safe_limit;
+
+    if (auto near = clip(a, len, b.nodes[0].bounds); near >= 0) {
+      stack[top++] = { 0, near };
+    }
+
+    while (top > 0) {
+      const auto e = stack[--top];
+
+      if (e.near - ray_margin > result) {
+        continue;
+      }
+
+      const auto &node = b.nodes[e.node];
+
+      if (node.count > 0) {
+        const auto end = node.offset + node.count;
+
+        for (auto i = node.offset; i < end; i++) {
+          const auto t = intersection(a, b.triangles[i]);
+
+          if (t + epsilon >= 0 && t < result) {
+            result = t;
+          }
+        }
+
+        continue;
+      }
+
+      auto left  = entry { e.node + 1, {} };
+      auto right = entry { node.offset, {} };
+
+      left.near  = clip(a, len, b.nodes[left.node].bounds);
+      right.near = clip(a, len, b.nodes[right.node].bounds);
+
+      if (left.near >= 0 && right.near >= 0 &&
+          left.near < right.near) {
+        swap(left, right);
+      }
+
+      /*  The nearest child is on top of the stack.
+       */
+
+      if (left.near >= 0) {
+        stack[top++] = left;
+      }
+
+      if (right.near >= 0) {
+        stack[top++] = right;
+      }
+    }
+
+    return result < infinity ? result : -safe_limit;
+  }
+}
@@ -0,0 +1,293 @@
+/*  laplace/engine/eval/ee_dstar.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "dstar.h"
+
+#include <algorithm>
+
+namespace laplace::engine::eval::dstar {
+  using std::min, std::span, std::push_heap, std::pop_heap;
+
+  static auto add(const intval a, const intval b) -> intval {
+    return min(a + b, infinity);
+  }
+
+  static auto less(const _key &a, const _key &b) -> bool {
+    return a.estimated < b.estimated ||
+           (a.estimated == b.estimated && a.length < b.length);
+  }
+
+  /*  The top of the heap is the least key. Equal keys are
+   *  ordered by the node index, so the expansion order does
+   *  not depend on the order of the updates.
+   */
+  static auto heap_order(const _open_entry &a, const _open_entry &b)
+      -> bool {
+    if (less(b.key, a.key)) {
+      return true;
+    }
+
+    if (less(a.key, b.key)) {
+      return false;
+    }
+
+    return a.index > b.index;
+  }
+
+  static auto length_of(const _state &s, const sl::index n)
+      -> intval {
+    const auto i = s.nodes.find(n);
+    return i != s.nodes.end() ? i->second.length : infinity;
+  }
+
+  static auto key_of(const fn_heuristic &heuristic,
+                     const _state       &s,
+                     const sl::index     n,
+                     const _node        &x) -> _key {
+    const auto k = min(x.length, x.lookahead);
+
+    if (k >= infinity) {
+      return {};
+    }
+
+    return { .estimated = add(k, heuristic(s.source, n) +
+                                     s.modifier),
+             .length    = k };
+  }
+
+  static void push(_state &s, const sl::index n, _node &x,
+                   const _key &key) {
+    x.key     = key;
+    x.is_open = true;
+
+    s.open.emplace_back(_open_entry { .key = key, .index = n });
+    push_heap(s.open.begin(), s.open.end(), heap_order);
+  }
+
+  /*  Skip outdated entries on top of the heap.
+   */
+  static auto top(_state &s) -> const _open_entry * {
+    while (!s.open.empty()) {
+      const auto &e = s.open.front();
+      const auto  i = s.nodes.find(e.index);
+
+      if (i != s.nodes.end() && i->second.is_open &&
+          !less(e.key, i->second.key) &&
+          !less(i->second.key, e.key)) {
+        return &e;
+      }
+
+      pop_heap(s.open.begin(), s.open.end(), heap_order);
+      s.open.pop_back();
+    }
+
+    return nullptr;
+  }
+
+  static void update_node(const fn_neighbors &neighbors,
+                          const fn_heuristic &heuristic,
+                          _state             &s,
+                          const sl::index     n) {
+    if (n != s.destination) {
+      auto lookahead = infinity;
+
+      for (sl::index k = 0;; k++) {
+        const auto l = neighbors(n, k);
+
+        if (l.node == link::skip) {
+          continue;
+        }
+
+        if (l.node == link::invalid) {
+          break;
+        }
+
+        lookahead = min(lookahead,
+                        add(l.distance, length_of(s, l.node)));
+      }
+
+      if (lookahead >= infinity && s.nodes.find(n) == s.nodes.end()) {
+        return;
+      }
+
+      s.nodes[n].lookahead = lookahead;
+    }
+
+    auto &x = s.nodes[n];
+
+    x.is_open = false;
+
+    if (x.length != x.lookahead) {
+      push(s, n, x, key_of(heuristic, s, n, x));
+    }
+  }
+
+  static void update_neighbors(const fn_neighbors &neighbors,
+                               const fn_heuristic &heuristic,
+                               _state             &s,
+                               const sl::index     n) {
+    for (sl::index k = 0;; k++) {
+      const auto l = neighbors(n, k);
+
+      if (l.node == link::skip) {
+        continue;
+      }
+
+      if (l.node == link::invalid) {
+        break;
+      }
+
+      update_node(neighbors, heuristic, s, l.node);
+    }
+  }
+
+  auto init(const fn_heuristic heuristic,
+            const sl::index    source,
+            const sl::index    destination) noexcept -> _state {
+    auto s = _state {};
+
+    s.source      = source;
+    s.destination = destination;
+    s.last        = source;
+
+    auto &x = s.nodes[destination];
+
+    x.lookahead = 0;
+
+    push(s, destination, x, key_of(heuristic, s, destination, x));
+
+    return s;
+  }
+
+  auto loop(const fn_neighbors neighbors,
+            const fn_heuristic heuristic,
+            _state            &state) noexcept -> status {
+
+    const auto *e = top(state);
+
+    const auto i = state.nodes.find(state.source);
+
+    const auto source = i != state.nodes.end() ? i->second
+                                                : _node {};
+
+    const auto source_key = key_of(heuristic, state, state.source,
+                                   source);
+
+    if ((e == nullptr || !less(e->key, source_key)) &&
+        source.length == source.lookahead) {
+      return source.length < infinity ? status::success
+                                      : status::failed;
+    }
+
+    const auto key = e->key;
+    const auto n   = e->index;
+
+    pop_heap(state.open.begin(), state.open.end(), heap_order);
+    state.open.pop_back();
+
+    auto &x = state.nodes[n];
+
+    if (const auto key_new = key_of(heuristic, state, n, x);
+        less(key, key_new)) {
+      push(state, n, x, key_new);
+      return status::progress;
+    }
+
+    x.is_open = false;
+
+    if (x.length > x.lookahead) {
+      x.length = x.lookahead;
+    } else {
+      x.length = infinity;
+      update_node(neighbors, heuristic, state, n);
+    }
+
+    update_neighbors(neighbors, heuristic, state, n);
+
+    return status::progress;
+  }
+
+  void update(const fn_neighbors               neighbors,
+              const fn_heuristic               heuristic,
+              _state                          &state,
+              const std::span<const sl::index> nodes) noexcept {
+    for (const auto n : nodes) {
+      update_node(neighbors, heuristic, state, n);
+    }
+  }
+
+  void move(const fn_heuristic heuristic,
+            _state            &state,
+            const sl::index    source) noexcept {
+    if (source == state.source) {
+      return;
+    }
+
+    /*  Keys in the heap stay lower bounds, because the sum of
+     *  the distances is not less than the heuristic.
+     */
+    state.modifier = add(state.modifier,
+                         heuristic(state.last, source));
+    state.last     = source;
+    state.source   = source;
+  }
+
+  auto finish(const fn_neighbors neighbors,
+              const _state      &state) noexcept
+      -> sl::vector<sl::index> {
+
+    auto path    = sl::vector<sl::index> {};
+    auto current = state.source;
+
+    if (length_of(state, current) >= infinity) {
+      return {};
+    }
+
+    path.emplace_back(current);
+
+    for (sl::index i = 0; i <= state.nodes.size(); i++) {
+      if (current == state.destination) {
+        return path;
+      }
+
+      auto next   = _invalid_index;
+      auto length = infinity;
+
+      for (sl::index k = 0;; k++) {
+        const auto l = neighbors(current, k);
+
+        if (l.node == link::skip) {
+          continue;
+        }
+
+        if (l.node == link::invalid) {
+          break;
+        }
+
+        if (const auto x = add(l.distance, length_of(state, l.node));
+            x < length) {
+          next   = l.node;
+          length = x;
+        }
+      }
+
+      if (next == _invalid_index) {
+        return {};
+      }
+
+      current = next;
+      path.emplace_back(current);
+    }
+
+    return {};
+  }
+}
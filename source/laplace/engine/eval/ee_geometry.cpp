@@ -766,9 +766,12 @@ namespace laplace::engine::eval {
                   intersection(a, plane_of(b, 5)));
 
     auto t = max(t0, max(t1, t2));
-    auto p = point_of(a, t);
 
-    return contains(b, p);
+    if (t < 0) {
+      return false;
+    }
+
+    return contains(b, point_of(a, t));
   }
 
   auto intersects(cref_ray ra, cref_cylinder cyl) -> bool {
@@ -828,14 +831,23 @@ namespace laplace::engine::eval {
   auto intersection(cref_ray a, cref_plane b) -> intval {
     const auto r     = b.base - a.base;
     const auto r_cos = math::dot(r, b.normal);
-    const auto n     = r_cos < 0 ? b.normal : -b.normal;
-    const auto k     = length(n * math::dot(n, a.direction));
+    const auto v_cos = math::dot(a.direction, b.normal);
 
-    if (k != 0) {
-      const auto h = length(n * r_cos);
-      const auto d = length(a.direction);
+    if ((r_cos < 0 && v_cos > 0) || (r_cos > 0 && v_cos < 0)) {
+      /*  The plane is behind the ray base.
+       */
+      return -safe_limit;
+    }
 
-      return (h * d + k / 2ll) / k;
+    if (v_cos != 0) {
+      /*  Distance along the ray is
+       *      |r . n| |v| / |v . n|
+       */
+
+      const auto h = abs(r_cos) * length(a.direction);
+      const auto k = abs(v_cos);
+
+      return (h + k / 2ll) / k;
     }
 
     return -safe_limit;
@@ -891,9 +903,12 @@ namespace laplace::engine::eval {
                   intersection(a, plane_of(b, 5)));
 
     auto t = max(t0, max(t1, t2));
-    auto p = point_of(a, t);
 
-    return contains(b, p) ? t : -safe_limit;
+    if (t < 0) {
+      return -safe_limit;
+    }
+
+    return contains(b, point_of(a, t)) ? t : -safe_limit;
   }
 
   /*  Minimal nonnegative equation root, or nearest to
@@ -16,57 +16,8 @@
 #include "integral.h"
 
 namespace laplace::engine::eval::grid {
-  using std::span, std::min, std::max, std::function, astar::link;
-
-  void merge(const vec2z              size,
-             const span<int8_t>       dst,
-             const span<const int8_t> src,
-             const op                 merge_op) noexcept {
-
-    const auto count = size.x() * size.y();
-
-    if (count > dst.size()) {
-      error_("Invalid destination size.", __FUNCTION__);
-      return;
-    }
-
-    if (count > src.size()) {
-      error_("Invalid source size.", __FUNCTION__);
-      return;
-    }
-
-    for (sl::index i = 0; i < count; i++) {
-      dst[i] = merge_op(dst[i], src[i]);
-    }
-  }
-
-  void merge(const vec2z              dst_size,
-             const span<int8_t>       dst,
-             const vec2z              src_size,
-             const vec2i              src_offset,
-             const span<const int8_t> src,
-             const op                 merge_op) noexcept {
-
-    if (dst_size.x() * dst_size.y() > dst.size()) {
-      error_("Invalid destination size.", __FUNCTION__);
-      return;
-    }
-
-    if (src_size.x() * src_size.y() > src.size()) {
-      error_("Invalid source size.", __FUNCTION__);
-      return;
-    }
-
-    for (sl::index y = 0; y < src_size.y(); y++) {
-      for (sl::index x = 0; x < src_size.x(); x++) {
-
-        const auto n = (src_offset.y() + y) * dst_size.x() +
-                       (src_offset.x() + x);
-
-        dst[n] = merge_op(dst[n], src[y * src_size.x() + x]);
-      }
-    }
-  }
+  using std::span, std::min, std::max, std::function, astar::link,
+      std::sort, std::unique;
 
   [[nodiscard]] auto trace_line(
       const vec2z    size,
@@ -455,6 +406,115 @@ namespace laplace::engine::eval::grid {
     return path;
   }
 
+  auto replan_init(const vec2z              size,
+                   const intval             scale,
+                   const span<const int8_t> map,
+                   const fn_available       available,
+                   const vec2z              source,
+                   const vec2z              destination) noexcept
+      -> _replan_state {
+
+    if (size.x() * size.y() > map.size()) {
+      error_("Invalid map size.", __FUNCTION__);
+      return {};
+    }
+
+    if (size.x() <= 0 || size.y() <= 0) {
+      return {};
+    }
+
+    const auto width = size.x();
+
+    auto s = _replan_state {};
+
+    s.size = size;
+
+    s.heuristic = [width, scale](const sl::index a, const sl::index b)
+        -> intval { return diagonal(width, scale, a, b); };
+
+    s.neighbors = [width, scale, map, available](
+                      const sl::index p, const sl::index n) -> link {
+      return neighbors8(width, scale, map, available, p, n);
+    };
+
+    s.dstar = dstar::init(s.heuristic,
+                          source.y() * width + source.x(),
+                          destination.y() * width + destination.x());
+
+    return s;
+  }
+
+  auto replan_loop(_replan_state &state) noexcept -> astar::status {
+    if (state.size.x() <= 0) {
+      return astar::status::failed;
+    }
+
+    return dstar::loop(state.neighbors, state.heuristic, state.dstar);
+  }
+
+  void replan_update(_replan_state           &state,
+                     const span<const vec2z> cells) noexcept {
+    const auto width  = state.size.x();
+    const auto height = state.size.y();
+
+    if (width <= 0) {
+      return;
+    }
+
+    /*  Update the changed cells and their neighbors in the
+     *  index order.
+     */
+
+    auto v = sl::vector<sl::index> {};
+    v.reserve(cells.size() * 9);
+
+    for (auto &p : cells) {
+      const auto x0 = max<sl::index>(p.x() - 1, 0);
+      const auto y0 = max<sl::index>(p.y() - 1, 0);
+      const auto x1 = min<sl::index>(p.x() + 2, width);
+      const auto y1 = min<sl::index>(p.y() + 2, height);
+
+      for (auto y = y0; y < y1; y++)
+        for (auto x = x0; x < x1; x++) {
+          v.emplace_back(y * width + x);
+        }
+    }
+
+    sort(v.begin(), v.end());
+    v.erase(unique(v.begin(), v.end()), v.end());
+
+    dstar::update(state.neighbors, state.heuristic, state.dstar, v);
+  }
+
+  void replan_move(_replan_state &state,
+                   const vec2z    source) noexcept {
+    if (state.size.x() <= 0) {
+      return;
+    }
+
+    dstar::move(state.heuristic, state.dstar,
+                source.y() * state.size.x() + source.x());
+  }
+
+  auto replan_finish(const _replan_state &state) noexcept
+      -> sl::vector<vec2z> {
+    const auto width = state.size.x();
+
+    if (width <= 0) {
+      return {};
+    }
+
+    const auto v = dstar::finish(state.neighbors, state.dstar);
+
+    auto path = sl::vector<vec2z>(v.size());
+
+    for (sl::index i = 0; i < v.size(); i++) {
+      path[i] = vec2z { v[i] % width, v[i] / width };
+    }
+
+    return path;
+  }
+
   void convolve(
       const vec2z        size,
       span<int8_t>       dst,
@@ -488,31 +548,146 @@ namespace laplace::engine::eval::grid {
       return;
     }
 
-    for (sl::index j = 0; j < size.y(); j++)
-      for (sl::index i = 0; i < size.x(); i++) {
-        if (src[j * size.x() + i] <= 0) {
+    const auto width  = size.x();
+    const auto height = size.y();
+
+    /*  Runs of positive cells for each footprint row.
+     */
+    auto runs = sl::vector<sl::vector<vec2z>>(fp_size.y());
+
+    for (sl::index y = 0; y < fp_size.y(); y++) {
+      for (sl::index x = 0; x < fp_size.x();) {
+        if (footprint[y * fp_size.x() + x] <= 0) {
+          x++;
           continue;
         }
 
-        const auto i0 = i - center.x();
-        const auto j0 = j - center.y();
-        const auto i1 = i0 + fp_size.x();
-        const auto j1 = j0 + fp_size.y();
+        const auto x0 = x;
 
-        const auto x0 = max<sl::index>(0, i0) - i0;
-        const auto y0 = max<sl::index>(0, j0) - j0;
-        const auto x1 = min<sl::index>(size.x(), i1) - i0;
-        const auto y1 = min<sl::index>(size.y(), j1) - j0;
+        while (x < fp_size.x() &&
+               footprint[y * fp_size.x() + x] > 0) {
+          x++;
+        }
 
-        for (sl::index y = y0; y < y1; y++)
-          for (sl::index x = x0; x < x1; x++) {
-            if (footprint[y * fp_size.x() + x] <= 0) {
-              continue;
-            }
+        runs[y].emplace_back(vec2z { x0, x });
+      }
+    }
+
+    auto is_done = sl::vector<int8_t>(fp_size.y());
+    auto prefix  = sl::vector<int32_t>(width + 1);
+    auto count   = sl::vector<int32_t>(width);
+    auto rows    = sl::vector<int8_t>(width * height);
+
+    for (sl::index fy = 0; fy < fp_size.y(); fy++) {
+      if (is_done[fy] || runs[fy].empty()) {
+        continue;
+      }
+
+      /*  Horizontal pass. Cell x of the row is set if there is
+       *  a positive source cell in any of the windows
+       *      [x + cx - b + 1, x + cx - a]
+       *  for each footprint run [a, b).
+       */
+
+      for (sl::index j = 0; j < height; j++) {
+        const auto row = src.data() + j * width;
+        const auto out = rows.data() + j * width;
+
+        prefix[0] = 0;
+
+        for (sl::index i = 0; i < width; i++) {
+          prefix[i + 1] = prefix[i] + (row[i] > 0 ? 1 : 0);
+        }
+
+        for (sl::index i = 0; i < width; i++) { out[i] = 0; }
+
+        if (prefix[width] == 0) {
+          continue;
+        }
+
+        for (const auto &r : runs[fy]) {
+          const auto d0 = center.x() - r.y() + 1;
+          const auto d1 = center.x() - r.x() + 1;
+
+          const auto window = [&](sl::index i) -> int8_t {
+            const auto i0 = min(max<sl::index>(i + d0, 0), width);
+            const auto i1 = min(max<sl::index>(i + d1, 0), width);
+            return prefix[i1] - prefix[i0] > 0 ? 1 : 0;
+          };
+
+          /*  No clamping is needed inside of [a0, a1).
+           */
+          const auto a0 = min(max<sl::index>(-d0, 0), width);
+          const auto a1 = max(min<sl::index>(width - d1, width), a0);
+
+          for (sl::index i = 0; i < a0; i++) { out[i] |= window(i); }
+
+          for (sl::index i = a0; i < a1; i++) {
+            out[i] |= prefix[i + d1] - prefix[i + d0] > 0 ? 1 : 0;
+          }
+
+          for (sl::index i = a1; i < width; i++) {
+            out[i] |= window(i);
+          }
+        }
+      }
+
+      /*  Vertical pass for each run of footprint rows with the
+       *  same horizontal runs. Row y of the destination is set
+       *  from the rows
+       *      [y + cy - b + 1, y + cy - a]
+       *  using a sliding window of column counts.
+       */
+
+      for (sl::index y0 = fy; y0 < fp_size.y();) {
+        if (is_done[y0] || runs[y0] != runs[fy]) {
+          y0++;
+          continue;
+        }
+
+        auto y1 = y0;
 
-            dst[(j0 + y) * size.x() + i0 + x] = 1;
+        while (y1 < fp_size.y() && !is_done[y1] &&
+               runs[y1] == runs[fy]) {
+          is_done[y1] = 1;
+          y1++;
+        }
+
+        const auto d0 = center.y() - y1 + 1;
+        const auto d1 = center.y() - y0 + 1;
+
+        for (sl::index i = 0; i < width; i++) { count[i] = 0; }
+
+        auto add_row = [&](sl::index j, int32_t sign) {
+          if (j < 0 || j >= height) {
+            return;
           }
+
+          const auto row = rows.data() + j * width;
+
+          for (sl::index i = 0; i < width; i++) {
+            count[i] += row[i] * sign;
+          }
+        };
+
+        for (sl::index j = d0; j < d1; j++) { add_row(j, 1); }
+
+        for (sl::index y = 0; y < height; y++) {
+          const auto out = dst.data() + y * width;
+
+          for (sl::index i = 0; i < width; i++) {
+            if (count[i] > 0) {
+              out[i] = 1;
+            }
+          }
+
+          add_row(y + d0, -1);
+          add_row(y + d1, 1);
+        }
+
+        y0 = y1;
       }
+    }
   }
 
   auto nearest(
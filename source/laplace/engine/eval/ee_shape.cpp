@@ -132,6 +132,7 @@ namespace laplace::engine::eval {
                ? eval::contains(get<n_cylinder>(m_data), point)
            : is_sphere() ? eval::contains(get<n_sphere>(m_data), point)
            : is_octree() ? eval::contains(get<n_octree>(m_data), point)
+           : is_bvh()    ? eval::contains(get<n_bvh>(m_data), point)
                          : false;
   }
 
@@ -140,6 +141,7 @@ namespace laplace::engine::eval {
            : is_cylinder() ? bounds_of(get<n_cylinder>(m_data))
            : is_sphere()   ? bounds_of(get<n_sphere>(m_data))
            : is_octree()   ? get<n_octree>(m_data).bounds
+           : is_bvh()      ? bounds_of(get<n_bvh>(m_data))
                            : box {};
   }
 
@@ -163,6 +165,10 @@ namespace laplace::engine::eval {
     m_data = value;
   }
 
+  void shape::set_bvh(cref_bvh value) {
+    m_data = value;
+  }
+
   auto shape::reset_box() -> ref_box {
     if (m_data.index() != n_box) {
       m_data = box();
@@ -195,6 +201,14 @@ namespace laplace::engine::eval {
     return get<n_octree>(m_data);
   }
 
+  auto shape::reset_bvh() -> ref_bvh {
+    if (m_data.index() != n_bvh) {
+      m_data = bvh();
+    }
+
+    return get<n_bvh>(m_data);
+  }
+
   auto shape::is_empty() const -> bool {
     return m_data.index() == 0;
   }
@@ -215,6 +229,10 @@ namespace laplace::engine::eval {
     return m_data.index() == n_octree;
   }
 
+  auto shape::is_bvh() const -> bool {
+    return m_data.index() == n_bvh;
+  }
+
   auto shape::get_box() const -> cref_box {
     if (m_data.index() != n_box) {
       static constexpr box nil;
@@ -251,6 +269,15 @@ namespace laplace::engine::eval {
     return get<n_octree>(m_data);
   }
 
+  auto shape::get_bvh() const -> cref_bvh {
+    if (m_data.index() != n_bvh) {
+      static const bvh nil;
+      return nil;
+    }
+
+    return get<n_bvh>(m_data);
+  }
+
   auto intersects(cref_shape a, cref_shape b) -> bool {
     if (!a.is_empty() && !b.is_empty()) {
       if (a.is_box()) {
@@ -262,6 +289,8 @@ namespace laplace::engine::eval {
           return intersects(a.get_box(), b.get_sphere());
         if (b.is_octree())
           return intersects(a.get_box(), b.get_octree());
+        if (b.is_bvh())
+          return intersects(a.get_box(), b.get_bvh());
       }
 
       if (a.is_cylinder()) {
@@ -273,6 +302,8 @@ namespace laplace::engine::eval {
           return intersects(a.get_cylinder(), b.get_sphere());
         if (b.is_octree())
           return intersects(a.get_cylinder(), b.get_octree());
+        if (b.is_bvh())
+          return intersects(a.get_cylinder(), b.get_bvh());
       }
 
       if (a.is_sphere()) {
@@ -284,6 +315,8 @@ namespace laplace::engine::eval {
           return intersects(a.get_sphere(), b.get_sphere());
         if (b.is_octree())
           return intersects(a.get_sphere(), b.get_octree());
+        if (b.is_bvh())
+          return intersects(a.get_sphere(), b.get_bvh());
       }
 
       if (a.is_octree()) {
@@ -295,6 +328,21 @@ namespace laplace::engine::eval {
           return intersects(b.get_sphere(), a.get_octree());
         if (b.is_octree())
           return intersects(a.get_octree(), b.get_octree());
+        if (b.is_bvh())
+          return intersects(a.get_octree(), b.get_bvh());
+      }
+
+      if (a.is_bvh()) {
+        if (b.is_box())
+          return intersects(b.get_box(), a.get_bvh());
+        if (b.is_cylinder())
+          return intersects(b.get_cylinder(), a.get_bvh());
+        if (b.is_sphere())
+          return intersects(b.get_sphere(), a.get_bvh());
+        if (b.is_octree())
+          return intersects(b.get_octree(), a.get_bvh());
+        if (b.is_bvh())
+          return intersects(a.get_bvh(), b.get_bvh());
       }
     }
 
@@ -306,6 +354,7 @@ namespace laplace::engine::eval {
            : b.is_cylinder() ? intersects(a, b.get_cylinder())
            : b.is_sphere()   ? intersects(a, b.get_sphere())
            : b.is_octree()   ? intersects(a, b.get_octree())
+           : b.is_bvh()      ? intersects(a, b.get_bvh())
                              : false;
   }
 
@@ -314,6 +363,7 @@ namespace laplace::engine::eval {
            : b.is_cylinder() ? intersection(a, b.get_cylinder())
            : b.is_sphere()   ? intersection(a, b.get_sphere())
            : b.is_octree()   ? intersection(a, b.get_octree())
+           : b.is_bvh()      ? intersection(a, b.get_bvh())
                              : -safe_limit;
   }
 }
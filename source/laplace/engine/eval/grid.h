@@ -14,8 +14,12 @@
 #define laplace_engine_eval_grid_h
 
 #include "astar.h"
+#include "dstar.h"
 
 namespace laplace::engine::eval::grid {
+  /*  Runtime merge operation. Prefer passing a lambda, so
+   *  the operation is inlined into the row kernel.
+   */
   using op =
       std::function<int8_t(const int8_t dst, const int8_t src)>;
 
@@ -28,17 +32,22 @@ namespace laplace::engine::eval::grid {
   static constexpr auto op_xor =
       [](const int8_t dst, const int8_t src) { return dst ^ src; };
 
+  /*  Merge the rows of two maps. The operation is applied
+   *  per cell.
+   */
+  template <typename merge_op_>
   void merge(const vec2z                   size,
              const std::span<int8_t>       dst,
              const std::span<const int8_t> src,
-             const op                      merge_op) noexcept;
+             const merge_op_               merge_op) noexcept;
 
+  template <typename merge_op_>
   void merge(const vec2z                   dst_size,
              const std::span<int8_t>       dst,
              const vec2z                   src_size,
              const vec2i                   src_offset,
              const std::span<const int8_t> src,
-             const op                      merge_op) noexcept;
+             const merge_op_               merge_op) noexcept;
 
   using fn_point     = std::function<bool(const vec2z p)>;
   using fn_available = std::function<bool(const int8_t state)>;
@@ -114,6 +123,44 @@ namespace laplace::engine::eval::grid {
   [[nodiscard]] auto path_search_finish(const _state &state) noexcept
       -> sl::vector<vec2z>;
 
+  struct _replan_state {
+    dstar::_state dstar;
+
+    vec2z size;
+
+    astar::fn_heuristic heuristic;
+    astar::fn_neighbors neighbors;
+  };
+
+  /*  Incremental path search. The map is referenced by the
+   *  state, so it can be changed in place. Changed cells
+   *  should be passed to replan_update.
+   */
+  [[nodiscard]] auto replan_init(
+      const vec2z                   size,
+      const intval                  scale,
+      const std::span<const int8_t> map,
+      const fn_available            available,
+      const vec2z                   source,
+      const vec2z                   destination) noexcept
+      -> _replan_state;
+
+  [[nodiscard]] auto replan_loop(_replan_state &state) noexcept
+      -> astar::status;
+
+  void replan_update(_replan_state                &state,
+                     const std::span<const vec2z> cells) noexcept;
+
+  void replan_move(_replan_state &state, const vec2z source) noexcept;
+
+  [[nodiscard]] auto replan_finish(
+      const _replan_state &state) noexcept -> sl::vector<vec2z>;
+
+  /*  Stamp the footprint at each positive cell of the
+   *  source. Footprint rows are split into runs and the
+   *  rows with equal runs are dilated together, so the cost
+   *  does not depend on the footprint area.
+   */
   void convolve(
       const vec2z             size,
       std::span<int8_t>       dst,
@@ -130,4 +177,6 @@ namespace laplace::engine::eval::grid {
           [](const int8_t x) { return x <= 0; }) noexcept -> vec2z;
 }
 
+#include "grid.impl.h"
+
 #endif
@@ -0,0 +1,83 @@
+/*  laplace/engine/eval/grid.impl.h
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#ifndef laplace_engine_eval_grid_impl_h
+#define laplace_engine_eval_grid_impl_h
+
+#include "../../core/log.h"
+
+namespace laplace::engine::eval::grid::impl {
+  /*  Contiguous row loop without calls, so the compiler
+   *  vectorizes it.
+   */
+  template <typename merge_op_>
+  inline void merge_row(int8_t         *dst,
+                        const int8_t   *src,
+                        const sl::whole count,
+                        const merge_op_ merge_op) noexcept {
+    for (sl::index i = 0; i < count; i++) {
+      dst[i] = static_cast<int8_t>(merge_op(dst[i], src[i]));
+    }
+  }
+}
+
+namespace laplace::engine::eval::grid {
+  template <typename merge_op_>
+  inline void merge(const vec2z                   size,
+                    const std::span<int8_t>       dst,
+                    const std::span<const int8_t> src,
+                    const merge_op_               merge_op) noexcept {
+
+    const auto count = size.x() * size.y();
+
+    if (count > dst.size()) {
+      error_("Invalid destination size.", __FUNCTION__);
+      return;
+    }
+
+    if (count > src.size()) {
+      error_("Invalid source size.", __FUNCTION__);
+      return;
+    }
+
+    impl::merge_row(dst.data(), src.data(), count, merge_op);
+  }
+
+  template <typename merge_op_>
+  inline void merge(const vec2z                   dst_size,
+                    const std::span<int8_t>       dst,
+                    const vec2z                   src_size,
+                    const vec2i                   src_offset,
+                    const std::span<const int8_t> src,
+                    const merge_op_               merge_op) noexcept {
+
+    if (dst_size.x() * dst_size.y() > dst.size()) {
+      error_("Invalid destination size.", __FUNCTION__);
+      return;
+    }
+
+    if (src_size.x() * src_size.y() > src.size()) {
+      error_("Invalid source size.", __FUNCTION__);
+      return;
+    }
+
+    for (sl::index y = 0; y < src_size.y(); y++) {
+      const auto n = (src_offset.y() + y) * dst_size.x() +
+                     src_offset.x();
+
+      impl::merge_row(dst.data() + n, src.data() + y * src_size.x(),
+                      src_size.x(), merge_op);
+    }
+  }
+}
+
+#endif
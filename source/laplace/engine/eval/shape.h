@@ -13,7 +13,7 @@
 #ifndef laplace_engine_eval_shape_h
 #define laplace_engine_eval_shape_h
 
-#include "geometry.h"
+#include "bvh.h"
 
 namespace laplace::engine::eval {
   class shape {
@@ -29,30 +29,36 @@ namespace laplace::engine::eval {
     void set_cylinder(cref_cylinder value);
     void set_sphere(cref_sphere value);
     void set_octree(cref_octree value);
+    void set_bvh(cref_bvh value);
 
     auto reset_box() -> ref_box;
     auto reset_cylinder() -> ref_cylinder;
     auto reset_sphere() -> ref_sphere;
     auto reset_octree() -> ref_octree;
+    auto reset_bvh() -> ref_bvh;
 
     auto is_empty() const -> bool;
     auto is_box() const -> bool;
     auto is_cylinder() const -> bool;
     auto is_sphere() const -> bool;
     auto is_octree() const -> bool;
+    auto is_bvh() const -> bool;
 
     auto get_box() const -> cref_box;
     auto get_cylinder() const -> cref_cylinder;
     auto get_sphere() const -> cref_sphere;
     auto get_octree() const -> cref_octree;
+    auto get_bvh() const -> cref_bvh;
 
   private:
     static constexpr size_t n_box      = 1;
     static constexpr size_t n_cylinder = 2;
     static constexpr size_t n_sphere   = 3;
     static constexpr size_t n_octree   = 4;
+    static constexpr size_t n_bvh      = 5;
 
-    std::variant<std::monostate, box, cylinder, sphere, octree> m_data;
+    std::variant<std::monostate, box, cylinder, sphere, octree, bvh>
+        m_data;
   };
 
   using cref_shape = shape::cref_shape;
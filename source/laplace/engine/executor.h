@@ -0,0 +1,94 @@
+/*  laplace/engine/executor.h
+ *
+ *      Thread pool shared by the Worlds. Full thread-safe.
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#ifndef laplace_engine_executor_h
+#define laplace_engine_executor_h
+
+#include "../core/defs.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace laplace::engine {
+  /*  Each client submits the tasks into its own lane. The
+   *  workers take the lanes in turn, so a busy client does not
+   *  starve the others.
+   */
+  class executor {
+  public:
+    using task        = std::function<void()>;
+    using thread_init = std::function<void(sl::index)>;
+
+    executor(const executor &) = delete;
+    auto operator=(const executor &) -> executor & = delete;
+
+    /*  Zero means hardware concurrency.
+     */
+    explicit executor(sl::whole thread_count = 0);
+
+    /*  Runs the pending tasks, including the ones they submit,
+     *  then joins the workers.
+     */
+    ~executor();
+
+    /*  Returns the lane index.
+     */
+    [[nodiscard]] auto add_lane() -> sl::index;
+
+    /*  The lane shall have no pending tasks.
+     */
+    void remove_lane(sl::index lane);
+
+    void submit(sl::index lane, task fn);
+
+    /*  Each worker calls the function on its own thread with the
+     *  worker index before the next task, e.g. to set the thread
+     *  affinity. Applies to the running workers too.
+     */
+    void set_thread_init(thread_init fn);
+
+    [[nodiscard]] auto get_thread_count() const noexcept -> sl::whole;
+
+    /*  Process-wide executor.
+     */
+    [[nodiscard]] static auto get_default() -> executor &;
+
+  private:
+    struct lane_info {
+      std::deque<task> tasks;
+      bool             is_used = false;
+    };
+
+    /*  Returns false if the executor is done and no tasks are
+     *  left.
+     */
+    [[nodiscard]] auto locked_next(task &fn) -> bool;
+
+    void worker(sl::index n);
+
+    std::mutex                m_lock;
+    std::condition_variable   m_sync;
+    sl::vector<lane_info>     m_lanes;
+    sl::index                 m_next         = 0;
+    sl::whole                 m_pending      = 0;
+    bool                      m_done         = false;
+    thread_init               m_init;
+    sl::index                 m_init_version = 0;
+    std::vector<std::jthread> m_threads;
+  };
+}
+
+#endif
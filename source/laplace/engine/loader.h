@@ -14,19 +14,56 @@
 #define laplace_engine_loader_h
 
 #include "basic_impact.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 #include <thread>
 
 namespace laplace::engine {
-  /*  Queued background loading.
+  /*  Background loading on a worker pool.
+   *
+   *  Each task is performed after all of its dependencies are
+   *  done. Independent tasks may be performed concurrently, so
+   *  they should not use the World random engine if the result
+   *  must be deterministic.
    */
   class loader {
   public:
-    loader();
+    using fn_progress = std::function<void(sl::index progress,
+                                           sl::whole total)>;
+
+    /*  Zero means hardware concurrency.
+     */
+    static const sl::whole default_thread_count;
+
+    loader(sl::whole thread_count = default_thread_count);
     ~loader();
 
     void set_world(ptr_world w);
 
-    void add_task(ptr_impact task);
+    /*  Set progress callback. It is invoked from the worker
+     *  threads after each task is done, possibly concurrently.
+     */
+    void on_progress(fn_progress fn);
+
+    /*  Add the task that depends on the previously added
+     *  task. Tasks added this way are performed in order.
+     *
+     *  Returns the task index.
+     */
+    auto add_task(ptr_impact task) -> sl::index;
+
+    /*  Add the task that depends on the specified tasks only.
+     *
+     *  Returns the task index.
+     */
+    auto add_task(ptr_impact                 task,
+                  std::span<const sl::index> dependencies)
+        -> sl::index;
+
+    /*  Wait until all tasks done.
+     */
+    void wait();
 
     /*  Check if all tasks done.
      */
@@ -36,19 +73,43 @@ namespace laplace::engine {
      */
     [[nodiscard]] auto get_progress() -> sl::index;
 
+    /*  Get added task count.
+     */
+    [[nodiscard]] auto get_task_count() -> sl::whole;
+
+    [[nodiscard]] auto get_thread_count() const noexcept
+        -> sl::whole;
+
   private:
-    void set_ready(bool is_ready);
+    struct task_state {
+      ptr_impact            impact;
+      sl::vector<sl::index> next;
+      sl::whole             pending = 0;
+      bool                  is_done = false;
+    };
+
+    auto locked_add_task(ptr_impact                 task,
+                         std::span<const sl::index> dependencies)
+        -> sl::index;
+
+    void tick_thread();
     void done();
 
     std::mutex              m_lock;
     std::condition_variable m_sync;
-    std::jthread            m_thread;
 
-    bool        m_is_ready = true;
-    bool        m_is_done  = false;
-    sl::index   m_progress = 0;
+    bool        m_is_ready       = true;
+    bool        m_is_done        = false;
+    sl::index   m_progress       = 0;
+    sl::whole   m_callback_count = 0;
     ptr_world   m_world;
-    vptr_impact m_queue;
+    fn_progress m_on_progress;
+
+    sl::vector<task_state> m_tasks;
+    sl::vector<sl::index>  m_ready;
+    sl::index              m_ready_next = 0;
+
+    sl::vector<std::jthread> m_threads;
   };
 }
 
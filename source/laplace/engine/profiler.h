@@ -0,0 +1,190 @@
+/*  laplace/engine/profiler.h
+ *
+ *      World tick profiler. Samples are collected into
+ *      per-thread ring buffers and can be dumped as a Chrome
+ *      trace JSON file.
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#ifndef laplace_engine_profiler_h
+#define laplace_engine_profiler_h
+
+#include "../core/defs.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <typeinfo>
+
+namespace laplace::engine {
+  class profiler {
+  public:
+    static const sl::whole default_capacity;
+
+    enum kind : uint8_t {
+      sync_queue = 0,
+      async_queue,
+      dynamic_tick,
+      adjust,
+      barrier_wait,
+      impact,
+      entity,
+      _kind_count
+    };
+
+    struct sample {
+      const std::type_info *type  = nullptr;
+      int64_t               begin = 0;
+      int64_t               end   = 0;
+      kind                  what  = sync_queue;
+    };
+
+    struct stats {
+      sl::whole count = 0;
+      int64_t   total = 0;
+      int64_t   max   = 0;
+    };
+
+    struct type_stats {
+      std::string name;
+      kind        what = impact;
+      stats       cost;
+    };
+
+    /*  Single thread sample storage. The oldest samples are
+     *  overwritten when the buffer is full. Push is lock-free
+     *  and shall be called by one thread at a time. The readers
+     *  skip the samples overwritten while reading.
+     */
+    class ring {
+    public:
+      ring(sl::whole capacity);
+
+      void push(const sample &s) noexcept;
+
+      /*  Shall not be called while the samples are pushed.
+       */
+      void resize(sl::whole capacity);
+
+      void clear() noexcept;
+
+      /*  Get all the samples, the oldest first.
+       */
+      [[nodiscard]] auto get_all() -> sl::vector<sample>;
+
+    private:
+      std::mutex             m_lock;
+      sl::vector<sample>     m_samples;
+      std::atomic<sl::whole> m_started = 0;
+      std::atomic<sl::whole> m_count   = 0;
+      std::atomic<sl::whole> m_first   = 0;
+    };
+
+    /*  Scoped sample. Does nothing if the ring is null.
+     */
+    class scope {
+    public:
+      scope(const scope &) = delete;
+      auto operator=(const scope &) -> scope & = delete;
+
+      scope(ring                 *r,
+            kind                  what,
+            const std::type_info *type = nullptr) noexcept;
+      ~scope();
+
+    private:
+      ring                 *m_ring;
+      const std::type_info *m_type;
+      int64_t               m_begin;
+      kind                  m_what;
+    };
+
+    profiler(const profiler &) = delete;
+    auto operator=(const profiler &) -> profiler & = delete;
+
+    profiler()  = default;
+    ~profiler() = default;
+
+    /*  Enable sampling of the tick phases.
+     *  Thread-safe.
+     */
+    void enable(bool is_enabled) noexcept;
+
+    /*  Enable sampling of each Impact and each dynamic
+     *  Entity tick.
+     *  Thread-safe.
+     */
+    void enable_detailed(bool is_enabled) noexcept;
+
+    /*  Set ring buffer capacity for each thread. Clears
+     *  all collected samples. Shall not be called while the
+     *  World is ticking.
+     */
+    void set_capacity(sl::whole capacity);
+
+    [[nodiscard]] auto is_enabled() const noexcept -> bool;
+    [[nodiscard]] auto is_detailed() const noexcept -> bool;
+
+    /*  Get the ring buffer for the thread. Returns null
+     *  if the profiler is disabled.
+     *  Thread-safe.
+     */
+    [[nodiscard]] auto get_ring(sl::index thread_index) -> ring *;
+
+    /*  The ring buffer if detailed sampling is enabled.
+     */
+    [[nodiscard]] auto detailed(ring *r) const noexcept -> ring *;
+
+    /*  Data access. Samples may be read while the World is
+     *  ticking.
+     *  Thread-safe.
+     */
+
+    void clear();
+
+    [[nodiscard]] auto get_thread_count() -> sl::whole;
+    [[nodiscard]] auto get_samples(sl::index thread_index)
+        -> sl::vector<sample>;
+
+    /*  Summary over all the collected samples of a kind.
+     *  Time values are in nanoseconds.
+     */
+    [[nodiscard]] auto get_stats(kind what) -> stats;
+
+    /*  Summary for each Impact and Entity type, sorted by
+     *  total time descending.
+     */
+    [[nodiscard]] auto get_type_stats() -> sl::vector<type_stats>;
+
+    /*  Write Chrome trace event JSON.
+     */
+    void dump_trace(std::ostream &out);
+
+    /*  Save Chrome trace event JSON file.
+     */
+    auto save_trace(std::string_view file_name) -> bool;
+
+    [[nodiscard]] static auto get_name(kind what) noexcept
+        -> std::string_view;
+
+    [[nodiscard]] static auto now() noexcept -> int64_t;
+
+  private:
+    std::mutex        m_lock;
+    std::atomic<bool> m_is_enabled  = false;
+    std::atomic<bool> m_is_detailed = false;
+    sl::whole         m_capacity    = default_capacity;
+
+    sl::vector<std::unique_ptr<ring>> m_rings;
+  };
+}
+
+#endif
@@ -15,12 +15,17 @@
 #ifndef laplace_engine_scheduler_h
 #define laplace_engine_scheduler_h
 
+#include "executor.h"
+#include "profiler.h"
 #include "world.predef.h"
-#include <condition_variable>
-#include <functional>
-#include <thread>
 
 namespace laplace::engine {
+  /*  The ticks run on an executor shared with other Worlds. The
+   *  thread count is the number of tasks per parallel phase.
+   *  Between the phases, the last finished task does the sync
+   *  work and starts the next phase, so no task waits for
+   *  another one.
+   */
   class scheduler {
   public:
     static const sl::whole overthreading_limit;
@@ -29,7 +34,7 @@ namespace laplace::engine {
     scheduler(const scheduler &) = delete;
     auto operator=(const scheduler &) -> scheduler & = delete;
 
-    scheduler(world &w);
+    scheduler(world &w, executor &pool = executor::get_default());
     ~scheduler();
 
     void schedule(sl::whole delta);
@@ -40,21 +45,42 @@ namespace laplace::engine {
     [[nodiscard]] auto get_thread_count() -> sl::whole;
 
   private:
-    void set_done();
-    void sync(std::function<void()> fn);
-    void tick_thread();
+    enum phase_type { async_queue, dynamic_tick, adjust };
 
-    world &m_world;
+    /*  Run the sync queue if any, then start the next parallel
+     *  phase.
+     */
+    void next_queue(sl::index thread_index);
 
-    std::mutex                m_lock_ex;
-    std::mutex                m_lock_in;
-    std::condition_variable   m_sync;
-    std::vector<std::jthread> m_threads;
+    /*  Mark the scheduler running and look up the profiler rings
+     *  once for the whole run.
+     */
+    void locked_begin(sl::whole count);
 
-    bool      m_done       = false;
-    sl::whole m_in         = 0;
-    sl::whole m_out        = 0;
-    sl::whole m_tick_count = 0;
+    void start(phase_type phase);
+    void perform(phase_type phase, sl::index thread_index);
+    void finish(phase_type phase, sl::index thread_index);
+
+    world    &m_world;
+    executor &m_pool;
+    sl::index m_lane;
+
+    std::mutex              m_lock;
+    std::condition_variable m_sync;
+
+    bool      m_is_running   = false;
+    bool      m_done         = false;
+    sl::whole m_thread_count = 0;
+    sl::whole m_phase_count  = 0;
+    sl::whole m_active       = 0;
+    sl::whole m_tick_count   = 0;
+
+    sl::vector<profiler::ring *> m_rings;
+
+    /*  When each task of the previous phase has finished, or
+     *  zero. The time until the next phase is the barrier wait.
+     */
+    sl::vector<int64_t> m_idle_since;
   };
 }
 
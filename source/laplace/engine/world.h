@@ -18,6 +18,8 @@
 #include "../platform/thread.h"
 #include "basic_entity.h"
 #include "basic_impact.predef.h"
+#include "entity_table.h"
+#include "profiler.h"
 #include "scheduler.h"
 #include <functional>
 #include <random>
@@ -26,13 +28,31 @@
 namespace laplace::engine {
   class world : public std::enable_shared_from_this<world> {
   public:
-    static const bool default_allow_relaxed_spawn;
+    using fn_tick = std::function<void(const access::world &)>;
+
+    static const bool      default_allow_relaxed_spawn;
+    static const sl::whole wheel_size;
+
+    /*  Lock-free read access to the Entity table for the
+     *  current thread. Valid only while the World is frozen.
+     */
+    class read_scope {
+    public:
+      read_scope(const read_scope &) = delete;
+      auto operator=(const read_scope &) -> read_scope & = delete;
+
+      read_scope(world &w) noexcept;
+      ~read_scope();
+
+    private:
+      world *m_previous;
+    };
 
     world(const world &) = delete;
     auto operator=(const world &) -> world & = delete;
 
     world();
-    ~world() = default;
+    ~world();
 
     auto reserve(sl::index id) -> sl::index;
     void emplace(ptr_entity ent, sl::index id);
@@ -41,6 +61,18 @@ namespace laplace::engine {
     void respawn(sl::index id);
     void clear();
 
+    /*  The Entity table is not changed while the World is
+     *  frozen. Spawns and removals are deferred until it is
+     *  unfrozen, so the readers may skip the lock.
+     */
+    void freeze();
+    void unfreeze();
+
+    /*  Reschedule a dynamic Entity after its clock was
+     *  changed.
+     */
+    void reclock(sl::index id);
+
     void desync();
 
     /*  Impact will be performed due live loop.
@@ -62,6 +94,13 @@ namespace laplace::engine {
 
     void set_thread_count(const sl::whole thread_count);
 
+    /*  Set tick callback. It is invoked after each tick, when
+     *  all the Entities are adjusted and the deferred changes
+     *  are not applied yet, possibly from a scheduler thread.
+     *  The World is read-only and frozen during the call.
+     */
+    void on_tick(fn_tick fn);
+
     [[nodiscard]] auto get_thread_count() -> sl::whole;
 
     void set_root(sl::index id_root);
@@ -70,41 +109,100 @@ namespace laplace::engine {
     void allow_relaxed_spawn(bool is_allowed);
     auto is_relaxed_spawn_allowed() -> bool;
 
+    /*  Returns the index of the next tick to compute
+     *  dynamic Entities for.
+     */
+    [[nodiscard]] auto get_tick() -> uint64_t;
+
     auto get_random() -> ref_rand;
+    auto get_profiler() -> profiler &;
     auto get_entity(sl::index id) -> ptr_entity;
+    auto has_entity(sl::index id) -> bool;
 
     auto is_desync() -> bool;
 
     void clean_sync_queue();
     void clean_async_queue();
     void reset_index();
+    void reset_due();
     auto no_queue() -> bool;
     auto next_sync_impact() -> ptr_impact;
     auto next_async_impact() -> ptr_impact;
     auto next_dynamic_entity() -> ptr_entity;
     auto next_entity() -> ptr_entity;
 
+    /*  Invoke the tick callback.
+     */
+    void notify_tick();
+
   private:
+    /*  Dynamic Entities are stored in a timer wheel, keyed by
+     *  the tick they are due at. Each tick only the due ones
+     *  are visited, in ascending id order.
+     */
+    struct wheel_entry {
+      uint64_t  due = 0;
+      sl::index id  = id_undefined;
+    };
+
+    struct deferred_op {
+      enum kind : uint8_t { spawn, emplace, remove, clear };
+
+      kind       what = spawn;
+      sl::index  id   = id_undefined;
+      ptr_entity ent;
+    };
+
+    static constexpr uint64_t due_static = time_undefined;
+    static constexpr uint64_t due_never  = time_undefined - 1;
+
     [[nodiscard]] auto check_scheduler() -> bool;
 
+    auto locked_spawn(ptr_entity ent, sl::index id, bool is_relaxed)
+        -> sl::index;
+    void locked_remove(sl::index id);
+    void locked_clear();
+    auto locked_defer(deferred_op::kind what,
+                      ptr_entity        ent,
+                      sl::index         id) -> sl::index;
+    void locked_freeze();
+    void locked_unfreeze();
     void locked_desync();
     void locked_add_dynamic(sl::index id);
     void locked_erase_dynamic(sl::index id);
+    auto locked_due_of(basic_entity &en) -> uint64_t;
+    void locked_schedule(sl::index id, uint64_t due);
+    void locked_collect_due();
+
+    /*  The profiler should outlive the scheduler threads.
+     */
+    profiler m_profiler;
 
     std::shared_mutex          m_lock;
     std::unique_ptr<scheduler> m_scheduler;
 
     bool      m_allow_relaxed_spawn = default_allow_relaxed_spawn;
     bool      m_desync              = false;
+    bool      m_is_frozen           = false;
+    bool      m_is_due_ready        = false;
     sl::index m_root                = id_undefined;
-    sl::index m_next_id             = 0;
     sl::index m_index               = 0;
-
-    eval::random          m_rand;
-    sl::vector<sl::index> m_dynamic_ids;
-    vptr_entity           m_entities;
-    vptr_impact           m_queue;
-    vptr_impact           m_sync_queue;
+    uint64_t  m_tick                = 0;
+
+    eval::random                        m_rand;
+    sl::vector<uint64_t>                m_due;
+    sl::vector<sl::index>               m_due_ids;
+    sl::vector<sl::vector<wheel_entry>> m_wheel;
+    entity_table                        m_entities;
+    vptr_impact                         m_queue;
+    vptr_impact                         m_sync_queue;
+    sl::vector<deferred_op>             m_deferred;
+    sl::vector<deferred_op>             m_applying;
+    sl::vector<bool>                    m_reserved;
+    sl::index                           m_reserve_next = 0;
+    fn_tick                             m_on_tick;
+
+    static thread_local world *m_reader;
   };
 }
 
@@ -42,12 +42,161 @@ namespace laplace::format::binary {
    */
   void unpack(core::ref_family data);
 
+  /*  The result is empty if the data is invalid or nested
+   *  deeper than 256 containers.
+   */
   auto decode(fn_read read) -> pack_type;
+
+  /*  Decode in place. The data may be a mapped file.
+   */
+  auto decode(span_cbyte data) -> pack_type;
   auto encode(fn_write write, const_pack_type data) -> bool;
 
   /*  String key ids table.
    */
   extern const std::vector<std::u8string> table;
+
+  class frozen_view;
+
+  /*  Read-only family tree decoded in place. All the nodes are
+   *  in one array, strings and bytes refer to the source data.
+   *  The data shall outlive the tree.
+   *
+   *  Composite fields are in the encoded order. If the keys are
+   *  not sorted, the lookup takes the last match.
+   */
+  class frozen_tree {
+  public:
+    frozen_tree() noexcept  = default;
+    ~frozen_tree() noexcept = default;
+
+    frozen_tree(const frozen_tree &) noexcept = default;
+    frozen_tree(frozen_tree &&) noexcept      = default;
+
+    auto operator=(const frozen_tree &) noexcept
+        -> frozen_tree & = default;
+    auto operator=(frozen_tree &&) noexcept
+        -> frozen_tree & = default;
+
+    /*  The view is valid while the tree is not changed.
+     */
+    [[nodiscard]] auto get_root() const noexcept -> frozen_view;
+
+    [[nodiscard]] auto get_node_count() const noexcept -> sl::whole;
+
+  private:
+    friend class frozen_view;
+    friend class frozen_reader;
+
+    /*  Same order as the family types, so the keys compare the
+     *  same way.
+     */
+    enum node_type : uint8_t {
+      t_empty     = 0,
+      t_uint      = 1,
+      t_bool      = 2,
+      t_int       = 3,
+      t_string    = 5,
+      t_bytes     = 6,
+      t_vector    = 7,
+      t_composite = 8
+    };
+
+    /*  Value is the number, the data offset, or the first child
+     *  index. Composite children are key and value pairs.
+     */
+    struct node {
+      int64_t   value      = 0;
+      uint32_t  size       = 0;
+      node_type type       = t_empty;
+      bool      is_ordered = true;
+    };
+
+    span_cbyte       m_data;
+    sl::vector<node> m_nodes;
+  };
+
+  class frozen_view {
+  public:
+    frozen_view() noexcept = default;
+
+    [[nodiscard]] auto is_empty() const noexcept -> bool;
+    [[nodiscard]] auto is_boolean() const noexcept -> bool;
+    [[nodiscard]] auto is_integer() const noexcept -> bool;
+    [[nodiscard]] auto is_uint() const noexcept -> bool;
+    [[nodiscard]] auto is_string() const noexcept -> bool;
+    [[nodiscard]] auto is_bytes() const noexcept -> bool;
+    [[nodiscard]] auto is_vector() const noexcept -> bool;
+    [[nodiscard]] auto is_composite() const noexcept -> bool;
+
+    [[nodiscard]] auto get_boolean() const noexcept -> bool;
+    [[nodiscard]] auto get_integer() const noexcept
+        -> signed long long;
+    [[nodiscard]] auto get_uint() const noexcept
+        -> unsigned long long;
+    [[nodiscard]] auto get_string() const noexcept
+        -> std::u8string_view;
+    [[nodiscard]] auto get_bytes() const noexcept -> span_cbyte;
+
+    /*  Return vector or composite size in elements.
+     */
+    [[nodiscard]] auto get_size() const noexcept -> sl::whole;
+
+    /*  Container keys are not looked up.
+     */
+    [[nodiscard]] auto has(core::cref_family key) const noexcept
+        -> bool;
+
+    /*  Get composite key by index.
+     */
+    [[nodiscard]] auto get_key(sl::index n) const noexcept
+        -> frozen_view;
+
+    /*  Get vector or composite element by index.
+     */
+    [[nodiscard]] auto get_value(sl::index n) const noexcept
+        -> frozen_view;
+
+    /*  Get composite element by key. Returns an empty view if
+     *  there is no such key.
+     */
+    [[nodiscard]] auto get_value(
+        core::cref_family key) const noexcept -> frozen_view;
+
+    [[nodiscard]] auto operator[](sl::index n) const noexcept
+        -> frozen_view;
+    [[nodiscard]] auto operator[](
+        core::cref_family key) const noexcept -> frozen_view;
+
+    /*  Copy the subtree into a mutable family.
+     */
+    [[nodiscard]] auto thaw() const noexcept -> core::family;
+
+  private:
+    friend class frozen_tree;
+    friend class frozen_reader;
+
+    using node = frozen_tree::node;
+
+    frozen_view(const frozen_tree *tree, sl::index n) noexcept;
+
+    [[nodiscard]] auto get_node() const noexcept -> const node &;
+    [[nodiscard]] auto child(sl::index n) const noexcept
+        -> frozen_view;
+
+    /*  Returns the composite key position, or -1.
+     */
+    [[nodiscard]] auto find(core::cref_family key) const noexcept
+        -> sl::index;
+
+    const frozen_tree *m_tree = nullptr;
+    sl::index          m_node = -1;
+  };
+
+  /*  Decode into a frozen tree without copying the strings and
+   *  bytes. The tree is empty if the data is invalid.
+   */
+  auto decode_frozen(span_cbyte data) -> frozen_tree;
 }
 
 #endif
@@ -19,11 +19,15 @@
 #include "../core/serial.h"
 #include "../core/utils.h"
 #include "text.h"
+#include <limits>
+#include <unordered_map>
 
 namespace laplace::format::binary {
   using std::make_shared, std::vector, std::u8string,
-      std::u8string_view, core::ref_family, core::cref_family,
-      core::family, serial::rd, serial::wr;
+      std::u8string_view, std::min, std::numeric_limits,
+      std::unordered_map, core::ref_family, core::cref_family,
+      core::family, core::vfamily, core::composite, serial::rd,
+      serial::wr;
 
   const vector<u8string> table = {
     u8"_undefined",   text::s_function, text::s_arguments,
@@ -31,267 +35,417 @@ namespace laplace::format::binary {
     u8"height",       u8"depth",        u8"pixels"
   };
 
-  static auto pack_key(ref_family composite, sl::index index) -> bool {
-    bool result = false;
-    auto key    = family(composite.get_key(index));
+  /*  Returns the table id of the key, or -1.
+   */
+  static auto table_id(u8string_view key) -> sl::index {
+    static const auto ids = []() {
+      auto m = unordered_map<u8string_view, sl::index> {};
 
-    if (key.is_string()) {
       for (sl::index n = 0; n < table.size(); n++) {
-        if (key.get_string() == table[n]) {
-          key = n;
-
-          if (!composite.has(key)) {
-            composite.set_key(index, key);
-            result = true;
-          }
-
-          break;
-        }
+        m.emplace(table[n], n);
       }
-    }
 
-    return result;
+      return m;
+    }();
+
+    const auto i = ids.find(key);
+    return i != ids.end() ? i->second : -1;
   }
 
-  static auto unpack_key(ref_family composite, sl::index index)
-      -> bool {
-    bool result = false;
-    auto key    = family(composite.get_key(index));
+  /*  Replaces the composite keys in one pass. A key is kept if
+   *  the replacement is already used.
+   */
+  template <typename fn_key_>
+  static void replace_keys(ref_family data, fn_key_ replace,
+                           void (*recurse)(ref_family)) {
+    if (data.is_composite()) {
+      auto fields = composite {};
+      fields.reserve(data.get_size());
 
-    if (key.is_integer()) {
-      auto n = key.get_integer();
+      for (sl::index i = 0; i < data.get_size(); i++) {
+        const auto &key   = data.get_key(i);
+        auto       &field = fields.emplace_back(
+            key, std::move(data.value(key)));
 
-      if (n < table.size()) {
-        key = table[n];
+        recurse(field.second);
 
-        if (!composite.has(key)) {
-          composite.set_key(index, key);
-          result = true;
+        if (auto k = replace(key); !k.is_empty() && !data.has(k)) {
+          field.first = std::move(k);
         }
       }
-    }
 
-    return result;
-  }
-
-  void pack(ref_family data) {
-    if (data.is_composite()) {
-      for (sl::index i = 0; i < data.get_size();) {
-        i = pack_key(data, i) ? 0 : i + 1;
-      }
+      data = std::move(fields);
     }
 
-    if (data.is_composite() || data.is_vector()) {
+    if (data.is_vector()) {
       for (sl::index i = 0; i < data.get_size(); i++) {
-        pack(data.value(i));
+        recurse(data.value(i));
       }
     }
   }
 
+  void pack(ref_family data) {
+    replace_keys(
+        data,
+        [](cref_family key) -> family {
+          if (key.is_string()) {
+            if (auto n = table_id(key.get_string()); n >= 0) {
+              return n;
+            }
+          }
+
+          return {};
+        },
+        pack);
+  }
+
   void unpack(ref_family data) {
-    if (data.is_composite()) {
-      for (sl::index i = 0; i < data.get_size();) {
-        i = unpack_key(data, i) ? 0 : i + 1;
+    replace_keys(
+        data,
+        [](cref_family key) -> family {
+          if (key.is_integer()) {
+            auto n = key.get_integer();
+
+            if (n >= 0 && n < table.size()) {
+              return family(table[n]);
+            }
+          }
+
+          return {};
+        },
+        unpack);
+  }
+
+  /*  Deeper data is rejected to keep the recursion bounded.
+   */
+  static constexpr sl::whole max_depth = 256;
+
+  /*  Nesting depth of the containers being read.
+   */
+  class depth_counter {
+  public:
+    [[nodiscard]] auto enter() noexcept -> bool {
+      if (m_depth >= max_depth) {
+        return false;
       }
+
+      m_depth++;
+      return true;
     }
 
-    if (data.is_composite() || data.is_vector()) {
-      for (sl::index i = 0; i < data.get_size(); i++) {
-        unpack(data.value(i));
+    void leave() noexcept {
+      m_depth--;
+    }
+
+  private:
+    sl::whole m_depth = 0;
+  };
+
+  /*  Reads the fields in place from a contiguous buffer.
+   */
+  class span_reader : public depth_counter {
+  public:
+    explicit span_reader(span_cbyte data) noexcept : m_data(data) { }
+
+    [[nodiscard]] auto read(sl::whole count, span_cbyte &dst) noexcept
+        -> bool {
+      if (count < 0 || count > get_left()) {
+        return false;
       }
+
+      dst = m_data.subspan(m_offset, count);
+      m_offset += count;
+      return true;
     }
-  }
 
-  static auto read_int(fn_read read, ref_family value) -> bool {
-    auto v = read(8);
+    [[nodiscard]] auto get_left() const noexcept -> sl::whole {
+      return m_data.size() - m_offset;
+    }
 
-    if (v.size() != 8)
-      return false;
+  private:
+    span_cbyte m_data;
+    sl::index  m_offset = 0;
+  };
 
-    value = rd<int64_t>(v, 0);
-    return true;
-  }
+  /*  Reads the fields from a stream. The data is valid until the
+   *  next read.
+   */
+  class stream_reader : public depth_counter {
+  public:
+    explicit stream_reader(fn_read read) noexcept :
+        m_read(std::move(read)) { }
 
-  static auto read_string(fn_read read, ref_family value) -> bool {
-    auto v = read(8);
+    [[nodiscard]] auto read(sl::whole count, span_cbyte &dst)
+        -> bool {
+      m_buffer = m_read(count);
+
+      if (m_buffer.size() != count) {
+        return false;
+      }
+
+      dst = m_buffer;
+      return true;
+    }
+
+    /*  Size of the stream is unknown, so the reservation is
+     *  limited.
+     */
+    [[nodiscard]] auto get_left() const noexcept -> sl::whole {
+      return 0x1000;
+    }
 
-    if (v.size() != 8)
+  private:
+    fn_read m_read;
+    vbyte   m_buffer;
+  };
+
+  template <typename reader_>
+  static auto read_size(reader_ &in, sl::whole &size) -> bool {
+    auto v = span_cbyte {};
+
+    if (!in.read(8, v))
       return false;
 
-    auto size = as_index(rd<uint64_t>(v, 0));
-    v         = read(size);
+    const auto n = rd<uint64_t>(v, 0);
 
-    if (v.size() != size)
+    /*  Sizes are checked against the data left. The limit only
+     *  prevents the overflow.
+     */
+    constexpr auto limit = static_cast<uint64_t>(
+        numeric_limits<sl::whole>::max() / 2);
+
+    if (n > limit)
       return false;
 
-    value = u8string(v.begin(), v.end());
+    size = static_cast<sl::whole>(n);
     return true;
   }
 
-  static auto read_uint(fn_read read, ref_family value) -> bool {
-    auto v = read(8);
+  template <typename reader_>
+  static auto read_int(reader_ &in, ref_family value) -> bool {
+    auto v = span_cbyte {};
 
-    if (v.size() != 8)
+    if (!in.read(8, v))
       return false;
 
-    value = rd<uint64_t>(v, 0);
+    value = rd<int64_t>(v, 0);
     return true;
   }
 
-  static auto read_bytes(fn_read read, ref_family value) -> bool {
-    auto v = read(8);
+  template <typename reader_>
+  static auto read_string(reader_ &in, ref_family value) -> bool {
+    auto size = sl::whole {};
+    auto v    = span_cbyte {};
 
-    if (v.size() != 8)
+    if (!read_size(in, size) || !in.read(size, v))
       return false;
 
-    auto size = as_index(rd<uint64_t>(v, 0));
-    v         = read(size);
+    value = u8string_view(reinterpret_cast<const char8_t *>(v.data()),
+                          v.size());
+    return true;
+  }
 
-    if (v.size() != size)
+  template <typename reader_>
+  static auto read_uint(reader_ &in, ref_family value) -> bool {
+    auto v = span_cbyte {};
+
+    if (!in.read(8, v))
       return false;
 
-    value = v;
+    value = rd<uint64_t>(v, 0);
     return true;
   }
 
-  static auto read_bitfield(fn_read read, ref_family value) -> bool {
-    auto v = read(2);
+  template <typename reader_>
+  static auto read_bytes(reader_ &in, ref_family value) -> bool {
+    auto size = sl::whole {};
+    auto v    = span_cbyte {};
 
-    if (v.size() != 2)
+    if (!read_size(in, size) || !in.read(size, v))
       return false;
 
-    const auto size       = rd<uint16_t>(v, 0);
-    const auto byte_count = (size + 7u) / 8u;
+    value = v;
+    return true;
+  }
 
-    v = read(byte_count);
+  template <typename reader_>
+  static auto read_bitfield(reader_ &in, ref_family value) -> bool {
+    auto size = sl::whole {};
+    auto v    = span_cbyte {};
 
-    if (v.size() != byte_count)
+    if (!read_size(in, size) || !in.read((size + 7) / 8, v))
       return false;
 
-    value = family {};
+    auto bits = vfamily {};
+    bits.reserve(size);
 
-    auto i = sl::index {};
-    auto n = sl::index {};
-    auto k = sl::index {};
-
-    for (i = 0, n = 0; i < size; n++) {
-      for (k = 0; k < 8 && i < size; k++, i++) {
-        if (n >= v.size()) {
-          return false;
-        }
-
-        value[i] = (v[n] & (0x80 >> k)) ? true : false;
-      }
+    for (sl::index i = 0; i < size; i++) {
+      bits.emplace_back((v[i / 8] & (0x80 >> (i % 8))) != 0);
     }
 
+    value = std::move(bits);
     return true;
   }
 
-  static auto read_pack(fn_read read, ref_family value) -> bool;
+  template <typename reader_>
+  static auto read_pack(reader_ &in, ref_family value) -> bool;
 
-  static auto read_vector(fn_read read, ref_family value) -> bool {
-    auto v = read(8);
+  template <typename reader_>
+  static auto read_vector(reader_ &in, ref_family value) -> bool {
+    auto size = sl::whole {};
 
-    if (v.size() != 8)
+    if (!read_size(in, size))
       return false;
 
-    auto size = rd<uint64_t>(v, 0);
-
-    value = family {};
+    /*  Each field is at least one byte.
+     */
+    auto fields = vfamily {};
+    fields.reserve(min(size, in.get_left()));
 
     for (sl::index i = 0; i < size; i++) {
-      family field;
-
-      if (!read_pack(read, field))
+      if (!read_pack(in, fields.emplace_back()))
         return false;
-
-      value[i] = field;
     }
 
+    value = std::move(fields);
     return true;
   }
 
-  static auto read_composite(fn_read read, ref_family value) -> bool {
-    auto v = read(8);
+  /*  The keys are written in order, so the fields are moved into
+   *  the composite as is. Otherwise they are inserted by key and
+   *  the last one wins.
+   */
+  static void assign_fields(ref_family value, composite &&fields,
+                            bool is_ordered) {
+    if (is_ordered) {
+      value = std::move(fields);
+      return;
+    }
+
+    value = family {};
+
+    for (auto &field : fields) {
+      value[field.first] = std::move(field.second);
+    }
+  }
+
+  template <typename reader_>
+  static auto read_composite(reader_ &in, ref_family value) -> bool {
+    auto size = sl::whole {};
 
-    if (v.size() != 8)
+    if (!read_size(in, size))
       return false;
 
-    auto size = rd<uint64_t>(v, 0);
+    auto fields     = composite {};
+    auto is_ordered = true;
 
-    value = family {};
+    fields.reserve(min(size, in.get_left() / 2));
 
     for (sl::index i = 0; i < size; i++) {
-      family key;
-      family field;
+      auto &field = fields.emplace_back();
 
-      if (!read_pack(read, key))
+      if (!read_pack(in, field.first))
         return false;
-      if (!read_pack(read, field))
+      if (!read_pack(in, field.second))
         return false;
 
-      value[key] = field;
+      if (i > 0 && fields[i - 1].first.compare(field.first) >= 0)
+        is_ordered = false;
     }
 
+    assign_fields(value, std::move(fields), is_ordered);
     return true;
   }
 
-  static auto read_compact_composite(fn_read read, ref_family value)
+  template <typename reader_>
+  static auto read_compact_composite(reader_ &in, ref_family value)
       -> bool {
-    auto v = read(8);
+    auto size = sl::whole {};
 
-    if (v.size() != 8)
+    if (!read_size(in, size))
       return false;
 
-    auto size = rd<uint64_t>(v, 0);
+    auto fields     = composite {};
+    auto is_ordered = true;
+    auto last       = uint64_t {};
 
-    value = family {};
+    fields.reserve(min(size, in.get_left() / 9));
 
     for (sl::index i = 0; i < size; i++) {
-      family field;
+      auto v = span_cbyte {};
 
-      if (!read_pack(read, field))
+      if (!in.read(8, v))
         return false;
 
-      value.by_key(i) = field;
+      const auto key = rd<uint64_t>(v, 0);
+
+      if (i > 0 && key <= last)
+        is_ordered = false;
+
+      last = key;
+
+      auto &field = fields.emplace_back(
+          static_cast<signed long long>(key), family {});
+
+      if (!read_pack(in, field.second))
+        return false;
     }
 
+    assign_fields(value, std::move(fields), is_ordered);
     return true;
   }
 
-  static auto read_pack(fn_read read, ref_family value) -> bool {
-    auto v = read(1);
+  template <typename reader_>
+  static auto read_container(reader_ &in, uint8_t id,
+                             ref_family value) -> bool {
+    if (id == ids::vector)
+      return read_vector(in, value);
+    if (id == ids::composite)
+      return read_composite(in, value);
+    if (id == ids::compact_composite)
+      return read_compact_composite(in, value);
+
+    return false;
+  }
+
+  template <typename reader_>
+  static auto read_pack(reader_ &in, ref_family value) -> bool {
+    auto v = span_cbyte {};
 
-    if (v.size() != 1)
+    if (!in.read(1, v))
       return false;
 
     auto id = v[0];
 
-    if (id == ids::bool_true)
+    if (id == ids::bool_true) {
       value = true;
-    else if (id == ids::bool_false)
+      return true;
+    }
+
+    if (id == ids::bool_false) {
       value = false;
+      return true;
+    }
 
-    else if (id != ids::empty) {
+    if (id != ids::empty) {
       if (id == ids::integer)
-        return read_int(read, value);
+        return read_int(in, value);
       if (id == ids::string)
-        return read_string(read, value);
+        return read_string(in, value);
       if (id == ids::uint)
-        return read_uint(read, value);
+        return read_uint(in, value);
       if (id == ids::bytes)
-        return read_bytes(read, value);
+        return read_bytes(in, value);
       if (id == ids::bitfield)
-        return read_bitfield(read, value);
+        return read_bitfield(in, value);
 
-      if (id == ids::vector)
-        return read_vector(read, value);
-      if (id == ids::composite)
-        return read_composite(read, value);
-      if (id == ids::compact_composite)
-        return read_compact_composite(read, value);
+      if (!in.enter())
+        return false;
 
-      return false;
+      const auto status = read_container(in, id, value);
+      in.leave();
+
+      return status;
     }
 
     value = family {};
@@ -301,13 +455,565 @@ namespace laplace::format::binary {
   auto decode(fn_read read) -> pack_type {
     auto result = make_shared<family>();
 
-    if (read && read_pack(read, *result)) {
+    if (read) {
+      auto in = stream_reader { std::move(read) };
+
+      if (read_pack(in, *result)) {
+        return result;
+      }
+    }
+
+    return make_shared<family>();
+  }
+
+  auto decode(span_cbyte data) -> pack_type {
+    auto result = make_shared<family>();
+    auto in     = span_reader { data };
+
+    if (read_pack(in, *result)) {
       return result;
     }
 
     return make_shared<family>();
   }
 
+  /*  Scalar key for the ordering. The rank is the family type
+   *  order.
+   */
+  struct frozen_key {
+    int        rank   = 0;
+    uint64_t   number = 0;
+    span_cbyte data;
+  };
+
+  static auto as_bytes(u8string_view s) noexcept -> span_cbyte {
+    return { reinterpret_cast<const uint8_t *>(s.data()), s.size() };
+  }
+
+  /*  Integers in the common range are both int and uint, so
+   *  the type is checked by comparison.
+   */
+  static auto key_of(cref_family key) noexcept -> frozen_key {
+    if (key.is_uint() && key == family(key.get_uint()))
+      return { .rank = 1, .number = key.get_uint() };
+    if (key.is_boolean())
+      return { .rank = 2, .number = key.get_boolean() ? 1u : 0u };
+    if (key.is_integer())
+      return { .rank   = 3,
+               .number = static_cast<uint64_t>(key.get_integer()) };
+    if (key.is_real())
+      return { .rank = 4 };
+    if (key.is_string())
+      return { .rank = 5, .data = as_bytes(key.get_string()) };
+    if (key.is_bytes())
+      return { .rank = 6, .data = key.get_bytes() };
+    if (key.is_vector())
+      return { .rank = 7 };
+    if (key.is_composite())
+      return { .rank = 8 };
+    return {};
+  }
+
+  /*  The node types are the ranks.
+   */
+  template <typename node_>
+  static auto key_of(const node_ &key, span_cbyte data) noexcept
+      -> frozen_key {
+    const auto rank = static_cast<int>(key.type);
+
+    if (rank == 5 || rank == 6)
+      return { .rank = rank,
+               .data = data.subspan(key.value, key.size) };
+
+    return { .rank   = rank,
+             .number = static_cast<uint64_t>(key.value) };
+  }
+
+  /*  Reals are never decoded and containers are not compared.
+   */
+  static auto is_comparable(const frozen_key &key) noexcept -> bool {
+    return key.rank != 4 && key.rank < 7;
+  }
+
+  static auto compare(const frozen_key &a,
+                      const frozen_key &b) noexcept -> int {
+    if (a.rank != b.rank)
+      return a.rank < b.rank ? -1 : 1;
+
+    if (a.rank == 3) {
+      const auto x = static_cast<int64_t>(a.number);
+      const auto y = static_cast<int64_t>(b.number);
+      return x < y ? -1 : x > y ? 1 : 0;
+    }
+
+    if (a.rank == 5 || a.rank == 6) {
+      const auto n = min(a.data.size(), b.data.size());
+
+      if (n > 0) {
+        if (auto c = memcmp(a.data.data(), b.data.data(), n); c != 0)
+          return c < 0 ? -1 : 1;
+      }
+
+      return a.data.size() < b.data.size()   ? -1
+             : a.data.size() > b.data.size() ? 1
+                                              : 0;
+    }
+
+    return a.number < b.number ? -1 : a.number > b.number ? 1 : 0;
+  }
+
+  /*  Builds the frozen tree. The children of a container are
+   *  allocated together and then read one by one.
+   */
+  class frozen_reader {
+  public:
+    using node      = frozen_tree::node;
+    using node_type = frozen_tree::node_type;
+
+    static constexpr auto t_bool      = frozen_tree::t_bool;
+    static constexpr auto t_int       = frozen_tree::t_int;
+    static constexpr auto t_uint      = frozen_tree::t_uint;
+    static constexpr auto t_string    = frozen_tree::t_string;
+    static constexpr auto t_bytes     = frozen_tree::t_bytes;
+    static constexpr auto t_vector    = frozen_tree::t_vector;
+    static constexpr auto t_composite = frozen_tree::t_composite;
+
+    static auto decode(span_cbyte data) -> frozen_tree {
+      auto tree = frozen_tree {};
+
+      tree.m_data = data;
+      tree.m_nodes.resize(1);
+
+      if (frozen_reader { tree }.read(0)) {
+        return tree;
+      }
+
+      return {};
+    }
+
+  private:
+    explicit frozen_reader(frozen_tree &tree) noexcept :
+        m_tree(tree), m_in(tree.m_data) { }
+
+    [[nodiscard]] auto read_size(sl::whole &size) -> bool {
+      return binary::read_size(m_in, size) &&
+             size <= numeric_limits<uint32_t>::max();
+    }
+
+    [[nodiscard]] auto read_number(node_type type, sl::index n)
+        -> bool {
+      auto v = span_cbyte {};
+
+      if (!m_in.read(8, v))
+        return false;
+
+      m_tree.m_nodes[n] = { .value = rd<int64_t>(v, 0),
+                            .type  = type };
+      return true;
+    }
+
+    [[nodiscard]] auto read_data(node_type type, sl::index n)
+        -> bool {
+      auto size = sl::whole {};
+      auto v    = span_cbyte {};
+
+      if (!read_size(size) || !m_in.read(size, v))
+        return false;
+
+      m_tree.m_nodes[n] = { .value = v.data() - m_tree.m_data.data(),
+                            .size  = static_cast<uint32_t>(size),
+                            .type  = type };
+      return true;
+    }
+
+    /*  Returns the first child index.
+     */
+    [[nodiscard]] auto allocate(sl::index n, node_type type,
+                                sl::whole size, sl::whole count)
+        -> sl::index {
+      const auto first = static_cast<sl::index>(
+          m_tree.m_nodes.size());
+
+      m_tree.m_nodes.resize(first + count);
+      m_tree.m_nodes[n] = { .value = first,
+                            .size  = static_cast<uint32_t>(size),
+                            .type  = type };
+      return first;
+    }
+
+    [[nodiscard]] auto read_bitfield(sl::index n) -> bool {
+      auto size = sl::whole {};
+      auto v    = span_cbyte {};
+
+      if (!read_size(size) || !m_in.read((size + 7) / 8, v))
+        return false;
+
+      const auto first = allocate(n, t_vector, size, size);
+
+      for (sl::index i = 0; i < size; i++) {
+        m_tree.m_nodes[first + i] = {
+          .value = (v[i / 8] & (0x80 >> (i % 8))) != 0 ? 1 : 0,
+          .type  = t_bool
+        };
+      }
+
+      return true;
+    }
+
+    [[nodiscard]] auto read_vector(sl::index n) -> bool {
+      auto size = sl::whole {};
+
+      /*  Each field is at least one byte.
+       */
+      if (!read_size(size) || size > m_in.get_left())
+        return false;
+
+      const auto first = allocate(n, t_vector, size, size);
+
+      for (sl::index i = 0; i < size; i++) {
+        if (!read(first + i))
+          return false;
+      }
+
+      return true;
+    }
+
+    [[nodiscard]] auto is_after(sl::index prev, sl::index key) const
+        noexcept -> bool {
+      const auto a = key_of(m_tree.m_nodes[prev], m_tree.m_data);
+      const auto b = key_of(m_tree.m_nodes[key], m_tree.m_data);
+
+      return is_comparable(a) && is_comparable(b) &&
+             compare(a, b) < 0;
+    }
+
+    [[nodiscard]] auto read_composite(sl::index n) -> bool {
+      auto size = sl::whole {};
+
+      if (!read_size(size) || size > m_in.get_left() / 2)
+        return false;
+
+      const auto first = allocate(n, t_composite, size, size * 2);
+
+      for (sl::index i = 0; i < size; i++) {
+        const auto key = first + i * 2;
+
+        if (!read(key) || !read(key + 1))
+          return false;
+
+        if (i > 0 && !is_after(key - 2, key))
+          m_tree.m_nodes[n].is_ordered = false;
+      }
+
+      return true;
+    }
+
+    [[nodiscard]] auto read_compact_composite(sl::index n) -> bool {
+      auto size = sl::whole {};
+
+      if (!read_size(size) || size > m_in.get_left() / 9)
+        return false;
+
+      const auto first = allocate(n, t_composite, size, size * 2);
+
+      for (sl::index i = 0; i < size; i++) {
+        const auto key = first + i * 2;
+
+        if (!read_number(t_int, key) || !read(key + 1))
+          return false;
+
+        if (i > 0 && !is_after(key - 2, key))
+          m_tree.m_nodes[n].is_ordered = false;
+      }
+
+      return true;
+    }
+
+    [[nodiscard]] auto read(sl::index n) -> bool {
+      auto v = span_cbyte {};
+
+      if (!m_in.read(1, v))
+        return false;
+
+      auto id = v[0];
+
+      if (id == ids::empty)
+        return true;
+
+      if (id == ids::bool_true || id == ids::bool_false) {
+        m_tree.m_nodes[n] = {
+          .value = id == ids::bool_true ? 1 : 0, .type = t_bool
+        };
+        return true;
+      }
+
+      if (id == ids::integer)
+        return read_number(t_int, n);
+      if (id == ids::string)
+        return read_data(t_string, n);
+      if (id == ids::uint)
+        return read_number(t_uint, n);
+      if (id == ids::bytes)
+        return read_data(t_bytes, n);
+      if (id == ids::bitfield)
+        return read_bitfield(n);
+
+      if (m_depth >= max_depth)
+        return false;
+
+      m_depth++;
+      const auto status = read_container(id, n);
+      m_depth--;
+
+      return status;
+    }
+
+    [[nodiscard]] auto read_container(uint8_t id, sl::index n)
+        -> bool {
+      if (id == ids::vector)
+        return read_vector(n);
+      if (id == ids::composite)
+        return read_composite(n);
+      if (id == ids::compact_composite)
+        return read_compact_composite(n);
+
+      return false;
+    }
+
+    frozen_tree &m_tree;
+    span_reader  m_in;
+    sl::whole    m_depth = 0;
+  };
+
+  auto decode_frozen(span_cbyte data) -> frozen_tree {
+    return frozen_reader::decode(data);
+  }
+
+  auto frozen_tree::get_root() const noexcept -> frozen_view {
+    return { this, m_nodes.empty() ? -1 : 0 };
+  }
+
+  auto frozen_tree::get_node_count() const noexcept -> sl::whole {
+    return static_cast<sl::whole>(m_nodes.size());
+  }
+
+  frozen_view::frozen_view(const frozen_tree *tree,
+                           sl::index          n) noexcept :
+      m_tree(tree), m_node(n) { }
+
+  auto frozen_view::is_empty() const noexcept -> bool {
+    return get_node().type == frozen_tree::t_empty;
+  }
+
+  auto frozen_view::is_boolean() const noexcept -> bool {
+    return get_node().type == frozen_tree::t_bool;
+  }
+
+  auto frozen_view::is_integer() const noexcept -> bool {
+    if (get_node().type == frozen_tree::t_uint) {
+      return get_node().value >= 0;
+    }
+
+    return get_node().type == frozen_tree::t_int;
+  }
+
+  auto frozen_view::is_uint() const noexcept -> bool {
+    if (get_node().type == frozen_tree::t_int) {
+      return get_node().value >= 0;
+    }
+
+    return get_node().type == frozen_tree::t_uint;
+  }
+
+  auto frozen_view::is_string() const noexcept -> bool {
+    return get_node().type == frozen_tree::t_string;
+  }
+
+  auto frozen_view::is_bytes() const noexcept -> bool {
+    return get_node().type == frozen_tree::t_bytes;
+  }
+
+  auto frozen_view::is_vector() const noexcept -> bool {
+    return get_node().type == frozen_tree::t_vector;
+  }
+
+  auto frozen_view::is_composite() const noexcept -> bool {
+    return get_node().type == frozen_tree::t_composite;
+  }
+
+  auto frozen_view::get_boolean() const noexcept -> bool {
+    return is_boolean() && get_node().value != 0;
+  }
+
+  auto frozen_view::get_integer() const noexcept -> signed long long {
+    return is_integer() ? get_node().value : 0;
+  }
+
+  auto frozen_view::get_uint() const noexcept -> unsigned long long {
+    return is_uint() ? static_cast<uint64_t>(get_node().value) : 0;
+  }
+
+  auto frozen_view::get_string() const noexcept -> u8string_view {
+    if (!is_string()) {
+      return {};
+    }
+
+    const auto p = m_tree->m_data.data() + get_node().value;
+    return { reinterpret_cast<const char8_t *>(p), get_node().size };
+  }
+
+  auto frozen_view::get_bytes() const noexcept -> span_cbyte {
+    if (!is_bytes()) {
+      return {};
+    }
+
+    return m_tree->m_data.subspan(get_node().value, get_node().size);
+  }
+
+  auto frozen_view::get_size() const noexcept -> sl::whole {
+    return is_vector() || is_composite() ? get_node().size : 0;
+  }
+
+  auto frozen_view::has(cref_family key) const noexcept -> bool {
+    return find(key) >= 0;
+  }
+
+  auto frozen_view::get_key(sl::index n) const noexcept
+      -> frozen_view {
+    if (!is_composite() || n < 0 || n >= get_size()) {
+      return {};
+    }
+
+    return child(n * 2);
+  }
+
+  auto frozen_view::get_value(sl::index n) const noexcept
+      -> frozen_view {
+    if (n < 0 || n >= get_size()) {
+      return {};
+    }
+
+    return child(is_composite() ? n * 2 + 1 : n);
+  }
+
+  auto frozen_view::get_value(cref_family key) const noexcept
+      -> frozen_view {
+    const auto n = find(key);
+    return n >= 0 ? child(n * 2 + 1) : frozen_view {};
+  }
+
+  auto frozen_view::operator[](sl::index n) const noexcept
+      -> frozen_view {
+    return get_value(n);
+  }
+
+  auto frozen_view::operator[](cref_family key) const noexcept
+      -> frozen_view {
+    return get_value(key);
+  }
+
+  auto frozen_view::thaw() const noexcept -> family {
+    const auto type = get_node().type;
+
+    if (type == frozen_tree::t_bool)
+      return get_boolean();
+    if (type == frozen_tree::t_int)
+      return get_node().value;
+    if (type == frozen_tree::t_uint)
+      return static_cast<unsigned long long>(get_node().value);
+    if (is_string())
+      return get_string();
+    if (is_bytes())
+      return get_bytes();
+
+    if (is_vector()) {
+      auto fields = vfamily {};
+      fields.reserve(get_size());
+
+      for (sl::index i = 0; i < get_size(); i++) {
+        fields.emplace_back(child(i).thaw());
+      }
+
+      return fields;
+    }
+
+    if (is_composite()) {
+      auto fields = composite {};
+      fields.reserve(get_size());
+
+      for (sl::index i = 0; i < get_size(); i++) {
+        fields.emplace_back(child(i * 2).thaw(),
+                            child(i * 2 + 1).thaw());
+      }
+
+      auto value = family {};
+      assign_fields(value, std::move(fields), get_node().is_ordered);
+      return value;
+    }
+
+    return {};
+  }
+
+  auto frozen_view::get_node() const noexcept -> const node & {
+    static const auto empty = node {};
+
+    if (m_tree == nullptr || m_node < 0) {
+      return empty;
+    }
+
+    return m_tree->m_nodes[m_node];
+  }
+
+  auto frozen_view::child(sl::index n) const noexcept -> frozen_view {
+    return { m_tree, static_cast<sl::index>(get_node().value) + n };
+  }
+
+  auto frozen_view::find(cref_family key) const noexcept
+      -> sl::index {
+    const auto k = key_of(key);
+
+    if (!is_composite() || !is_comparable(k)) {
+      return -1;
+    }
+
+    const auto key_at = [&](sl::index n) {
+      return key_of(child(n * 2).get_node(), m_tree->m_data);
+    };
+
+    const auto size = get_size();
+
+    if (get_node().is_ordered) {
+      auto begin = sl::index {};
+      auto end   = size;
+
+      while (begin < end) {
+        const auto n = begin + (end - begin) / 2;
+
+        if (compare(key_at(n), k) < 0) {
+          begin = n + 1;
+        } else {
+          end = n;
+        }
+      }
+
+      if (begin < size && compare(key_at(begin), k) == 0) {
+        return begin;
+      }
+
+      return -1;
+    }
+
+    for (auto n = size - 1; n >= 0; n--) {
+      const auto other = key_at(n);
+
+      if (is_comparable(other) && compare(other, k) == 0) {
+        return n;
+      }
+    }
+
+    return -1;
+  }
+
   static auto write_empty(fn_write write) -> bool {
     return write(vbyte { ids::empty }) == 1;
   }
@@ -378,7 +1084,7 @@ namespace laplace::format::binary {
 
     vbyte v(9);
     wr<uint8_t>(v, 0, ids::bitfield);
-    wr<uint64_t>(v, 1, bytes.size());
+    wr<uint64_t>(v, 1, size);
     v.insert(v.end(), bytes.begin(), bytes.end());
     return write(v) == v.size();
   }
@@ -473,7 +1179,7 @@ namespace laplace::format::binary {
     }
 
     auto v = vbyte(9);
-    wr<uint8_t>(v, 0, ids::compact_composite);
+    wr<uint8_t>(v, 0, ids::composite);
     wr<uint64_t>(v, 1, value.get_size());
 
     if (write(v) != v.size()) {
@@ -514,10 +1220,10 @@ namespace laplace::format::binary {
   }
 
   auto encode(fn_write write, const_pack_type data) -> bool {
-    if (data && write) {
+    if (write) {
       family packed = data;
       pack(packed);
-      writedown(write, packed);
+      return writedown(write, packed);
     }
 
     return false;
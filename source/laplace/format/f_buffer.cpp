@@ -15,6 +15,8 @@
 #include <algorithm>
 
 namespace laplace::format {
+  using std::min;
+
   buffer::buffer(fn_read read) {
     m_read   = read;
     m_offset = 0;
@@ -34,9 +36,11 @@ namespace laplace::format {
     }
 
     auto p = m_data.begin() + m_offset;
-    m_offset += m_data.size();
+    auto n = min<sl::whole>(count, m_data.size() - m_offset);
+
+    m_offset += n;
 
-    return vbyte(p, p + count);
+    return vbyte(p, p + n);
   }
 
   void buffer::keep() {
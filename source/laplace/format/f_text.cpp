@@ -14,12 +14,55 @@
 
 #include "../core/parser.h"
 #include "../core/utils.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 
 namespace laplace::format::text {
   using std::make_shared, std::string, std::u8string, core::parser,
-      core::family, std::function, std::ostringstream, std::hex;
+      core::family, std::function, std::ostringstream, std::hex,
+      std::u8string_view, std::array, std::from_chars, std::errc,
+      std::to_chars, std::stable_sort, std::endian, std::countr_zero,
+      std::setw, std::setfill, core::vfamily, core::composite,
+      std::string_view, std::isnan, std::isinf;
+
+  /*  Backslash escapes the next char in a quoted string.
+   */
+  static auto unescape(u8string_view s) -> u8string {
+    auto r = u8string {};
+    r.reserve(s.size());
+
+    for (sl::index i = 0; i < s.size(); i++) {
+      if (s[i] == u8'\\' && i + 1 < s.size()) {
+        i++;
+      }
+
+      r.append(1, s[i]);
+    }
+
+    return r;
+  }
+
+  static auto escape(string_view s) -> string {
+    auto r = string { '"' };
+    r.reserve(s.size() + 2);
+
+    for (const auto c : s) {
+      if (c == '"' || c == '\\') {
+        r.append(1, '\\');
+      }
+
+      r.append(1, c);
+    }
+
+    r.append(1, '"');
+    return r;
+  }
 
   static bool parse(parser &in, family &f) {
     bool result = true;
@@ -43,7 +86,7 @@ namespace laplace::format::text {
     } else if (in.parse(" %f ", &x_f)) {
       field = x_f;
     } else if (in.parse(" \"%s\" ", &x_s)) {
-      field = x_s;
+      field = unescape(x_s);
     } else if (in.parse(" %a ", &x_s)) {
       auto id = family(x_s);
 
@@ -166,7 +209,7 @@ namespace laplace::format::text {
     return result;
   }
 
-  auto decode(fn_read read) -> pack_type {
+  auto decode_by_char(fn_read read) -> pack_type {
     auto result = pack_type {};
 
     if (read) {
@@ -187,6 +230,538 @@ namespace laplace::format::text {
     return result;
   }
 
+  enum char_class : uint8_t {
+    c_space    = 1,
+    c_digit    = 2,
+    c_hex      = 4,
+    c_id_first = 8,
+    c_id       = 16
+  };
+
+  static constexpr auto char_classes = []() {
+    auto t = array<uint8_t, 256> {};
+
+    t[' '] = t['\t'] = t['\r'] = t['\n'] = c_space;
+
+    for (int c = '0'; c <= '9'; c++) t[c] = c_digit | c_hex | c_id;
+    for (int c = 'a'; c <= 'z'; c++) t[c] = c_id_first | c_id;
+    for (int c = 'A'; c <= 'Z'; c++) t[c] = c_id_first | c_id;
+    for (int c = 'a'; c <= 'f'; c++) t[c] |= c_hex;
+    for (int c = 'A'; c <= 'F'; c++) t[c] |= c_hex;
+
+    t['_'] = c_id_first | c_id;
+
+    return t;
+  }();
+
+  static auto is_class(uint8_t c, uint8_t mask) noexcept -> bool {
+    return (char_classes[c] & mask) != 0;
+  }
+
+  /*  Sets the high bit of each byte of the word that is equal
+   *  to c. Exact for every byte, no carry between bytes.
+   */
+  static auto bytes_equal(uint64_t w, uint8_t c) noexcept
+      -> uint64_t {
+    constexpr auto low = uint64_t { 0x7f7f7f7f7f7f7f7f };
+    constexpr auto one = uint64_t { 0x0101010101010101 };
+
+    const auto x = w ^ (one * c);
+    return ~(((x & low) + low) | x | low);
+  }
+
+  static auto load_word(const uint8_t *p) noexcept -> uint64_t {
+    auto w = uint64_t {};
+    memcpy(&w, p, sizeof w);
+    return w;
+  }
+
+  /*  Reads the text in place from a contiguous UTF-8 buffer.
+   *  The grammar is the same as in parse above. Strings are
+   *  copied once, and unescaped only if they have a backslash.
+   */
+  class text_reader {
+  public:
+    explicit text_reader(span_cbyte data) noexcept :
+        m_pos(data.data()), m_end(data.data() + data.size()) { }
+
+    /*  Reads a value, or a comma list of values as a vector.
+     */
+    auto read_list(family &f) -> bool {
+      auto field = family {};
+
+      if (!read_value(field)) {
+        return false;
+      }
+
+      if (!skip(',')) {
+        f = std::move(field);
+        return true;
+      }
+
+      auto v = vfamily {};
+      v.emplace_back(std::move(field));
+
+      do {
+        if (!read_value(v.emplace_back())) {
+          return false;
+        }
+      } while (skip(','));
+
+      f = std::move(v);
+      return true;
+    }
+
+    /*  Checks that only the whitespace is left.
+     */
+    [[nodiscard]] auto is_end() noexcept -> bool {
+      skip_space();
+      return m_pos == m_end;
+    }
+
+  private:
+    static constexpr bool is_word_scan = endian::native ==
+                                         endian::little;
+
+    /*  Deeper text is rejected to keep the recursion bounded.
+     */
+    static constexpr sl::whole max_depth = 256;
+
+    /*  Skips the whitespace by words of 8 bytes.
+     */
+    void skip_space() noexcept {
+      if (m_pos == m_end || !is_class(*m_pos, c_space)) {
+        return;
+      }
+
+      if constexpr (is_word_scan) {
+        constexpr auto high = uint64_t { 0x8080808080808080 };
+
+        while (m_end - m_pos >= 8) {
+          const auto w     = load_word(m_pos);
+          const auto space = bytes_equal(w, ' ') |
+                             bytes_equal(w, '\t') |
+                             bytes_equal(w, '\n') |
+                             bytes_equal(w, '\r');
+
+          if (const auto other = ~space & high; other != 0) {
+            m_pos += countr_zero(other) / 8;
+            return;
+          }
+
+          m_pos += 8;
+        }
+      }
+
+      while (m_pos < m_end && is_class(*m_pos, c_space)) { m_pos++; }
+    }
+
+    /*  Returns the first quote or backslash, or the end.
+     */
+    [[nodiscard]] auto find_quote(const uint8_t *p) const noexcept
+        -> const uint8_t * {
+      if constexpr (is_word_scan) {
+        while (m_end - p >= 8) {
+          const auto w     = load_word(p);
+          const auto quote = bytes_equal(w, '"') |
+                             bytes_equal(w, '\\');
+
+          if (quote != 0) {
+            return p + countr_zero(quote) / 8;
+          }
+
+          p += 8;
+        }
+      }
+
+      while (p < m_end && *p != '"' && *p != '\\') { p++; }
+      return p;
+    }
+
+    [[nodiscard]] auto skip(uint8_t c) noexcept -> bool {
+      skip_space();
+
+      if (m_pos < m_end && *m_pos == c) {
+        m_pos++;
+        return true;
+      }
+
+      return false;
+    }
+
+    [[nodiscard]] auto view(const uint8_t *begin,
+                            const uint8_t *end) const noexcept
+        -> u8string_view {
+      return { reinterpret_cast<const char8_t *>(begin),
+               static_cast<size_t>(end - begin) };
+    }
+
+    auto read_value(family &f) -> bool {
+      skip_space();
+
+      if (m_pos == m_end) {
+        return false;
+      }
+
+      const auto c = *m_pos;
+
+      if (c == '"') {
+        return read_string(f);
+      }
+
+      if (c == ':') {
+        return read_bytes(f);
+      }
+
+      if (c != '(' && c != '{' && !is_class(c, c_id_first)) {
+        return read_number(f);
+      }
+
+      if (m_depth >= max_depth) {
+        return false;
+      }
+
+      m_depth++;
+      const auto status = read_nested(c, f);
+      m_depth--;
+
+      return status;
+    }
+
+    /*  Tuples, composites and names, which may be calls.
+     */
+    auto read_nested(uint8_t c, family &f) -> bool {
+      if (c == '(') {
+        m_pos++;
+        return read_tuple(f);
+      }
+
+      if (c == '{') {
+        m_pos++;
+        return read_composite(f);
+      }
+
+      return read_name(f);
+    }
+
+    auto read_number(family &f) -> bool {
+      const auto first = reinterpret_cast<const char *>(m_pos);
+      const auto last  = reinterpret_cast<const char *>(m_end);
+
+      const auto sign = *m_pos == '+' || *m_pos == '-' ? *m_pos : 0;
+      const auto p    = sign != 0 ? first + 1 : first;
+
+      if (sign == 0 && last - p >= 3 && p[0] == '0' && p[1] == 'x' &&
+          is_class(p[2], c_hex)) {
+        auto x = uint64_t {};
+        auto r = from_chars(p + 2, last, x, 16);
+
+        if (r.ec != errc {}) {
+          return false;
+        }
+
+        m_pos = reinterpret_cast<const uint8_t *>(r.ptr);
+        f     = x;
+        return true;
+      }
+
+      if (sign != 0 && last - p >= 3 &&
+          (memcmp(p, "inf", 3) == 0 || memcmp(p, "nan", 3) == 0)) {
+        auto x = double {};
+        auto r = from_chars(sign == '-' ? first : p, last, x);
+
+        if (r.ec != errc {}) {
+          return false;
+        }
+
+        m_pos = reinterpret_cast<const uint8_t *>(r.ptr);
+        f     = x;
+        return true;
+      }
+
+      auto q = p;
+      while (q < last && is_class(*q, c_digit)) { q++; }
+
+      const auto is_real = q < last &&
+                           (*q == '.' || *q == 'e' || *q == 'E');
+
+      if (q == p && !is_real) {
+        return false;
+      }
+
+      if (!is_real) {
+        /*  Out of range integers are read as reals.
+         */
+
+        if (sign == 0) {
+          auto x = uint64_t {};
+
+          if (from_chars(p, q, x).ec == errc {}) {
+            m_pos = reinterpret_cast<const uint8_t *>(q);
+            f     = x;
+            return true;
+          }
+        } else {
+          auto x = int64_t {};
+
+          if (from_chars(sign == '-' ? first : p, q, x).ec ==
+              errc {}) {
+            m_pos = reinterpret_cast<const uint8_t *>(q);
+            f     = x;
+            return true;
+          }
+        }
+      }
+
+      auto x = double {};
+      auto r = from_chars(sign == '-' ? first : p, last, x);
+
+      if (r.ec != errc {} && r.ec != errc::result_out_of_range) {
+        return false;
+      }
+
+      m_pos = reinterpret_cast<const uint8_t *>(r.ptr);
+      f     = x;
+      return true;
+    }
+
+    auto read_string(family &f) -> bool {
+      const auto begin      = m_pos + 1;
+      auto       p          = find_quote(begin);
+      auto       is_escaped = false;
+
+      while (p < m_end && *p == '\\') {
+        if (m_end - p < 2) {
+          return false;
+        }
+
+        is_escaped = true;
+        p          = find_quote(p + 2);
+      }
+
+      if (p == m_end) {
+        return false;
+      }
+
+      if (is_escaped) {
+        f = unescape(view(begin, p));
+      } else {
+        f = view(begin, p);
+      }
+
+      m_pos = p + 1;
+      return true;
+    }
+
+    auto read_name(family &f) -> bool {
+      const auto begin = m_pos;
+
+      while (m_pos < m_end && is_class(*m_pos, c_id)) { m_pos++; }
+
+      const auto name = view(begin, m_pos);
+
+      if (name == u8"true") {
+        f = true;
+        return true;
+      }
+
+      if (name == u8"false") {
+        f = false;
+        return true;
+      }
+
+      if (!skip('(')) {
+        f = name;
+        return true;
+      }
+
+      auto args = family {};
+
+      if (!read_tuple(args)) {
+        return false;
+      }
+
+      f = make_call(family(name), std::move(args));
+      return true;
+    }
+
+    /*  Reads the values until the closing parenthesis. A single
+     *  value is wrapped into a vector.
+     */
+    auto read_tuple(family &f) -> bool {
+      if (skip(')')) {
+        return true;
+      }
+
+      if (!read_list(f)) {
+        return false;
+      }
+
+      if (!f.is_vector()) {
+        auto v = vfamily {};
+        v.emplace_back(std::move(f));
+        f = std::move(v);
+      }
+
+      return skip(')');
+    }
+
+    auto read_composite(family &f) -> bool {
+      auto fields   = composite {};
+      auto commands = vfamily {};
+
+      for (;;) {
+        if (skip('}')) {
+          break;
+        }
+
+        if (skip(';')) {
+          continue;
+        }
+
+        auto key = family {};
+
+        if (!read_list(key)) {
+          return false;
+        }
+
+        if (skip('(')) {
+          auto args = family {};
+
+          if (!read_tuple(args)) {
+            return false;
+          }
+
+          commands.emplace_back(
+              make_call(std::move(key), std::move(args)));
+          continue;
+        }
+
+        if (!skip('=') && !skip(':')) {
+          return false;
+        }
+
+        auto &field = fields.emplace_back(std::move(key), family {});
+
+        if (!read_list(field.second)) {
+          return false;
+        }
+      }
+
+      if (!commands.empty()) {
+        fields.emplace_back(family(s_commands),
+                            family(std::move(commands)));
+      }
+
+      f = unique_fields(std::move(fields));
+      return true;
+    }
+
+    auto read_bytes(family &f) -> bool {
+      if (m_end - m_pos < 2 || m_pos[1] != ':') {
+        return false;
+      }
+
+      m_pos += 2;
+
+      if (!skip('{')) {
+        return false;
+      }
+
+      auto v = vbyte {};
+
+      while (!skip('}')) {
+        auto x = uint64_t {};
+        auto r = from_chars(reinterpret_cast<const char *>(m_pos),
+                            reinterpret_cast<const char *>(m_end),
+                            x, 16);
+
+        if (r.ec != errc {} || x > 0xff) {
+          return false;
+        }
+
+        m_pos = reinterpret_cast<const uint8_t *>(r.ptr);
+        v.emplace_back(static_cast<uint8_t>(x));
+      }
+
+      f = span_cbyte { v };
+      return true;
+    }
+
+    static auto make_call(family name, family args) -> family {
+      auto call = composite {};
+      call.emplace_back(family(s_function), std::move(name));
+
+      if (!args.is_empty()) {
+        call.emplace_back(family(s_arguments), std::move(args));
+      }
+
+      return family(std::move(call));
+    }
+
+    /*  Sorts the fields by key. For equal keys the last one
+     *  wins, as with the insertion by key.
+     */
+    static auto unique_fields(composite &&fields) -> family {
+      stable_sort(fields.begin(), fields.end(),
+                  [](const auto &a, const auto &b) {
+                    return a.first.compare(b.first) < 0;
+                  });
+
+      auto n = sl::index {};
+
+      for (sl::index i = 0; i < fields.size(); i++) {
+        if (n > 0 && fields[n - 1].first == fields[i].first) {
+          fields[n - 1].second = std::move(fields[i].second);
+        } else {
+          if (n != i) {
+            fields[n] = std::move(fields[i]);
+          }
+          n++;
+        }
+      }
+
+      fields.erase(fields.begin() + n, fields.end());
+      return family(std::move(fields));
+    }
+
+    const uint8_t *m_pos   = nullptr;
+    const uint8_t *m_end   = nullptr;
+    sl::whole      m_depth = 0;
+  };
+
+  auto decode(span_cbyte data) -> pack_type {
+    auto result = make_shared<family>();
+    auto in     = text_reader { data };
+
+    if (!in.read_list(*result) || !in.is_end()) {
+      result.reset();
+    }
+
+    return result;
+  }
+
+  auto decode(fn_read read) -> pack_type {
+    constexpr auto chunk_size = sl::whole { 0x10000 };
+
+    if (!read) {
+      return {};
+    }
+
+    auto v = vbyte {};
+
+    for (;;) {
+      const auto chunk = read(chunk_size);
+      v.insert(v.end(), chunk.begin(), chunk.end());
+
+      if (chunk.size() < chunk_size) {
+        break;
+      }
+    }
+
+    return decode(span_cbyte { v });
+  }
+
   static bool printdown(function<bool(const char *)> print,
                         const family &f, sl::whole indent = 0) {
     if (f.is_boolean()) {
@@ -200,12 +775,31 @@ namespace laplace::format::text {
       out << f.get_uint();
       return print(out.str().c_str());
     } else if (f.is_real()) {
-      ostringstream out;
-      out << f.get_real();
-      return print(out.str().c_str());
+      /*  Shortest round trip form. The point is added to tell
+       *  the real from the integer. Infinity and NaN always have
+       *  the sign, so they are not read as names.
+       */
+      const auto x = f.get_real();
+
+      if (isnan(x)) {
+        return print("+nan");
+      }
+
+      if (isinf(x)) {
+        return print(x < 0 ? "-inf" : "+inf");
+      }
+
+      char buf[32] = {};
+      to_chars(buf, buf + sizeof buf - 3, x);
+
+      if (strpbrk(buf, ".en") == nullptr) {
+        strcat(buf, ".0");
+      }
+
+      return print(buf);
     } else if (f.is_string()) {
-      auto v = string(as_ascii_string(f.get_string()));
-      return print(v.c_str());
+      return print(
+          escape(as_ascii_string(f.get_string())).c_str());
     } else if (f.is_bytes()) {
       if (!print(":: { "))
         return false;
@@ -214,14 +808,18 @@ namespace laplace::format::text {
 
       for (sl::index i = 0; i < size; i++) {
         auto out = ostringstream {};
-        out.width(2);
-        out << hex;
-        out << f.get_bytes()[i] << " ";
-        print(out.str().c_str());
+        out << hex << setw(2) << setfill('0');
+        out << static_cast<unsigned>(f.get_bytes()[i]) << " ";
+
+        if (!print(out.str().c_str()))
+          return false;
       }
 
       return print("}");
     } else if (f.is_vector()) {
+      if (!print("("))
+        return false;
+
       auto size = f.get_size();
 
       for (sl::index i = 0; i < size; i++) {
@@ -230,6 +828,8 @@ namespace laplace::format::text {
         if (!printdown(print, f[i], indent))
           return false;
       }
+
+      return print(")");
     } else if (f.is_composite()) {
       if (!print("{\n"))
         return false;
@@ -247,6 +847,10 @@ namespace laplace::format::text {
           return false;
       }
 
+      for (sl::index n = 0; n < indent; n++)
+        if (!print("  "))
+          return false;
+
       return print("}");
     }
 
@@ -256,7 +860,7 @@ namespace laplace::format::text {
   auto encode(fn_write write, const_pack_type data) -> bool {
     bool result = false;
 
-    if (data) {
+    if (write) {
       auto print = [write](const char *s) -> bool {
         auto v = vbyte(strlen(s));
         memcpy(v.data(), s, v.size());
@@ -20,7 +20,25 @@ namespace laplace::format::text {
   static constexpr auto s_function  = u8"_function";
   static constexpr auto s_arguments = u8"_arguments";
 
+  /*  Reads the whole stream, then decodes it in place.
+   */
   auto decode(fn_read read) -> pack_type;
+
+  /*  Decode in place from UTF-8 text. Anything but whitespace
+   *  after the value is an error, as well as values nested
+   *  deeper than 256.
+   */
+  auto decode(span_cbyte data) -> pack_type;
+
+  /*  Decode with core::parser by one char. Slow, kept as the
+   *  reference for the tests and the benchmarks.
+   */
+  auto decode_by_char(fn_read read) -> pack_type;
+
+  /*  The decoded text is equal to the data. Infinity and NaN
+   *  are printed as +inf, -inf and +nan. An empty vector is
+   *  stored as an empty value, so it is printed as { }.
+   */
   auto encode(fn_write write, const_pack_type data) -> bool;
 }
 
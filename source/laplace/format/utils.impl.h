@@ -18,10 +18,9 @@ namespace laplace::format {
     return [&in](sl::index n) -> vbyte {
       if (in) {
         auto v = vbyte(n);
-        auto p = in.tellg();
         in.read(reinterpret_cast<char *>(v.data()),
                 static_cast<ptrdiff_t>(n));
-        v.resize(static_cast<sl::index>(in.tellg() - p));
+        v.resize(static_cast<sl::index>(in.gcount()));
         return v;
       }
 
@@ -0,0 +1,125 @@
+/*  laplace/graphics/flat/g2_instance_buffer.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "instance_buffer.h"
+
+#include "../../platform/gldef.h"
+
+namespace laplace::graphics::flat {
+  using namespace gl;
+  using std::span;
+
+  instance_buffer::instance_buffer() {
+    const float quad[] = { -1.f, -1.f, 1.f, -1.f,
+                           -1.f, 1.f,  1.f, 1.f };
+
+    glGenBuffers(1, &m_quad);
+    glGenBuffers(1, &m_instances);
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_quad);
+    glBufferData(GL_ARRAY_BUFFER, sizeof quad, quad,
+                 GL_STATIC_DRAW);
+  }
+
+  instance_buffer::~instance_buffer() {
+    glDeleteBuffers(1, &m_instances);
+    glDeleteBuffers(1, &m_quad);
+  }
+
+  void instance_buffer::render(span<const instance> instances) {
+    if (instances.empty()) {
+      return;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_quad);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE,
+                          2 * sizeof(float), nullptr);
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_instances);
+
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        static_cast<GLsizeiptr>(instances.size() * sizeof(instance)),
+        instances.data(), GL_STREAM_DRAW);
+
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+    glEnableVertexAttribArray(3);
+
+    glVertexAttribPointer(
+        1, 2, GL_FLOAT, GL_FALSE, sizeof(instance),
+        reinterpret_cast<const void *>(offsetof(instance, position)));
+
+    glVertexAttribPointer(
+        2, 2, GL_FLOAT, GL_FALSE, sizeof(instance),
+        reinterpret_cast<const void *>(offsetof(instance, scale)));
+
+    glVertexAttribIPointer(
+        3, 1, GL_UNSIGNED_INT, sizeof(instance),
+        reinterpret_cast<const void *>(offsetof(instance, color)));
+
+    glVertexAttribDivisor(1, 1);
+    glVertexAttribDivisor(2, 1);
+    glVertexAttribDivisor(3, 1);
+
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4,
+                          static_cast<GLsizei>(instances.size()));
+
+    /*  Other buffers use the attributes per vertex.
+     */
+    glVertexAttribDivisor(1, 0);
+    glVertexAttribDivisor(2, 0);
+    glVertexAttribDivisor(3, 0);
+
+    glDisableVertexAttribArray(2);
+    glDisableVertexAttribArray(3);
+  }
+
+  auto instance_buffer::pack(cref_vec2 min, cref_vec2 max,
+                             uint32_t color) noexcept -> instance {
+    return { .position = (min + max) * .5f,
+             .scale    = (max - min) * .5f,
+             .color    = color };
+  }
+
+  void instance_buffer::expand(span<const instance> instances,
+                               span<const vec4>     palette,
+                               sl::vector<solid_vertex> &vertices) {
+    vertices.resize(instances.size() * 6);
+
+    const auto count = instance_shader::get_palette_count(
+        static_cast<sl::whole>(palette.size()));
+
+    for (sl::index i = 0; i < instances.size(); i++) {
+      const auto &in = instances[i];
+
+      const auto color = count == 0 ? vec4 {}
+                                    : palette[in.color % count];
+
+      const auto x0 = in.position.x() - in.scale.x();
+      const auto y0 = in.position.y() - in.scale.y();
+      const auto x1 = in.position.x() + in.scale.x();
+      const auto y1 = in.position.y() + in.scale.y();
+
+      auto *v = vertices.data() + i * 6;
+
+      v[0] = { .position = { x0, y0 }, .color = color };
+      v[1] = { .position = { x1, y0 }, .color = color };
+      v[2] = { .position = { x0, y1 }, .color = color };
+      v[3] = { .position = { x1, y0 }, .color = color };
+      v[4] = { .position = { x1, y1 }, .color = color };
+      v[5] = { .position = { x0, y1 }, .color = color };
+    }
+  }
+}
@@ -0,0 +1,111 @@
+/*  laplace/graphics/flat/g2_instance_shader.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "instance_shader.h"
+
+#include "../../platform/gldef.h"
+#include <algorithm>
+#include <sstream>
+
+namespace laplace::graphics::flat {
+  using namespace gl;
+  using std::span, std::min, std::string, std::ostringstream,
+      std::to_string;
+
+  const sl::whole instance_shader::palette_size = 16;
+
+  /*  Defines the palette size after the version line.
+   */
+  static auto with_palette_size(std::istream &in) -> string {
+    auto version = string {};
+    auto rest    = ostringstream {};
+
+    std::getline(in, version);
+    rest << in.rdbuf();
+
+    return version + "\n#define PALETTE_SIZE " +
+           to_string(instance_shader::palette_size) + "\n" +
+           rest.str();
+  }
+
+  instance_shader::instance_shader(std::istream &vert,
+                                   std::istream &frag) {
+    m_program.vertex_shader(with_palette_size(vert));
+    m_program.fragment_shader(frag);
+
+    m_program.link();
+
+    m_program.use(true);
+
+    n_view_position = glGetUniformLocation( //
+        m_program.get_id(),                 //
+        "view_position");
+
+    n_view_scale = glGetUniformLocation( //
+        m_program.get_id(),              //
+        "view_scale");
+
+    n_mesh_position = glGetUniformLocation( //
+        m_program.get_id(),                 //
+        "mesh_position");
+
+    n_mesh_scale = glGetUniformLocation( //
+        m_program.get_id(),              //
+        "mesh_scale");
+
+    n_palette = glGetUniformLocation( //
+        m_program.get_id(),           //
+        "palette");
+
+    n_palette_count = glGetUniformLocation( //
+        m_program.get_id(),                 //
+        "palette_count");
+  }
+
+  void instance_shader::use() {
+    m_program.use(true);
+  }
+
+  void instance_shader::set_view_position(cref_vec2 position) {
+    glUniform2fv(n_view_position, 1, position.v);
+  }
+
+  void instance_shader::set_view_scale(cref_vec2 scale) {
+    glUniform2fv(n_view_scale, 1, scale.v);
+  }
+
+  void instance_shader::set_mesh_position(cref_vec2 position) {
+    glUniform2fv(n_mesh_position, 1, position.v);
+  }
+
+  void instance_shader::set_mesh_scale(cref_vec2 scale) {
+    glUniform2fv(n_mesh_scale, 1, scale.v);
+  }
+
+  void instance_shader::set_palette(span<const vec4> colors) {
+    static_assert(sizeof(vec4) == 4 * sizeof(float));
+
+    const auto count = get_palette_count(colors.size());
+
+    if (count > 0) {
+      glUniform4fv(n_palette, static_cast<GLsizei>(count),
+                   colors[0].v);
+    }
+
+    glUniform1ui(n_palette_count, static_cast<GLuint>(count));
+  }
+
+  auto instance_shader::get_palette_count(
+      sl::whole color_count) noexcept -> sl::whole {
+    return min(color_count, palette_size);
+  }
+}
@@ -38,6 +38,24 @@ namespace laplace::graphics::flat {
     }
   }
 
+  void solid_buffer::upload(span<const vertex> vertices) {
+    glBindBuffer(GL_ARRAY_BUFFER, m_id);
+
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        static_cast<GLsizeiptr>(vertices.size() * sizeof(vertex)),
+        vertices.data(), GL_STATIC_DRAW);
+
+    m_count = static_cast<sl::whole>(vertices.size());
+  }
+
+  void solid_buffer::render() const {
+    if (m_count > 0) {
+      glBindBuffer(GL_ARRAY_BUFFER, m_id);
+      draw(GL_TRIANGLES, m_count);
+    }
+  }
+
   void solid_buffer::render_internal(span<const vertex> vertices,
                                      uint32_t           mode) {
 
@@ -48,6 +66,11 @@ namespace laplace::graphics::flat {
         static_cast<GLsizeiptr>(vertices.size() * sizeof(vertex)),
         vertices.data(), GL_DYNAMIC_DRAW);
 
+    m_count = 0;
+    draw(mode, static_cast<sl::whole>(vertices.size()));
+  }
+
+  void solid_buffer::draw(uint32_t mode, sl::whole count) const {
     glEnableVertexAttribArray(0);
     glEnableVertexAttribArray(1);
 
@@ -59,6 +82,6 @@ namespace laplace::graphics::flat {
         1, 4, GL_FLOAT, GL_FALSE, sizeof(vertex),
         reinterpret_cast<const void *>(offsetof(vertex, color)));
 
-    glDrawArrays(mode, 0, static_cast<GLsizei>(vertices.size()));
+    glDrawArrays(mode, 0, static_cast<GLsizei>(count));
   }
 }
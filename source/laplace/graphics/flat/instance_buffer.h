@@ -0,0 +1,50 @@
+/*  laplace/graphics/flat/instance_buffer.h
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#ifndef laplace_graphics_flat_instance_buffer_h
+#define laplace_graphics_flat_instance_buffer_h
+
+#include "instance_shader.h"
+#include "solid_shader.h"
+
+namespace laplace::graphics::flat {
+  class instance_buffer {
+  public:
+    using instance     = instance_shader::instance;
+    using solid_vertex = solid_shader::vertex;
+
+    instance_buffer();
+    ~instance_buffer();
+
+    void render(std::span<const instance> instances);
+
+    /*  Pack the rectangle into an instance.
+     */
+    [[nodiscard]] static auto pack(cref_vec2 min, cref_vec2 max,
+                                   uint32_t color) noexcept
+        -> instance;
+
+    /*  Expand the instances into triangles, 6 vertices per
+     *  instance. For the case when there is no instanced draw
+     *  shader.
+     */
+    static void expand(std::span<const instance> instances,
+                       std::span<const vec4>     palette,
+                       sl::vector<solid_vertex> &vertices);
+
+  private:
+    uint32_t m_quad;
+    uint32_t m_instances;
+  };
+}
+
+#endif
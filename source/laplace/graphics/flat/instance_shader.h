@@ -0,0 +1,75 @@
+/*  laplace/graphics/flat/instance_shader.h
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#ifndef laplace_graphics_flat_instance_shader_h
+#define laplace_graphics_flat_instance_shader_h
+
+#include "../defs.h"
+#include "../program.h"
+
+namespace laplace::graphics::flat {
+  /*  Draws many copies of a shared quad. Each instance has its
+   *  own position, scale and palette color index.
+   */
+  class instance_shader {
+  public:
+    /*  The quad spans from -1 to 1 on both axes.
+     */
+    struct instance {
+      vec2     position;
+      vec2     scale;
+      uint32_t color = 0;
+    };
+
+    /*  The palette array size. It is defined as PALETTE_SIZE
+     *  for the vertex shader code.
+     */
+    static const sl::whole palette_size;
+
+    instance_shader(const instance_shader &) = delete;
+    auto operator=(const instance_shader &)
+        -> instance_shader & = delete;
+
+    instance_shader(std::istream &vert, std::istream &frag);
+
+    void use();
+
+    void set_view_position(cref_vec2 position);
+    void set_view_scale(cref_vec2 scale);
+    void set_mesh_position(cref_vec2 position);
+    void set_mesh_scale(cref_vec2 scale);
+
+    /*  Colors beyond the palette size are ignored.
+     */
+    void set_palette(std::span<const vec4> colors);
+
+    /*  The color index wraps at this count, both in the shader
+     *  and in instance_buffer::expand.
+     */
+    [[nodiscard]] static auto get_palette_count(
+        sl::whole color_count) noexcept -> sl::whole;
+
+  private:
+    int n_view_position;
+    int n_view_scale;
+    int n_mesh_position;
+    int n_mesh_scale;
+    int n_palette;
+    int n_palette_count;
+
+    program m_program;
+  };
+
+  using ptr_instance_shader = std::shared_ptr<instance_shader>;
+}
+
+#endif
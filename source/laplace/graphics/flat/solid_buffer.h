@@ -26,11 +26,22 @@ namespace laplace::graphics::flat {
     void render(std::span<const vertex> vertices);
     void render_strip(std::span<const vertex> vertices);
 
+    /*  Keep the vertices in the buffer to render them many
+     *  times without the upload.
+     */
+    void upload(std::span<const vertex> vertices);
+
+    /*  Render the uploaded vertices.
+     */
+    void render() const;
+
   private:
     void render_internal(std::span<const vertex> vertices,
                          uint32_t                mode);
+    void draw(uint32_t mode, sl::whole count) const;
 
-    uint32_t m_id;
+    uint32_t  m_id;
+    sl::whole m_count = 0;
   };
 }
 
@@ -115,9 +115,11 @@ namespace laplace::graphics {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
                     GL_LINEAR_MIPMAP_LINEAR);
 
-    for (size_t level = 0; level < img.get_mip_count(); level++) {
-      const auto mip    = img.mip(level);
-      const auto n      = static_cast<GLint>(level);
+    const auto chain = img.mip_chain();
+
+    for (size_t level = 0; level < chain.size(); level++) {
+      const auto &mip   = chain[level];
+      const auto  n     = static_cast<GLint>(level);
       const auto width  = static_cast<GLsizei>(mip->get_width());
       const auto height = static_cast<GLsizei>(mip->get_height());
 
@@ -135,9 +137,11 @@ namespace laplace::graphics {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
                     GL_LINEAR_MIPMAP_LINEAR);
 
-    for (size_t level = 0; level < img.get_mip_count(); level++) {
-      const auto mip    = img.mip(level);
-      const auto n      = static_cast<GLint>(level);
+    const auto chain = img.mip_chain();
+
+    for (size_t level = 0; level < chain.size(); level++) {
+      const auto &mip   = chain[level];
+      const auto  n     = static_cast<GLint>(level);
       const auto width  = static_cast<GLsizei>(mip->get_width());
       const auto height = static_cast<GLsizei>(mip->get_height());
 
@@ -146,6 +150,28 @@ namespace laplace::graphics {
     }
   }
 
+  void texture::update_2d(cref_image img, sl::index x, sl::index y,
+                          sl::whole width, sl::whole height) {
+    if (x < 0 || y < 0 || width <= 0 || height <= 0 ||
+        x + width > img.get_width() || y + height > img.get_height())
+      return;
+
+    glBindTexture(GL_TEXTURE_2D, m_id);
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH,
+                  static_cast<GLint>(img.get_width()));
+
+    const auto offset = (y * img.get_width() + x) * sizeof(pixel);
+
+    glTexSubImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(x),
+                    static_cast<GLint>(y),
+                    static_cast<GLsizei>(width),
+                    static_cast<GLsizei>(height), GL_RGBA,
+                    GL_UNSIGNED_BYTE, img.get_data() + offset);
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+  }
+
   void texture::image_3d_linear(cref_image img) {
     glBindTexture(GL_TEXTURE_3D, m_id);
 
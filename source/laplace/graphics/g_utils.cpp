@@ -34,6 +34,17 @@ namespace laplace::graphics {
     glViewport(x0, y0, w, h);
   }
 
+  void scissor(sl::index x, sl::index y, sl::whole width,
+               sl::whole height) {
+
+    auto x0 = static_cast<GLint>(x);
+    auto y0 = static_cast<GLint>(y);
+    auto w  = static_cast<GLsizei>(width);
+    auto h  = static_cast<GLsizei>(height);
+
+    glScissor(x0, y0, w, h);
+  }
+
   void clear(cref_vec4 color) {
     glClearColor(color[0], color[1], color[2], color[3]);
     glClearDepth(1.0);
@@ -69,4 +80,12 @@ namespace laplace::graphics {
       glDisable(GL_BLEND);
     }
   }
+
+  void set_scissor_enabled(bool is_enabled) {
+    if (is_enabled) {
+      glEnable(GL_SCISSOR_TEST);
+    } else {
+      glDisable(GL_SCISSOR_TEST);
+    }
+  }
 }
@@ -35,6 +35,16 @@ namespace laplace::graphics {
     void set_pixels(cref_vpixel pixels);
 
     auto mip(sl::index level, sl::index z = 0) const -> ptr;
+
+    /*  Build all the mip levels. Level 0 is the same as mip(0),
+     *  each next level is averaged from the previous one by 2x2
+     *  blocks. Gamma correct mode averages the colors in linear
+     *  space, alpha is always linear.
+     */
+    auto mip_chain(sl::index z = 0,
+                   bool is_gamma_correct = false) const
+        -> std::vector<ptr>;
+
     auto get_mip_count() const -> sl::whole;
 
     auto get_width() const -> sl::whole;
@@ -63,6 +73,11 @@ namespace laplace::graphics {
     auto get_average(sl::index x0, sl::index y0, sl::index x1,
                      sl::index y1, sl::index z = 0) const -> pixel;
 
+    /*  Average 2x2 blocks of the source into the half size
+     *  destination.
+     */
+    static void box_filter(cref src, ref dst, bool is_gamma_correct);
+
     sl::whole m_width     = 0;
     sl::whole m_height    = 0;
     sl::whole m_depth     = 0;
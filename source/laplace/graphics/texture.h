@@ -53,6 +53,12 @@ namespace laplace::graphics {
      */
     void mipmaps_2d_nearest(cref_image img);
 
+    /*  Upload a rectangle of the image into the same place of
+     *  the texture. The texture should have the image size.
+     */
+    void update_2d(cref_image img, sl::index x, sl::index y,
+                   sl::whole width, sl::whole height);
+
     void image_3d_linear(cref_image img);
     void image_3d_nearest(cref_image img);
 
@@ -19,6 +19,8 @@ namespace laplace::graphics {
   void init();
   void viewport(sl::index x, sl::index y, sl::whole width,
                 sl::whole height);
+  void scissor(sl::index x, sl::index y, sl::whole width,
+               sl::whole height);
   void clear(cref_vec4 color);
   void clear_color_buffer(cref_vec4 color);
 
@@ -26,6 +28,7 @@ namespace laplace::graphics {
   void prepare_render();
 
   void set_blend_enabled(bool is_enabled);
+  void set_scissor_enabled(bool is_enabled);
 }
 
 #endif
@@ -0,0 +1,271 @@
+/*  laplace/platform/p_thread.cpp
+ *
+ *      Thread control.
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "thread.h"
+
+#include "../core/string.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__)
+#  include <pthread.h>
+#  include <sched.h>
+#  include <sys/resource.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+namespace laplace::platform {
+  using std::string_view, std::span, std::min, std::max, std::sort,
+      std::unique, std::thread, std::isspace, std::isdigit;
+
+  /*  Same as CPU_SETSIZE on Linux.
+   */
+  static constexpr sl::index cpu_index_limit = 1024;
+
+  static auto parse_cpu_index(string_view s, sl::index &n) -> bool {
+    while (!s.empty() && isspace(s.front())) s.remove_prefix(1);
+    while (!s.empty() && isspace(s.back())) s.remove_suffix(1);
+
+    if (s.empty()) {
+      return false;
+    }
+
+    n = 0;
+
+    for (auto c : s) {
+      if (!isdigit(c)) {
+        return false;
+      }
+
+      n = n * 10 + (c - '0');
+
+      if (n >= cpu_index_limit) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  auto parse_cpu_list(string_view s) -> sl::vector<sl::index> {
+    auto cpus = sl::vector<sl::index> {};
+
+    while (!s.empty()) {
+      const auto comma = s.find(',');
+      const auto token = s.substr(0, comma);
+      const auto dash  = token.find('-');
+
+      auto first = sl::index {};
+      auto last  = sl::index {};
+
+      if (!parse_cpu_index(token.substr(0, dash), first)) {
+        return {};
+      }
+
+      if (dash == string_view::npos) {
+        last = first;
+      } else if (!parse_cpu_index(token.substr(dash + 1), last) ||
+                 last < first) {
+        return {};
+      }
+
+      for (auto i = first; i <= last; i++) { cpus.emplace_back(i); }
+
+      if (comma == string_view::npos) {
+        break;
+      }
+
+      s.remove_prefix(comma + 1);
+    }
+
+    sort(cpus.begin(), cpus.end());
+    cpus.erase(unique(cpus.begin(), cpus.end()), cpus.end());
+
+    return cpus;
+  }
+
+  auto parse_policy(string_view name) -> int {
+    if (name == "normal")
+      return policy::normal;
+    if (name == "batch")
+      return policy::batch;
+    if (name == "idle")
+      return policy::idle;
+    if (name == "fifo")
+      return policy::fifo;
+    if (name == "round_robin")
+      return policy::round_robin;
+    return policy::inherit;
+  }
+
+  auto get_cpu_count() -> sl::whole {
+    return max<sl::whole>(1, thread::hardware_concurrency());
+  }
+
+  auto apply_thread_options(const thread_options &options) -> bool {
+    auto status = true;
+
+    if (!options.name.empty() &&
+        !set_this_thread_name(options.name)) {
+      status = false;
+    }
+
+    if (!options.cpus.empty() &&
+        !set_this_thread_affinity(options.cpus)) {
+      status = false;
+    }
+
+    const auto is_scheduled = options.policy != policy::inherit ||
+                              options.priority != 0;
+
+    if (is_scheduled && !set_this_thread_scheduling(
+                            options.policy, options.priority)) {
+      status = false;
+    }
+
+    return status;
+  }
+
+#if defined(__linux__)
+  static auto to_native_policy(int p) -> int {
+    switch (p) {
+      case policy::normal: return SCHED_OTHER;
+      case policy::batch: return SCHED_BATCH;
+      case policy::idle: return SCHED_IDLE;
+      case policy::fifo: return SCHED_FIFO;
+      case policy::round_robin: return SCHED_RR;
+    }
+
+    return -1;
+  }
+
+  static auto to_nice(int priority) -> int {
+    constexpr int values[] = { 19, 10, 5, 0, -5, -10, -20 };
+    return values[max(1, min(priority, 7)) - 1];
+  }
+
+  auto set_this_thread_name(string_view name) -> bool {
+    /*  Linux limits the name to 16 bytes including the null
+     *  terminator.
+     */
+    char buf[16] = {};
+    name.copy(buf, sizeof buf - 1);
+
+    if (auto status = pthread_setname_np(pthread_self(), buf);
+        status != 0) {
+      verb(fmt("Thread: Unable to set the name '%s' (%s).", buf,
+               strerror(status)));
+      return false;
+    }
+
+    return true;
+  }
+
+  auto set_this_thread_affinity(span<const sl::index> cpus) -> bool {
+    auto set = cpu_set_t {};
+    CPU_ZERO(&set);
+
+    auto count = sl::whole {};
+
+    for (auto n : cpus) {
+      if (n >= 0 && n < CPU_SETSIZE) {
+        CPU_SET(static_cast<int>(n), &set);
+        count++;
+      }
+    }
+
+    if (count == 0) {
+      verb("Thread: Empty CPU list.");
+      return false;
+    }
+
+    if (auto status = pthread_setaffinity_np(pthread_self(),
+                                             sizeof set, &set);
+        status != 0) {
+      verb(fmt("Thread: Unable to set the affinity (%s).",
+               strerror(status)));
+      return false;
+    }
+
+    return true;
+  }
+
+  auto set_this_thread_scheduling(int p, int priority) -> bool {
+    const auto self = pthread_self();
+
+    auto native = to_native_policy(p);
+    auto param  = sched_param {};
+
+    if (native < 0 &&
+        pthread_getschedparam(self, &native, &param) != 0) {
+      return false;
+    }
+
+    const auto is_realtime = native == SCHED_FIFO ||
+                             native == SCHED_RR;
+
+    if (is_realtime) {
+      const auto lo = sched_get_priority_min(native);
+      const auto hi = sched_get_priority_max(native);
+
+      if (priority > 0) {
+        param.sched_priority = lo + (hi - lo) *
+                                        (min(priority, 7) - 1) / 6;
+      } else if (param.sched_priority < lo) {
+        param.sched_priority = lo;
+      }
+    } else {
+      param.sched_priority = 0;
+    }
+
+    if (p != policy::inherit || is_realtime) {
+      if (auto status = pthread_setschedparam(self, native, &param);
+          status != 0) {
+        verb(fmt("Thread: Unable to set the scheduling policy (%s).",
+                 strerror(status)));
+        return false;
+      }
+    }
+
+    if (!is_realtime && priority > 0) {
+      /*  The niceness is per thread on Linux.
+       */
+      const auto tid = static_cast<id_t>(syscall(SYS_gettid));
+
+      if (setpriority(PRIO_PROCESS, tid, to_nice(priority)) != 0) {
+        verb(fmt("Thread: Unable to set the priority (%s).",
+                 strerror(errno)));
+        return false;
+      }
+    }
+
+    return true;
+  }
+#else
+  auto set_this_thread_name(string_view) -> bool {
+    return false;
+  }
+
+  auto set_this_thread_affinity(span<const sl::index>) -> bool {
+    return false;
+  }
+
+  auto set_this_thread_scheduling(int, int) -> bool {
+    return false;
+  }
+#endif
+}
@@ -13,6 +13,10 @@
 #ifndef laplace_platform_thread_h
 #define laplace_platform_thread_h
 
+#include "../core/defs.h"
+#include <span>
+#include <string>
+#include <string_view>
 #include <thread>
 
 namespace laplace::platform {
@@ -27,6 +31,64 @@ namespace laplace::platform {
       critical
     };
   }
+
+  /*  Scheduling policy. Idle, batch and normal policies use the
+   *  priority as a niceness, the real-time policies map it onto
+   *  the static priority range.
+   */
+  namespace policy {
+    enum : int {
+      inherit = 0,
+      normal,
+      batch,
+      idle,
+      fifo,
+      round_robin
+    };
+  }
+
+  /*  Options applied by the thread to itself. Empty name and CPU
+   *  list and zero priority leave the thread unchanged.
+   */
+  struct thread_options {
+    std::string           name;
+    sl::vector<sl::index> cpus;
+    int                   policy   = policy::inherit;
+    int                   priority = 0;
+  };
+
+  /*  The functions return false if the option is not supported
+   *  or the system refused to apply it. Implemented for Linux,
+   *  no-op on other platforms.
+   */
+
+  /*  Name visible in the debuggers and profilers. Truncated to
+   *  15 characters on Linux.
+   */
+  auto set_this_thread_name(std::string_view name) -> bool;
+
+  /*  Restricts the thread to the CPU indices.
+   */
+  auto set_this_thread_affinity(std::span<const sl::index> cpus)
+      -> bool;
+
+  /*  Priority from 1 to 7, zero keeps the current one.
+   */
+  auto set_this_thread_scheduling(int policy, int priority) -> bool;
+
+  auto apply_thread_options(const thread_options &options) -> bool;
+
+  /*  Parses the CPU list in the cpuset format, e.g. "0-3,8,10-11".
+   *  Returns an empty list on invalid input.
+   */
+  [[nodiscard]] auto parse_cpu_list(std::string_view s)
+      -> sl::vector<sl::index>;
+
+  /*  Returns the policy by name, e.g. "fifo" or "round_robin".
+   */
+  [[nodiscard]] auto parse_policy(std::string_view name) -> int;
+
+  [[nodiscard]] auto get_cpu_count() -> sl::whole;
 }
 
 #endif
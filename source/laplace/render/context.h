@@ -13,6 +13,7 @@
 #ifndef laplace_render_context_h
 #define laplace_render_context_h
 
+#include "../graphics/flat/instance_buffer.h"
 #include "../graphics/flat/solid_buffer.h"
 #include "../graphics/flat/solid_shader.h"
 #include "../graphics/flat/sprite_buffer.h"
@@ -24,11 +25,13 @@ namespace laplace::render {
   public:
     using solid_vertex  = graphics::flat::solid_shader::vertex;
     using sprite_vertex = graphics::flat::sprite_shader::vertex;
+    using instance      = graphics::flat::instance_shader::instance;
 
     using ptr_context = std::shared_ptr<context>;
 
     void setup(graphics::flat::ptr_solid_shader shader);
     void setup(graphics::flat::ptr_sprite_shader shader);
+    void setup(graphics::flat::ptr_instance_shader shader);
 
     void adjust_frame_size(sl::whole width, sl::whole height);
 
@@ -40,6 +43,12 @@ namespace laplace::render {
 
     void render_strip(std::span<const solid_vertex> vertices);
 
+    /*  Render the vertices uploaded into the buffer.
+     */
+    void render(const graphics::flat::solid_buffer &mesh,
+                graphics::cref_vec2                 position,
+                graphics::cref_vec2                 scale);
+
     void render(std::span<const sprite_vertex> vertices,
                 graphics::ref_texture          tex);
 
@@ -50,16 +59,29 @@ namespace laplace::render {
     void render_strip(std::span<const sprite_vertex> vertices,
                       graphics::ref_texture          tex);
 
+    /*  Draw a shared quad per instance. The colors are the
+     *  palette indices. Falls back to the solid shader if there
+     *  is no instance shader.
+     */
+    void render(std::span<const instance>       instances,
+                graphics::cref_vec2             position,
+                graphics::cref_vec2             scale,
+                std::span<const graphics::vec4> palette);
+
     static auto get_default() -> ptr_context;
 
   private:
     static std::weak_ptr<context> m_default;
 
-    graphics::flat::solid_buffer  m_solid_buffer;
-    graphics::flat::sprite_buffer m_sprite_buffer;
+    graphics::flat::solid_buffer    m_solid_buffer;
+    graphics::flat::sprite_buffer   m_sprite_buffer;
+    graphics::flat::instance_buffer m_instance_buffer;
 
     graphics::flat::ptr_solid_shader    m_solid_shader;
     graphics::flat::ptr_sprite_shader   m_sprite_shader;
+    graphics::flat::ptr_instance_shader m_instance_shader;
+
+    sl::vector<solid_vertex> m_expanded;
   };
 
   using ref_context  = context &;
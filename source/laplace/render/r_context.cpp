@@ -20,8 +20,9 @@ namespace laplace::render {
 
   using std::make_shared, std::weak_ptr, std::span,
       graphics::ref_texture, graphics::vec2, graphics::cref_vec2,
-      flat::solid_shader, flat::ptr_solid_shader,
-      flat::ptr_sprite_shader;
+      graphics::vec4, flat::solid_shader, flat::ptr_solid_shader,
+      flat::ptr_sprite_shader, flat::ptr_instance_shader,
+      flat::instance_buffer, flat::solid_buffer;
 
   weak_ptr<context> context::m_default;
 
@@ -33,6 +34,10 @@ namespace laplace::render {
     m_sprite_shader = shader;
   }
 
+  void context::setup(ptr_instance_shader shader) {
+    m_instance_shader = shader;
+  }
+
   void context::adjust_frame_size(sl::whole width, sl::whole height) {
     const auto x0 = width < 0 ? 1.f : -1.f;
     const auto y0 = height < 0 ? -1.f : 1.f;
@@ -50,6 +55,12 @@ namespace laplace::render {
       m_sprite_shader->set_view_position({ x0, y0 });
       m_sprite_shader->set_view_scale({ w, h });
     }
+
+    if (m_instance_shader) {
+      m_instance_shader->use();
+      m_instance_shader->set_view_position({ x0, y0 });
+      m_instance_shader->set_view_scale({ w, h });
+    }
   }
 
   void context::render(span<const solid_vertex> vertices) {
@@ -67,6 +78,17 @@ namespace laplace::render {
     }
   }
 
+  void context::render(const solid_buffer &mesh,
+                       cref_vec2 position, cref_vec2 scale) {
+
+    if (m_solid_shader) {
+      m_solid_shader->use();
+      m_solid_shader->set_mesh_position(position);
+      m_solid_shader->set_mesh_scale(scale);
+      mesh.render();
+    }
+  }
+
   void context::render_strip(span<const solid_vertex> vertices) {
     if (m_solid_shader) {
       m_solid_shader->use();
@@ -111,6 +133,23 @@ namespace laplace::render {
     }
   }
 
+  void context::render(span<const instance> instances,
+                       cref_vec2 position, cref_vec2 scale,
+                       span<const vec4> palette) {
+
+    if (m_instance_shader) {
+      m_instance_shader->use();
+      m_instance_shader->set_mesh_position(position);
+      m_instance_shader->set_mesh_scale(scale);
+      m_instance_shader->set_palette(palette);
+      m_instance_buffer.render(instances);
+
+    } else if (m_solid_shader) {
+      instance_buffer::expand(instances, palette, m_expanded);
+      this->render(m_expanded, position, scale);
+    }
+  }
+
   auto context::get_default() -> ptr_context {
     auto result = m_default.lock();
 
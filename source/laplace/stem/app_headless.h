@@ -0,0 +1,68 @@
+/*  laplace/stem/app_headless.h
+ *
+ *      Base class for application without window and graphics.
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#ifndef laplace_stem_app_headless_h
+#define laplace_stem_app_headless_h
+
+#include "../core/family.h"
+#include <atomic>
+#include <chrono>
+
+namespace laplace::stem {
+  /*  Updates at the fixed rate from the config. Stops on quit
+   *  or on SIGINT and SIGTERM.
+   */
+  class app_headless {
+  public:
+    /*  Tick time statistics for the last report period.
+     */
+    struct tick_stats {
+      sl::whole count      = 0;
+      sl::whole overruns   = 0;
+      uint64_t  total_usec = 0;
+      uint64_t  min_usec   = 0;
+      uint64_t  max_usec   = 0;
+    };
+
+    /*  With the tick spin on, the thread sleeps until this time
+     *  before the tick, then yields.
+     */
+    static const std::chrono::microseconds spin_duration;
+
+    app_headless(int argc, char **argv, core::cref_family def_cfg);
+    virtual ~app_headless();
+
+    auto run() -> int;
+
+    void quit() noexcept;
+
+    [[nodiscard]] auto is_quit() const noexcept -> bool;
+
+  protected:
+    core::family m_config;
+
+    virtual void init();
+    virtual void cleanup();
+    virtual void update(uint64_t delta_msec);
+
+    /*  Called once per report period.
+     */
+    virtual void report(const tick_stats &stats);
+
+  private:
+    std::atomic_bool m_is_quit = false;
+  };
+}
+
+#endif
@@ -47,6 +47,7 @@ namespace laplace::stem {
   private:
     void wrap_input();
     void load_shaders();
+    void load_font();
     void adjust_frame_size(sl::whole width, sl::whole height);
 
     [[nodiscard]] auto shader_path(const char *name,
@@ -63,6 +64,11 @@ namespace laplace::stem {
     ui::ptr_context     m_ui;
     render::ptr_context m_render;
 
+    /*  Atlas buffered TTF font. The default renderer while the
+     *  application is running.
+     */
+    ui::text::ptr_renderer m_font;
+
     core::input_handler m_input_handler;
   };
 }
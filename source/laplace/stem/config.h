@@ -31,6 +31,10 @@ namespace laplace::stem::config {
    *      -R
    *      --run
    *
+   *  Run the dedicated server without window:
+   *      -S
+   *      --server
+   *
    *  Set the config file name:
    *      -c <file_name>
    *      --config <file_name>
@@ -52,6 +56,9 @@ namespace laplace::stem::config {
   constexpr auto f_run = 'R';
   constexpr auto a_run = "run";
 
+  constexpr auto f_server = 'S';
+  constexpr auto a_server = "server";
+
   constexpr auto f_config = 'c';
   constexpr auto a_config = "config";
 
@@ -66,19 +73,47 @@ namespace laplace::stem::config {
   constexpr auto k_font    = "font";
   constexpr auto k_caption = "caption";
 
-  constexpr auto k_shaders     = "shaders";
-  constexpr auto k_folder      = "folder";
-  constexpr auto k_geometry    = "geometry";
-  constexpr auto k_vertex      = "vertex";
-  constexpr auto k_fragment    = "fragment";
-  constexpr auto k_flat_solid  = "flat_solid";
-  constexpr auto k_flat_sprite = "flat_sprite";
+  constexpr auto k_tick_rate     = "tick_rate";
+  constexpr auto k_tick_spin     = "tick_spin";
+  constexpr auto k_report_period = "report_period";
+
+  constexpr auto k_threads   = "threads";
+  constexpr auto k_main      = "main";
+  constexpr auto k_scheduler = "scheduler";
+  constexpr auto k_name      = "name";
+  constexpr auto k_cpus      = "cpus";
+  constexpr auto k_pinned    = "pinned";
+  constexpr auto k_policy    = "policy";
+  constexpr auto k_priority  = "priority";
+
+  constexpr auto k_shaders        = "shaders";
+  constexpr auto k_folder         = "folder";
+  constexpr auto k_geometry       = "geometry";
+  constexpr auto k_vertex         = "vertex";
+  constexpr auto k_fragment       = "fragment";
+  constexpr auto k_flat_solid     = "flat_solid";
+  constexpr auto k_flat_sprite    = "flat_sprite";
+  constexpr auto k_flat_instanced = "flat_instanced";
 
   /*  Default config.
    */
 
-  constexpr auto default_caption = u8"Laplace";
-  constexpr auto default_font    = u8":/default.ttf";
+  constexpr auto default_caption   = u8"Laplace";
+  constexpr auto default_font      = u8":/default.ttf";
+  constexpr auto default_font_size = sl::whole { 16 };
+
+  /*  Headless update rate in ticks per second, and the tick
+   *  statistics report period. Spinning before the tick is
+   *  more precise, but burns a core.
+   */
+  constexpr sl::whole default_tick_rate          = 100;
+  constexpr bool      default_tick_spin          = false;
+  constexpr sl::whole default_report_period_msec = 10000;
+
+  /*  Scheduler worker threads are named with the index
+   *  appended, e.g. "worker 3".
+   */
+  constexpr auto default_worker_name = "worker";
 
   constexpr auto default_shaders_folder = u8":/shaders/";
 
@@ -94,6 +129,12 @@ namespace laplace::stem::config {
   constexpr auto default_shader_flat_sprite_fragment =
       u8"flat/sprite.frag";
 
+  constexpr auto default_shader_flat_instanced_vertex =
+      u8"flat/instanced.vert";
+
+  constexpr auto default_shader_flat_instanced_fragment =
+      u8"flat/solid.frag";
+
   auto scan_flag(int argc, char **argv, char c) -> bool;
 
   auto scan_flag(int argc, char **argv, std::string_view name) -> bool;
@@ -109,6 +150,30 @@ namespace laplace::stem::config {
             core::cref_family def_cfg = get_default()) -> core::family;
 
   void save(core::cref_family cfg);
+
+  /*  Thread options from the config section. The CPU list is a
+   *  cpuset string or a vector of CPU indices, the policy is a
+   *  name and the priority is from 1 to 7.
+   */
+  auto get_thread_options(core::cref_family cfg)
+      -> platform::thread_options;
+
+  /*  Applies the thread options, e.g.
+   *
+   *      threads = {
+   *        main = { name = "main"; cpus = "0-1" }
+   *        scheduler = {
+   *          cpus = "2-7"; pinned = true
+   *          policy = fifo; priority = 4
+   *        }
+   *      }
+   *
+   *  The main options apply to the calling thread, which also does
+   *  the network and the render. The scheduler options apply to
+   *  the workers of the default executor. If pinned, each worker
+   *  takes a single CPU from the list in turn.
+   */
+  void setup_threads(core::cref_family cfg);
 }
 
 #endif
@@ -0,0 +1,174 @@
+/*  laplace/stem/s_app_headless.cpp
+ *
+ *      Base class for application without window and graphics.
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "app_headless.h"
+
+#include "../core/string.h"
+#include "config.h"
+#include <algorithm>
+#include <csignal>
+#include <thread>
+
+namespace laplace::stem {
+  namespace this_thread = std::this_thread;
+
+  using std::chrono::steady_clock, std::chrono::microseconds,
+      std::chrono::duration_cast, std::max, std::min,
+      core::cref_family, config::load, config::setup_threads,
+      config::k_tick_rate, config::k_tick_spin,
+      config::k_report_period;
+
+  const microseconds app_headless::spin_duration = microseconds(500);
+
+  static volatile std::sig_atomic_t g_signal = 0;
+
+  static void on_signal(int sig) noexcept {
+    g_signal = sig;
+  }
+
+  app_headless::app_headless(int         argc,
+                             char      **argv,
+                             cref_family def_cfg) {
+    m_config = load(argc, argv, def_cfg);
+  }
+
+  app_headless::~app_headless() {
+    config::save(m_config);
+  }
+
+  auto app_headless::run() -> int {
+    const auto tick_rate = max<sl::whole>(
+        1, m_config.has(k_tick_rate)
+               ? m_config[k_tick_rate].get_integer()
+               : config::default_tick_rate);
+
+    const auto report_period = microseconds(
+        1000 * max<sl::whole>(
+                   1, m_config.has(k_report_period)
+                          ? m_config[k_report_period].get_integer()
+                          : config::default_report_period_msec));
+
+    const auto tick = microseconds(1000000 / tick_rate);
+
+    const auto is_spin = m_config.has(k_tick_spin)
+                             ? m_config[k_tick_spin].get_boolean()
+                             : config::default_tick_spin;
+
+    g_signal = 0;
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+
+    setup_threads(m_config);
+
+    init();
+
+    auto stats      = tick_stats {};
+    auto last       = steady_clock::now();
+    auto next       = last + tick;
+    auto report_at  = last + report_period;
+    auto delta_usec = uint64_t {};
+
+    while (!is_quit()) {
+      if (g_signal != 0) {
+        verb(fmt("Headless: Signal %d received.",
+                 static_cast<int>(g_signal)));
+        break;
+      }
+
+      const auto now = steady_clock::now();
+
+      /*  Delta is accumulated in microseconds, so the fractional
+       *  milliseconds are not lost.
+       */
+      delta_usec += duration_cast<microseconds>(now - last).count();
+      last = now;
+
+      const auto delta_msec = delta_usec / 1000;
+      delta_usec %= 1000;
+
+      update(delta_msec);
+
+      const auto done = steady_clock::now();
+      const auto usec = static_cast<uint64_t>(
+          duration_cast<microseconds>(done - now).count());
+
+      stats.min_usec = stats.count == 0 ? usec
+                                        : min(stats.min_usec, usec);
+      stats.max_usec = max(stats.max_usec, usec);
+      stats.total_usec += usec;
+      stats.count++;
+
+      if (done >= report_at) {
+        report(stats);
+        stats     = {};
+        report_at = done + report_period;
+      }
+
+      if (done > next) {
+        /*  Skip the missed ticks instead of catching up.
+         */
+        stats.overruns++;
+        next = done + tick;
+      }
+
+      if (!is_spin) {
+        this_thread::sleep_until(next);
+      } else {
+        if (next - done > spin_duration) {
+          this_thread::sleep_until(next - spin_duration);
+        }
+
+        while (steady_clock::now() < next) { this_thread::yield(); }
+      }
+
+      next += tick;
+    }
+
+    cleanup();
+
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+
+    return 0;
+  }
+
+  void app_headless::quit() noexcept {
+    m_is_quit = true;
+  }
+
+  auto app_headless::is_quit() const noexcept -> bool {
+    return m_is_quit;
+  }
+
+  void app_headless::init() { }
+
+  void app_headless::cleanup() { }
+
+  void app_headless::update(uint64_t delta_msec) { }
+
+  void app_headless::report(const tick_stats &stats) {
+    if (stats.count == 0) {
+      return;
+    }
+
+    log(fmt("Headless: %lld ticks, %lld overruns, %llu/%llu/%llu us "
+            "min/mean/max.",
+            static_cast<long long>(stats.count),
+            static_cast<long long>(stats.overruns),
+            static_cast<unsigned long long>(stats.min_usec),
+            static_cast<unsigned long long>(stats.total_usec /
+                                            stats.count),
+            static_cast<unsigned long long>(stats.max_usec)));
+  }
+}
@@ -16,24 +16,28 @@
 
 #include "../core/embedded.h"
 #include "../core/utils.h"
+#include "../graphics/flat/instance_shader.h"
 #include "../graphics/flat/solid_shader.h"
 #include "../graphics/flat/sprite_shader.h"
 #include "../graphics/utils.h"
+#include "../ui/text/buffer.h"
 #include "config.h"
 #include <filesystem>
 #include <fstream>
 
 namespace laplace::stem {
   using std::make_shared, std::make_unique, config::load,
-      config::k_frame, config::k_caption, config::k_shaders,
-      config::k_flat_solid, config::k_flat_sprite, config::k_vertex,
-      config::k_fragment, config::k_folder, platform::window,
-      platform::input, platform::glcontext, platform::ref_window,
+      config::setup_threads, config::k_frame, config::k_caption,
+      config::k_shaders, config::k_flat_solid, config::k_flat_sprite,
+      config::k_flat_instanced, config::k_vertex, config::k_fragment,
+      config::k_folder, platform::window, platform::input,
+      platform::glcontext, platform::ref_window,
       core::cref_input_handler, platform::ref_glcontext,
       graphics::flat::solid_shader, graphics::flat::sprite_shader,
-      core::cref_family, std::wstring, std::wstring_view,
-      std::unique_ptr, std::istream, std::ifstream,
-      std::filesystem::path;
+      graphics::flat::instance_shader, core::cref_family,
+      std::wstring, std::wstring_view, std::unique_ptr, std::istream,
+      std::ifstream, std::filesystem::path, config::k_font,
+      config::default_font_size;
 
   application::application(int argc, char **argv, cref_family def_cfg) {
     m_config = load(argc, argv, def_cfg);
@@ -48,6 +52,8 @@ namespace laplace::stem {
     sl::whole frame_height = m_config[k_frame][1];
     sl::whole frame_rate   = m_config[k_frame][2];
 
+    setup_threads(m_config);
+
     gl::require_extensions({ "GL_ARB_framebuffer_object" });
 
     m_window = make_shared<window>();
@@ -97,6 +103,7 @@ namespace laplace::stem {
     m_render = render::context::get_default();
 
     load_shaders();
+    load_font();
 
     m_window->set_visible(true);
   }
@@ -104,6 +111,7 @@ namespace laplace::stem {
   void application::cleanup() {
     m_ui.reset();
     m_render.reset();
+    m_font.reset();
   }
 
   void application::update(uint64_t delta_msec) { }
@@ -245,6 +253,17 @@ namespace laplace::stem {
 
         m_render->setup(make_shared<sprite_shader>(*vert, *frag));
       }
+
+      if (s_cfg.has(k_flat_instanced)) {
+        const auto vert_path = shader_path(k_flat_instanced,
+                                           k_vertex);
+        const auto frag_path = shader_path(k_flat_instanced,
+                                           k_fragment);
+        const auto vert      = open(vert_path);
+        const auto frag      = open(frag_path);
+
+        m_render->setup(make_shared<instance_shader>(*vert, *frag));
+      }
     }
   }
 
@@ -256,6 +275,34 @@ namespace laplace::stem {
     }
   }
 
+  void application::load_font() {
+    if (!m_config.has(k_font) || !m_ui)
+      return;
+
+    const auto file_name = to_wstring(m_config[k_font].get_string());
+
+    auto f = make_shared<ui::text::font>();
+
+    if (!embedded::scan(file_name)) {
+      f->load(m_config[k_font].get_string());
+    } else if (embedded::exists(file_name)) {
+      f->load(embedded::open(file_name));
+    }
+
+    if (!f->is_loaded()) {
+      verb(fmt("Font not loaded: '%s'",
+               to_string(file_name).c_str()));
+      return;
+    }
+
+    f->set_size(0, default_font_size);
+
+    m_font = make_shared<ui::text::buffer>(f);
+
+    ui::text::renderer::set_default(m_font);
+    m_ui->set_font(m_font);
+  }
+
   auto application::shader_path(const char *name,
                                 const char *type) const -> wstring {
     return to_wstring(m_config[k_shaders][k_folder].get_string()) +
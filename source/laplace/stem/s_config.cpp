@@ -14,8 +14,10 @@
 
 #include "../core/embedded.h"
 #include "../core/utils.h"
+#include "../engine/executor.h"
 #include "../format/text.h"
 #include "../format/utils.h"
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 
@@ -24,8 +26,12 @@ namespace laplace::stem::config {
   namespace fs   = std::filesystem;
 
   using std::string_view, std::string, std::pair, std::ifstream,
-      std::ofstream, core::family, core::ref_family,
-      core::cref_family, platform::window, format::wrap;
+      std::ofstream, std::find_first_of,
+      core::family, core::ref_family, core::cref_family,
+      platform::window, platform::thread_options,
+      platform::parse_cpu_list, platform::parse_policy,
+      platform::apply_thread_options, engine::executor,
+      format::wrap;
 
   auto scan_flag(int argc, char **argv, char c) -> bool {
     for (auto i = 0; i < argc; i++) {
@@ -123,6 +129,10 @@ namespace laplace::stem::config {
         default_shader_flat_sprite_vertex;
     cfg[k_shaders][k_flat_sprite][k_fragment] =
         default_shader_flat_sprite_fragment;
+    cfg[k_shaders][k_flat_instanced][k_vertex] =
+        default_shader_flat_instanced_vertex;
+    cfg[k_shaders][k_flat_instanced][k_fragment] =
+        default_shader_flat_instanced_fragment;
 
     return cfg;
   }
@@ -169,6 +179,9 @@ namespace laplace::stem::config {
           } else if (strcmp(name, a_run) == 0) {
             /*  Run the app. Handles by the user.
              */
+          } else if (strcmp(name, a_server) == 0) {
+            /*  Run the server. Handles by the user.
+             */
           } else if (strcmp(name, a_config) == 0) {
             arg += read_config(arg + 1, end, cfg);
           } else if (strcmp(name, a_frame) == 0) {
@@ -187,6 +200,9 @@ namespace laplace::stem::config {
             } else if (tag[i] == f_run) {
               /*  Run the app. Handles by the user.
                */
+            } else if (tag[i] == f_server) {
+              /*  Run the server. Handles by the user.
+               */
             } else if (tag[i] == f_config) {
               arg += read_config(arg + 1, end, cfg);
             } else if (tag[i] == f_frame) {
@@ -235,4 +251,90 @@ namespace laplace::stem::config {
       }
     }
   }
+
+  auto get_thread_options(cref_family cfg) -> thread_options {
+    auto options = thread_options {};
+
+    if (cfg.has(k_name)) {
+      options.name = as_ascii_string(cfg[k_name].get_string());
+    }
+
+    if (cfg.has(k_cpus)) {
+      const auto &cpus = cfg[k_cpus];
+
+      if (cpus.is_string()) {
+        options.cpus = parse_cpu_list(
+            as_ascii_string(cpus.get_string()));
+      } else if (cpus.is_vector()) {
+        for (sl::index i = 0; i < cpus.get_size(); i++) {
+          options.cpus.emplace_back(cpus[i].get_integer());
+        }
+      } else {
+        options.cpus.emplace_back(cpus.get_integer());
+      }
+
+      if (options.cpus.empty()) {
+        log("Config: Invalid CPU list.");
+      }
+    }
+
+    if (cfg.has(k_policy)) {
+      options.policy = parse_policy(
+          as_ascii_string(cfg[k_policy].get_string()));
+    }
+
+    if (cfg.has(k_priority)) {
+      options.priority = static_cast<int>(
+          cfg[k_priority].get_integer());
+    }
+
+    return options;
+  }
+
+  void setup_threads(cref_family cfg) {
+    if (!cfg.has(k_threads)) {
+      return;
+    }
+
+    const auto &threads = cfg[k_threads];
+
+    auto main = thread_options {};
+
+    if (threads.has(k_main)) {
+      main = get_thread_options(threads[k_main]);
+      apply_thread_options(main);
+    }
+
+    if (!threads.has(k_scheduler)) {
+      return;
+    }
+
+    const auto &sched     = threads[k_scheduler];
+    const auto  is_pinned = sched[k_pinned].get_boolean();
+
+    auto options = get_thread_options(sched);
+
+    if (find_first_of(options.cpus.begin(), options.cpus.end(),
+                      main.cpus.begin(),
+                      main.cpus.end()) != options.cpus.end()) {
+      log("Config: Main thread shares the CPUs with the scheduler.");
+    }
+
+    if (options.name.empty()) {
+      options.name = default_worker_name;
+    }
+
+    executor::get_default().set_thread_init(
+        [options, is_pinned](sl::index n) {
+          auto worker = options;
+
+          worker.name += " " + std::to_string(n);
+
+          if (is_pinned && !options.cpus.empty()) {
+            worker.cpus = { options.cpus[n % options.cpus.size()] };
+          }
+
+          apply_thread_options(worker);
+        });
+  }
 }
@@ -22,8 +22,11 @@ void textarea::set_renderer(text::ptr_renderer renderer)
 
 void textarea::set_text(u8string_view text)
 {
-    m_text = text;
-    set_expired(true);
+    if (m_text != text)
+    {
+        m_text = text;
+        set_expired(true);
+    }
 }
 
 void textarea::set_line_height(int line_height)
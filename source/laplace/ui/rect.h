@@ -38,6 +38,14 @@ namespace laplace::ui {
   auto contains(cref_rect a, cref_rect b) -> bool;
   auto intersects(cref_rect a, cref_rect b) -> bool;
 
+  /*  Bounding rectangle. Empty rectangles are ignored.
+   */
+  auto unite(cref_rect a, cref_rect b) -> rect;
+
+  /*  Common area, or empty rectangle.
+   */
+  auto intersection(cref_rect a, cref_rect b) -> rect;
+
   auto to_rectf(cref_rect a) -> rectf;
   auto to_rect(cref_rectf a) -> rect;
 
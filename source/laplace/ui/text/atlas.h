@@ -0,0 +1,124 @@
+/*  laplace/ui/text/atlas.h
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#ifndef laplace_ui_text_atlas_h
+#define laplace_ui_text_atlas_h
+
+#include "../../graphics/image.h"
+#include "../rect.h"
+#include <list>
+#include <unordered_map>
+
+namespace laplace::ui::text {
+  /*  Dynamic glyph atlas. Glyphs are keyed by face, size and
+   *  code point, and packed into shelves of a single image.
+   *  The least recently used glyphs are evicted when there is
+   *  no space left.
+   */
+  class atlas {
+  public:
+    struct key {
+      const void *face = nullptr;
+      sl::whole   size = 0;
+      char32_t    code = 0;
+
+      auto operator==(const key &) const -> bool = default;
+    };
+
+    struct glyph {
+      sl::index x       = 0;
+      sl::index y       = 0;
+      sl::whole width   = 0;
+      sl::whole height  = 0;
+      sl::index left    = 0;
+      sl::index top     = 0;
+      sl::index advance = 0;
+    };
+
+    static constexpr sl::whole default_size = 1024;
+
+    atlas(sl::whole width  = default_size,
+          sl::whole height = default_size);
+    ~atlas() = default;
+
+    /*  The glyphs used after the stamp are not evicted until
+     *  the next one.
+     */
+    void next_stamp();
+
+    [[nodiscard]] auto find(const key &k) -> const glyph *;
+
+    /*  Copy the glyph bitmap into the atlas. Returns nullptr if
+     *  there is no space even after the eviction.
+     */
+    auto insert(const key &k, sl::index left, sl::index top,
+                sl::index advance, graphics::cref_image bitmap)
+        -> const glyph *;
+
+    /*  Returns the area changed since the previous call.
+     */
+    auto take_dirty() -> rect;
+
+    [[nodiscard]] auto get_image() const -> graphics::cref_image;
+    [[nodiscard]] auto get_count() const -> sl::whole;
+
+  private:
+    /*  Gap between the glyphs, so the filtering does not bleed.
+     */
+    static constexpr sl::whole padding = 1;
+
+    struct key_hash {
+      auto operator()(const key &k) const noexcept -> size_t;
+    };
+
+    struct entry {
+      glyph                    value;
+      sl::index                shelf = -1;
+      sl::index                stamp = 0;
+      std::list<key>::iterator lru;
+    };
+
+    struct segment {
+      sl::index x     = 0;
+      sl::whole width = 0;
+    };
+
+    struct shelf {
+      sl::index           y      = 0;
+      sl::whole           height = 0;
+      sl::whole           fill   = 0;
+      sl::vector<segment> free;
+    };
+
+    auto allocate(sl::whole width, sl::whole height, sl::index &n,
+                  sl::index &x) -> bool;
+    void release(sl::index n, sl::index x, sl::whole width);
+    auto evict() -> bool;
+    void reset();
+    void touch(entry &e);
+
+    graphics::image m_image;
+
+    sl::vector<shelf>                        m_shelves;
+    std::unordered_map<key, entry, key_hash> m_entries;
+    std::list<key>                           m_lru;
+
+    sl::index m_stamp = 0;
+
+    sl::index m_dirty_x0 = 0;
+    sl::index m_dirty_y0 = 0;
+    sl::index m_dirty_x1 = 0;
+    sl::index m_dirty_y1 = 0;
+  };
+}
+
+#endif
@@ -14,36 +14,83 @@
 #define laplace_ui_text_buffer_h
 
 #include "../../graphics/texture.h"
-#include "painter.h"
+#include "../../render/context.h"
+#include "atlas.h"
+#include "font.h"
 #include "renderer.h"
-#include <array>
+#include <list>
 
 namespace laplace::ui::text {
-  /*  Buffered 16x16 font.
+  /*  Font buffered in a dynamic glyph atlas. The glyphs are
+   *  rasterized on first use, the text layouts are cached by
+   *  string. The least recently used layouts are dropped when
+   *  the cache is full.
    */
   class buffer final : public renderer {
   public:
-    static constexpr size_t char_count = 256;
+    static constexpr sl::whole layout_cache_limit = 512;
 
+    buffer(ptr_font f);
     ~buffer() final = default;
 
-    void build(ref_painter paint);
-    void build_monospace(ref_painter paint, sl::index top,
-                         sl::index char_width, sl::index char_height);
-    void build_monospace(graphics::cref_image img, sl::index top,
-                         sl::index char_width, sl::index char_height);
-
     auto adjust(std::u8string_view text) -> area final;
     void render(sl::index x, sl::index y, std::u8string_view text) final;
 
+    [[nodiscard]] auto get_atlas() const -> const atlas &;
+
   private:
-    int    m_cell_top    = 0;
-    size_t m_cell_width  = 0;
-    size_t m_cell_height = 0;
+    using sprite_vertex = render::context::sprite_vertex;
+
+    /*  Atlas position of a drawn glyph. The layout is rebuilt
+     *  if the glyph was evicted or moved.
+     */
+    struct placed_glyph {
+      atlas::key key;
+      sl::index  x = 0;
+      sl::index  y = 0;
+    };
+
+    struct layout {
+      area                                    bounds;
+      sl::whole                               size = 0;
+      sl::vector<placed_glyph>                glyphs;
+      sl::vector<sprite_vertex>               vertices;
+      std::list<std::u8string_view>::iterator lru;
+    };
+
+    struct string_hash {
+      using is_transparent = void;
+
+      auto operator()(std::u8string_view s) const noexcept -> size_t;
+    };
+
+    using layout_map = std::unordered_map<std::u8string, layout,
+                                          string_hash,
+                                          std::equal_to<>>;
+
+    auto get_layout(std::u8string_view text) -> layout &;
+    auto get_glyph(char32_t code) -> const atlas::glyph *;
+
+    /*  Touch the glyphs of the layout in the atlas. Returns
+     *  false if any of them is not in place.
+     */
+    auto touch(const layout &l) -> bool;
+    void build(std::u8string_view text, layout &l);
+    void upload();
+
+    ptr_font   m_font;
+    atlas      m_atlas;
+    layout_map m_layouts;
+    bool       m_is_uploaded = false;
+
+    /*  Keys of the cached layouts, the most recently used
+     *  first.
+     */
+    std::list<std::u8string_view> m_lru;
 
-    std::array<area, char_count> m_chars;
-    graphics::ptr_texture        m_texture =
+    graphics::ptr_texture m_texture =
         std::make_shared<graphics::texture>();
+    render::ptr_context m_render = render::context::get_default();
   };
 }
 
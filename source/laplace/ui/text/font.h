@@ -24,16 +24,36 @@ namespace laplace::ui::text {
   public:
     using cref_bitmap = const FT_Bitmap &;
 
+    struct glyph {
+      bool            is_loaded = false;
+      sl::index       left      = 0;
+      sl::index       top       = 0;
+      sl::index       advance   = 0;
+      graphics::image bitmap;
+    };
+
     ~font() final = default;
 
     void load(std::u8string_view file_name);
+
+    /*  The bytes shall outlive the font.
+     */
+    void load(span_cbyte bytes);
+
     void set_size(size_t width, size_t height);
 
     auto adjust(std::u8string_view text) -> area final;
     void print(graphics::ref_image img, sl::index x, sl::index y,
                std::u8string_view text) final;
 
+    /*  Render a single character into its own image.
+     */
+    auto rasterize(char32_t code) -> glyph;
+
     auto get_color() const -> graphics::cref_pixel;
+    auto get_size() const -> sl::whole;
+
+    [[nodiscard]] auto is_loaded() const -> bool;
 
   private:
     static void draw(graphics::ref_image img, sl::index x0,
@@ -43,6 +63,7 @@ namespace laplace::ui::text {
                       uint8_t factor) -> graphics::pixel;
 
     graphics::pixel m_color = default_color;
+    sl::whole       m_size  = 0;
     ttf             m_face;
   };
 
@@ -32,6 +32,11 @@ namespace laplace::ui::text {
 
     static auto get_default() -> ptr_renderer;
 
+    /*  The default renderer is held by the caller. Without it
+     *  the LCD font is used.
+     */
+    static void set_default(ptr_renderer r);
+
   private:
     static std::weak_ptr<renderer> m_default;
   };
@@ -52,6 +52,8 @@ namespace laplace::ui::text {
     void load(span_cbyte bytes);
     void done();
 
+    [[nodiscard]] auto is_open() const noexcept -> bool;
+
     void set_char_size(double width, double height);
     void set_pixel_sizes(sl::whole width, sl::whole height);
 
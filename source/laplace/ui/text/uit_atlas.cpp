@@ -0,0 +1,252 @@
+/*  laplace/ui/text/uit_atlas.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "atlas.h"
+
+#include <algorithm>
+
+namespace laplace::ui::text {
+  using std::min, std::max, std::hash, graphics::cref_image,
+      graphics::pixel;
+
+  auto atlas::key_hash::operator()(const key &k) const noexcept
+      -> size_t {
+    auto h = hash<const void *> {}(k.face);
+    h ^= hash<sl::whole> {}(k.size) + 0x9e3779b9 + (h << 6) +
+         (h >> 2);
+    h ^= hash<char32_t> {}(k.code) + 0x9e3779b9 + (h << 6) +
+         (h >> 2);
+    return h;
+  }
+
+  atlas::atlas(sl::whole width, sl::whole height) {
+    m_image.set_size(width, height);
+  }
+
+  void atlas::next_stamp() {
+    m_stamp++;
+  }
+
+  auto atlas::find(const key &k) -> const glyph * {
+    auto i = m_entries.find(k);
+
+    if (i == m_entries.end())
+      return nullptr;
+
+    touch(i->second);
+    return &i->second.value;
+  }
+
+  auto atlas::insert(const key &k, sl::index left, sl::index top,
+                     sl::index advance, cref_image bitmap)
+      -> const glyph * {
+    if (auto *g = find(k); g != nullptr)
+      return g;
+
+    const auto width    = bitmap.get_width();
+    const auto height   = bitmap.get_height();
+    const auto is_empty = width == 0 || height == 0;
+
+    auto n = sl::index { -1 };
+    auto x = sl::index {};
+
+    while (!is_empty &&
+           !allocate(width + padding, height + padding, n, x)) {
+      if (evict())
+        continue;
+      if (!m_entries.empty() || m_shelves.empty())
+        return nullptr;
+
+      /*  Nothing to evict, but the shelves are fragmented.
+       */
+      reset();
+    }
+
+    auto e = entry { .value = { .left    = left,
+                                .top     = top,
+                                .advance = advance },
+                     .shelf = n,
+                     .stamp = m_stamp };
+
+    if (!is_empty) {
+      const auto y = m_shelves[n].y;
+
+      e.value.x      = x;
+      e.value.y      = y;
+      e.value.width  = width;
+      e.value.height = height;
+
+      for (sl::index j = 0; j < height + padding; j++) {
+        for (sl::index i = 0; i < width + padding; i++) {
+          m_image.set_pixel(x + i, y + j,
+                            i < width && j < height
+                                ? bitmap.get_pixel(i, j)
+                                : pixel {});
+        }
+      }
+
+      if (m_dirty_x0 == m_dirty_x1) {
+        m_dirty_x0 = x;
+        m_dirty_y0 = y;
+        m_dirty_x1 = x + width;
+        m_dirty_y1 = y + height;
+      } else {
+        m_dirty_x0 = min(m_dirty_x0, x);
+        m_dirty_y0 = min(m_dirty_y0, y);
+        m_dirty_x1 = max(m_dirty_x1, x + width);
+        m_dirty_y1 = max(m_dirty_y1, y + height);
+      }
+    }
+
+    m_lru.emplace_front(k);
+    e.lru = m_lru.begin();
+
+    return &m_entries.emplace(k, e).first->second.value;
+  }
+
+  auto atlas::take_dirty() -> rect {
+    const auto r = rect { .x      = m_dirty_x0,
+                          .y      = m_dirty_y0,
+                          .width  = m_dirty_x1 - m_dirty_x0,
+                          .height = m_dirty_y1 - m_dirty_y0 };
+
+    m_dirty_x0 = 0;
+    m_dirty_y0 = 0;
+    m_dirty_x1 = 0;
+    m_dirty_y1 = 0;
+
+    return r;
+  }
+
+  auto atlas::get_image() const -> cref_image {
+    return m_image;
+  }
+
+  auto atlas::get_count() const -> sl::whole {
+    return m_entries.size();
+  }
+
+  auto atlas::allocate(sl::whole width, sl::whole height,
+                       sl::index &n, sl::index &x) -> bool {
+    for (sl::index k = 0; k < m_shelves.size(); k++) {
+      auto &s = m_shelves[k];
+
+      /*  Skip the shelves too low, or too high to not waste
+       *  the space.
+       */
+      if (s.height < height || s.height > height + height / 2 + 1)
+        continue;
+
+      for (sl::index i = 0; i < s.free.size(); i++) {
+        auto &f = s.free[i];
+
+        if (f.width < width)
+          continue;
+
+        n = k;
+        x = f.x;
+        f.x += width;
+        f.width -= width;
+
+        if (f.width == 0)
+          s.free.erase(s.free.begin() + i);
+        return true;
+      }
+
+      if (s.fill + width <= m_image.get_width()) {
+        n = k;
+        x = s.fill;
+        s.fill += width;
+        return true;
+      }
+    }
+
+    const auto bottom = m_shelves.empty()
+                            ? sl::index {}
+                            : m_shelves.back().y +
+                                  m_shelves.back().height;
+
+    if (width > m_image.get_width() ||
+        bottom + height > m_image.get_height())
+      return false;
+
+    n = m_shelves.size();
+    x = 0;
+    m_shelves.emplace_back(
+        shelf { .y = bottom, .height = height, .fill = width });
+    return true;
+  }
+
+  void atlas::release(sl::index n, sl::index x, sl::whole width) {
+    auto &s = m_shelves[n];
+
+    auto i = std::lower_bound(
+        s.free.begin(), s.free.end(), x,
+        [](const segment &f, sl::index v) { return f.x < v; });
+
+    i = s.free.insert(i, segment { .x = x, .width = width });
+
+    /*  Merge with the neighbours.
+     */
+    if (auto next = i + 1;
+        next != s.free.end() && i->x + i->width == next->x) {
+      i->width += next->width;
+      s.free.erase(next);
+    }
+
+    if (i != s.free.begin()) {
+      if (auto prev = i - 1; prev->x + prev->width == i->x) {
+        prev->width += i->width;
+        i = s.free.erase(i) - 1;
+      }
+    }
+
+    if (i->x + i->width == s.fill) {
+      s.fill = i->x;
+      s.free.erase(i);
+    }
+
+    while (!m_shelves.empty() && m_shelves.back().fill == 0) {
+      m_shelves.pop_back();
+    }
+  }
+
+  auto atlas::evict() -> bool {
+    if (m_lru.empty())
+      return false;
+
+    auto i = m_entries.find(m_lru.back());
+
+    if (i->second.stamp == m_stamp)
+      return false;
+
+    const auto &g = i->second.value;
+
+    if (g.width > 0 && g.height > 0)
+      release(i->second.shelf, g.x, g.width + padding);
+
+    m_entries.erase(i);
+    m_lru.pop_back();
+    return true;
+  }
+
+  void atlas::reset() {
+    m_shelves.clear();
+    m_entries.clear();
+    m_lru.clear();
+  }
+
+  void atlas::touch(entry &e) {
+    e.stamp = m_stamp;
+    m_lru.splice(m_lru.begin(), m_lru, e.lru);
+  }
+}
@@ -12,37 +12,218 @@
 
 #include "buffer.h"
 
+#include "../../core/utf8.h"
+#include <algorithm>
+
 namespace laplace::ui::text {
-  using std::u8string_view, graphics::cref_image;
+  using std::u8string_view, std::u8string, std::hash, std::max,
+      graphics::vec2;
 
-  void buffer::build(ref_painter paint) {
-    /*  TODO
-     */
+  auto buffer::string_hash::operator()(u8string_view s) const noexcept
+      -> size_t {
+    return hash<u8string_view> {}(s);
   }
 
-  void buffer::build_monospace(ref_painter paint, sl::index top,
-                               sl::index char_width,
-                               sl::index char_height) {
-    /*  TODO
-     */
+  buffer::buffer(ptr_font f) : m_font(f) { }
+
+  auto buffer::adjust(u8string_view text) -> renderer::area {
+    return get_layout(text).bounds;
   }
 
-  void buffer::build_monospace(cref_image img, sl::index top,
-                               sl::index char_width,
-                               sl::index char_height) {
-    /*  TODO
+  void buffer::render(sl::index x, sl::index y, u8string_view text) {
+    auto &l = get_layout(text);
+
+    /*  The glyphs are touched on each draw, so the atlas evicts
+     *  the ones not drawn for the longest time.
      */
+    if (!touch(l))
+      build(text, l);
+
+    upload();
+
+    if (l.vertices.empty() || !m_render)
+      return;
+
+    m_render->render(l.vertices,
+                     vec2 { static_cast<float>(x),
+                            static_cast<float>(y) },
+                     vec2 { 1.f, 1.f }, *m_texture);
   }
 
-  auto buffer::adjust(u8string_view text) -> renderer::area {
-    /*  TODO
-     */
+  auto buffer::get_atlas() const -> const atlas & {
+    return m_atlas;
+  }
+
+  auto buffer::get_layout(u8string_view text) -> layout & {
+    const auto size = m_font ? m_font->get_size() : sl::whole {};
+
+    if (auto i = m_layouts.find(text); i != m_layouts.end()) {
+      auto &l = i->second;
 
-    return { 0, 0, 0 };
+      m_lru.splice(m_lru.begin(), m_lru, l.lru);
+
+      /*  The bounds are valid until the font size changes. The
+       *  glyph positions are checked on render.
+       */
+      if (l.size != size)
+        build(text, l);
+      return l;
+    }
+
+    if (m_layouts.size() >= layout_cache_limit) {
+      m_layouts.erase(m_layouts.find(m_lru.back()));
+      m_lru.pop_back();
+    }
+
+    auto &node = *m_layouts.emplace(u8string(text), layout {}).first;
+
+    m_lru.emplace_front(node.first);
+    node.second.lru = m_lru.begin();
+
+    build(text, node.second);
+    return node.second;
   }
 
-  void buffer::render(sl::index x, sl::index y, u8string_view text) {
-    /*  TODO
+  auto buffer::get_glyph(char32_t code) -> const atlas::glyph * {
+    const auto k = atlas::key { .face = m_font.get(),
+                                .size = m_font->get_size(),
+                                .code = code };
+
+    if (auto *g = m_atlas.find(k); g != nullptr)
+      return g;
+
+    const auto g = m_font->rasterize(code);
+
+    if (!g.is_loaded)
+      return nullptr;
+
+    return m_atlas.insert(k, g.left, g.top, g.advance, g.bitmap);
+  }
+
+  auto buffer::touch(const layout &l) -> bool {
+    auto is_valid = true;
+
+    for (const auto &p : l.glyphs) {
+      const auto *g = m_atlas.find(p.key);
+
+      if (g == nullptr || g->x != p.x || g->y != p.y)
+        is_valid = false;
+    }
+
+    return is_valid;
+  }
+
+  void buffer::build(u8string_view text, layout &l) {
+    l.bounds = {};
+    l.size   = m_font ? m_font->get_size() : sl::whole {};
+    l.glyphs.clear();
+    l.vertices.clear();
+
+    if (!m_font)
+      return;
+
+    /*  Pin the glyphs of this text, so the atlas does not evict
+     *  them while the layout is built.
      */
+    m_atlas.next_stamp();
+
+    struct placed {
+      const atlas::glyph *g;
+      sl::index           pen;
+      char32_t            code;
+    };
+
+    auto glyphs = sl::vector<placed> {};
+
+    auto top         = sl::index {};
+    auto width       = sl::index {};
+    auto width_total = sl::index {};
+    auto height      = sl::index {};
+
+    auto code = char32_t {};
+
+    for (sl::index i = 0; utf8::decode(text, i, code);) {
+      const auto *g = get_glyph(code);
+
+      if (g == nullptr)
+        continue;
+
+      if (top < g->top) {
+        height += g->top - top;
+        top = g->top;
+      }
+
+      height      = max(height, g->height);
+      width_total = width + g->width;
+
+      glyphs.emplace_back(
+          placed { .g = g, .pen = width, .code = code });
+      width += g->advance;
+    }
+
+    l.bounds = { .top    = max<sl::index>(0, top),
+                 .width  = max<sl::index>(0, width_total),
+                 .height = max<sl::index>(0, height) };
+
+    const auto &img = m_atlas.get_image();
+    const auto  tw  = static_cast<float>(img.get_width());
+    const auto  th  = static_cast<float>(img.get_height());
+
+    for (const auto &p : glyphs) {
+      const auto &g = *p.g;
+
+      if (g.width == 0 || g.height == 0)
+        continue;
+
+      l.glyphs.emplace_back(
+          placed_glyph { .key = { .face = m_font.get(),
+                                  .size = l.size,
+                                  .code = p.code },
+                         .x   = g.x,
+                         .y   = g.y });
+
+      /*  Same orientation as the text image in wrap, the bottom
+       *  glyph row is at the lower y.
+       */
+      const auto x0 = static_cast<float>(p.pen + g.left);
+      const auto y0 = static_cast<float>(l.bounds.height -
+                                         (top - g.top) - g.height);
+      const auto x1 = x0 + static_cast<float>(g.width);
+      const auto y1 = y0 + static_cast<float>(g.height);
+
+      const auto u0 = static_cast<float>(g.x) / tw;
+      const auto u1 = static_cast<float>(g.x + g.width) / tw;
+      const auto v0 = static_cast<float>(g.y) / th;
+      const auto v1 = static_cast<float>(g.y + g.height) / th;
+
+      const auto a = sprite_vertex { .position = { x0, y0 },
+                                     .texcoord = { u0, v1 } };
+      const auto b = sprite_vertex { .position = { x1, y0 },
+                                     .texcoord = { u1, v1 } };
+      const auto c = sprite_vertex { .position = { x0, y1 },
+                                     .texcoord = { u0, v0 } };
+      const auto d = sprite_vertex { .position = { x1, y1 },
+                                     .texcoord = { u1, v0 } };
+
+      l.vertices.insert(l.vertices.end(), { a, b, c, c, b, d });
+    }
+  }
+
+  void buffer::upload() {
+    if (!m_texture)
+      return;
+
+    if (!m_is_uploaded) {
+      m_texture->image_2d_nearest(m_atlas.get_image());
+      m_is_uploaded = true;
+      m_atlas.take_dirty();
+      return;
+    }
+
+    const auto r = m_atlas.take_dirty();
+
+    if (r.width > 0 && r.height > 0)
+      m_texture->update_2d(m_atlas.get_image(), r.x, r.y, r.width,
+                           r.height);
   }
 }
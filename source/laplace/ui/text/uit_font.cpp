@@ -24,8 +24,13 @@ namespace laplace::ui::text {
     m_face.open(to_wstring(file_name));
   }
 
+  void font::load(span_cbyte bytes) {
+    m_face.load(bytes);
+  }
+
   void font::set_size(size_t width, size_t height) {
     m_face.set_pixel_sizes(width, height);
+    m_size = static_cast<sl::whole>(height);
   }
 
   auto font::adjust(u8string_view text) -> painter::area {
@@ -77,6 +82,24 @@ namespace laplace::ui::text {
     }
   }
 
+  auto font::rasterize(char32_t code) -> glyph {
+    auto g = glyph {};
+
+    if (m_face.load_char_render(code)) {
+      auto slot = m_face.get_glyph();
+
+      g.is_loaded = true;
+      g.left      = slot->bitmap_left;
+      g.top       = slot->bitmap_top;
+      g.advance   = slot->advance.x >> 6;
+
+      g.bitmap.set_size(slot->bitmap.width, slot->bitmap.rows);
+      draw(g.bitmap, 0, 0, slot->bitmap, m_color);
+    }
+
+    return g;
+  }
+
   void font::draw(ref_image img, sl::index x0, sl::index y0,
                   cref_bitmap bitmap, cref_pixel color) {
     for (sl::index y = 0; y < bitmap.rows; y++) {
@@ -112,4 +135,12 @@ namespace laplace::ui::text {
   auto font::get_color() const -> cref_pixel {
     return m_color;
   }
+
+  auto font::get_size() const -> sl::whole {
+    return m_size;
+  }
+
+  auto font::is_loaded() const -> bool {
+    return m_face.is_open();
+  }
 }
@@ -38,4 +38,8 @@ namespace laplace::ui::text {
 
     return p;
   }
+
+  void renderer::set_default(ptr_renderer r) {
+    m_default = r;
+  }
 }
@@ -152,6 +152,10 @@ namespace laplace::ui::text {
     }
   }
 
+  auto ttf::is_open() const noexcept -> bool {
+    return m_face != nullptr;
+  }
+
   void ttf::set_char_size(double width, double height) {
     if (m_face) {
       auto e = FT_Set_Char_Size(
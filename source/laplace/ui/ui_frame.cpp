@@ -14,10 +14,12 @@
 #include "frame.h"
 
 namespace laplace::ui {
-  using graphics::viewport, graphics::clear_color_buffer;
+  using graphics::viewport, graphics::scissor,
+      graphics::set_scissor_enabled, graphics::clear_color_buffer;
 
   frame::frame() {
     m_context = context::get_default();
+    set_retained(true);
   }
 
   void frame::set_context(ptr_context cont) {
@@ -33,9 +35,8 @@ namespace laplace::ui {
 
       if (is_widget_changed()) {
         m_buffer.set_size(r.width, r.height);
-      }
+        reset_clip();
 
-      if (is_widget_changed() || has_childs_expired()) {
         m_buffer.render([this]() {
           clear_color_buffer({ 0.f, 0.f, 0.f, 0.f });
 
@@ -43,6 +44,42 @@ namespace laplace::ui {
         });
 
         viewport(0, 0, r.width, r.height);
+
+      } else if (has_childs_expired()) {
+        /*  Repaint only the dirty area, the rest of the frame
+         *  buffer is retained. The dirty region is in absolute
+         *  coordinates, the frame buffer covers r.
+         */
+        const auto dirty = get_dirty();
+        const auto local = intersection(
+            rect { .x      = dirty.x - r.x,
+                   .y      = dirty.y - r.y,
+                   .width  = dirty.width,
+                   .height = dirty.height },
+            rect { .width = r.width, .height = r.height });
+
+        if (local.width > 0 && local.height > 0) {
+          set_clip({ .x      = local.x + r.x,
+                     .y      = local.y + r.y,
+                     .width  = local.width,
+                     .height = local.height });
+
+          m_buffer.render([&]() {
+            /*  The frame buffer rows go bottom-up.
+             */
+            scissor(local.x, r.height - local.y - local.height,
+                    local.width, local.height);
+            set_scissor_enabled(true);
+
+            clear_color_buffer({ 0.f, 0.f, 0.f, 0.f });
+
+            widget_render();
+
+            set_scissor_enabled(false);
+          });
+
+          viewport(0, 0, r.width, r.height);
+        }
       }
 
       m_context->render(r, m_buffer.color_texture);
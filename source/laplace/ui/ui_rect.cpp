@@ -12,9 +12,12 @@
 
 #include "rect.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace laplace::ui {
+  using std::min, std::max;
+
   auto compare(cref_rect a, cref_rect b) -> bool {
     if (a.x != b.x || a.y != b.y)
       return false;
@@ -49,6 +52,32 @@ namespace laplace::ui {
            a.y < b.y + b.height && b.y < a.y + a.height;
   }
 
+  auto unite(cref_rect a, cref_rect b) -> rect {
+    if (a.width <= 0 || a.height <= 0)
+      return b;
+    if (b.width <= 0 || b.height <= 0)
+      return a;
+
+    const auto x0 = min(a.x, b.x);
+    const auto y0 = min(a.y, b.y);
+    const auto x1 = max(a.x + a.width, b.x + b.width);
+    const auto y1 = max(a.y + a.height, b.y + b.height);
+
+    return { .x = x0, .y = y0, .width = x1 - x0, .height = y1 - y0 };
+  }
+
+  auto intersection(cref_rect a, cref_rect b) -> rect {
+    if (!intersects(a, b))
+      return {};
+
+    const auto x0 = max(a.x, b.x);
+    const auto y0 = max(a.y, b.y);
+    const auto x1 = min(a.x + a.width, b.x + b.width);
+    const auto y1 = min(a.y + a.height, b.y + b.height);
+
+    return { .x = x0, .y = y0, .width = x1 - x0, .height = y1 - y0 };
+  }
+
   auto to_rectf(cref_rect a) -> rectf {
     return { .x      = static_cast<float>(a.x),
              .y      = static_cast<float>(a.y),
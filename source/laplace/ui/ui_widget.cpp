@@ -58,6 +58,7 @@ namespace laplace::ui {
 
   void widget::set_rect(cref_rect r) {
     if (m_rect != r) {
+      invalidate_self();
       m_rect = r;
 
       adjust_layout();
@@ -102,6 +103,7 @@ namespace laplace::ui {
 
   void widget::move_to(sl::index x, sl::index y) {
     if (m_rect.x != x || m_rect.y != y) {
+      invalidate_self();
       m_rect.x = x;
       m_rect.y = y;
 
@@ -123,9 +125,19 @@ namespace laplace::ui {
     for (sl::index i = 0; i < m_childs.size(); i++) {
       auto &w = m_childs[i];
 
-      if (w->is_visible() && intersects(local_area, w->m_rect)) {
-        indices.emplace_back(i);
-      }
+      if (!w->is_visible() || !intersects(local_area, w->m_rect))
+        continue;
+
+      /*  Skip the childs outside of the repainted area, they
+       *  are retained in the frame buffer.
+       */
+      if (m_is_clipped && !intersects(m_clip, w->get_absolute_rect()))
+        continue;
+
+      w->m_clip       = m_clip;
+      w->m_is_clipped = m_is_clipped;
+
+      indices.emplace_back(i);
     }
 
     auto op = [this](sl::index a, sl::index b) -> bool {
@@ -142,6 +154,17 @@ namespace laplace::ui {
   void widget::up_to_date() {
     m_expired    = false;
     m_is_changed = false;
+    m_dirty      = {};
+  }
+
+  void widget::set_clip(cref_rect area) {
+    m_clip       = area;
+    m_is_clipped = true;
+  }
+
+  void widget::reset_clip() {
+    m_clip       = {};
+    m_is_clipped = false;
   }
 
   auto widget::widget_tick(uint64_t delta_msec, cref_input_handler in,
@@ -210,6 +233,7 @@ namespace laplace::ui {
 
       m_childs.emplace_back(child);
 
+      c->invalidate_self();
       set_expired(true);
     }
 
@@ -219,6 +243,8 @@ namespace laplace::ui {
   void widget::detach(ptr_widget child) {
     if (child->m_is_attached &&
         child->m_parent.lock() == shared_from_this()) {
+      child->invalidate_self();
+
       if (child->m_attach_index < m_childs.size()) {
         m_childs.erase(        //
             m_childs.begin() + //
@@ -237,6 +263,8 @@ namespace laplace::ui {
 
   void widget::detach(sl::index child_index) {
     if (child_index < m_childs.size()) {
+      m_childs[child_index]->invalidate_self();
+
       m_childs[child_index]->m_is_attached  = false;
       m_childs[child_index]->m_attach_index = 0;
       m_childs[child_index]->m_parent.reset();
@@ -312,6 +340,7 @@ namespace laplace::ui {
       }
 
       refresh();
+      invalidate_self();
 
       m_is_changed = true;
     } else {
@@ -328,6 +357,29 @@ namespace laplace::ui {
     return m_expired_childs;
   }
 
+  void widget::invalidate(cref_rect area) {
+    auto p = m_parent.lock();
+
+    if (m_is_retained || !p) {
+      m_dirty = unite(m_dirty, area);
+    }
+
+    /*  The parent repaints the same area to composite the
+     *  retained buffer.
+     */
+    if (p) {
+      p->invalidate(area);
+    }
+  }
+
+  void widget::set_retained(bool is_retained) {
+    m_is_retained = is_retained;
+  }
+
+  auto widget::get_dirty() const -> cref_rect {
+    return m_dirty;
+  }
+
   auto widget::is_visible() const -> bool {
     return m_is_visible;
   }
@@ -416,4 +468,19 @@ namespace laplace::ui {
       p->m_expired_childs = true;
     }
   }
+
+  void widget::invalidate_self() {
+    invalidate(find_absolute_rect());
+  }
+
+  auto widget::find_absolute_rect() const -> rect {
+    auto r = m_rect;
+
+    for (auto p = m_parent.lock(); p; p = p->m_parent.lock()) {
+      r.x += p->m_rect.x;
+      r.y += p->m_rect.y;
+    }
+
+    return r;
+  }
 }
@@ -85,6 +85,22 @@ namespace laplace::ui {
     [[nodiscard]] auto is_expired() const -> bool;
     [[nodiscard]] auto has_childs_expired() const -> bool;
 
+    /*  Add the area in absolute coordinates to the dirty
+     *  region of each retained parent and the root widget.
+     */
+    void invalidate(cref_rect area);
+
+    /*  Keep the dirty region on this widget too, so it can
+     *  repaint its own buffer. Frames are retained.
+     */
+    void set_retained(bool is_retained);
+
+    /*  Bounding rectangle of the areas invalidated since the
+     *  last redraw, in absolute coordinates. Only retained and
+     *  root widgets have it.
+     */
+    [[nodiscard]] auto get_dirty() const -> cref_rect;
+
     [[nodiscard]] auto is_visible() const -> bool;
     [[nodiscard]] auto is_enabled() const -> bool;
     [[nodiscard]] auto is_attached() const -> bool;
@@ -111,6 +127,12 @@ namespace laplace::ui {
     void draw_childs();
     void up_to_date();
 
+    /*  Render only the childs that intersect the clip area,
+     *  in absolute coordinates.
+     */
+    void set_clip(cref_rect area);
+    void reset_clip();
+
     auto widget_tick(uint64_t delta_msec, core::cref_input_handler in,
                      bool is_handled) -> bool;
 
@@ -122,6 +144,9 @@ namespace laplace::ui {
     void update_indices(sl::index begin);
     void adjust_layout();
     void refresh_childs();
+    void invalidate_self();
+
+    [[nodiscard]] auto find_absolute_rect() const -> rect;
 
     bool m_expired        = true;
     bool m_expired_childs = true;
@@ -136,9 +161,13 @@ namespace laplace::ui {
     bool      m_is_enabled   = true;
     bool      m_is_handler   = false;
     bool      m_is_attached  = false;
+    bool      m_is_retained  = false;
     bool      m_has_focus    = false;
     sl::index m_attach_index = 0;
     sl::index m_focus_index  = 0;
+    rect      m_dirty;
+    rect      m_clip;
+    bool      m_is_clipped = false;
 
     vptr_widget           m_childs;
     std::weak_ptr<widget> m_parent;
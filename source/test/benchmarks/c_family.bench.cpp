@@ -0,0 +1,66 @@
+/*  test/benchmarks/c_family.bench.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../../laplace/core/family.h"
+#include <benchmark/benchmark.h>
+
+namespace laplace::bench {
+  using core::family, std::to_string;
+
+  static constexpr sl::whole key_count = 10000;
+
+  static auto key_of(sl::index i) -> family {
+    return family("config_key_" +
+                  to_string((i * 7919) % key_count));
+  }
+
+  static void core_family_insert(benchmark::State &state) {
+    for (auto _ : state) {
+      auto f = family {};
+
+      for (sl::index i = 0; i < key_count; i++) {
+        f[key_of(i)] = i;
+      }
+
+      benchmark::DoNotOptimize(f.get_size());
+    }
+
+    state.SetItemsProcessed(state.iterations() * key_count);
+  }
+
+  static void core_family_lookup(benchmark::State &state) {
+    auto f    = family {};
+    auto keys = sl::vector<family> {};
+
+    for (sl::index i = 0; i < key_count; i++) {
+      f[key_of(i)] = i;
+      keys.emplace_back(key_of(i * 13));
+    }
+
+    const auto &cf = f;
+
+    for (auto _ : state) {
+      auto sum = sl::index {};
+
+      for (const auto &key : keys) {
+        sum += cf[key].get_integer();
+      }
+
+      benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * key_count);
+  }
+
+  BENCHMARK(core_family_insert)->Unit(benchmark::kMillisecond);
+  BENCHMARK(core_family_lookup)->Unit(benchmark::kMillisecond);
+}
@@ -39,6 +39,24 @@ namespace laplace::bench {
     size_t n_value = 0;
   };
 
+  class my_lookup : public basic_entity {
+  public:
+    my_lookup(sl::index id_target) : basic_entity(1) {
+      m_target = id_target;
+    }
+
+    ~my_lookup() override = default;
+
+    void tick(access::world w) override {
+      for (sl::index i = 0; i < 100; i++) {
+        benchmark::DoNotOptimize(w.has_entity(m_target + i));
+      }
+    }
+
+  private:
+    sl::index m_target = 0;
+  };
+
   static void engine_world_startup(benchmark::State &state) {
     for (auto _ : state) {
       auto a = make_shared<world>();
@@ -83,4 +101,57 @@ namespace laplace::bench {
   }
 
   BENCHMARK(engine_world_multithreading);
+
+  static void engine_world_sparse_ticks(benchmark::State &state) {
+    auto a = make_shared<world>();
+
+    a->set_thread_count(0);
+
+    for (sl::index i = 0; i < 10000; i++) {
+      auto e = make_shared<basic_entity>(100);
+      e->set_clock(i % 100);
+      a->spawn(e, id_undefined);
+    }
+
+    for (auto _ : state) { a->tick(100); }
+  }
+
+  BENCHMARK(engine_world_sparse_ticks);
+
+  static void engine_world_spawn_remove(benchmark::State &state) {
+    auto a = make_shared<world>();
+
+    a->set_thread_count(0);
+
+    for (sl::index i = 0; i < 100000; i++) {
+      a->spawn(make_shared<basic_entity>(), id_undefined);
+    }
+
+    auto n = sl::index {};
+
+    for (auto _ : state) {
+      const auto id = (n * 7919) % 100000;
+      n++;
+
+      a->remove(id);
+      benchmark::DoNotOptimize(
+          a->spawn(make_shared<basic_entity>(), id_undefined));
+    }
+  }
+
+  BENCHMARK(engine_world_spawn_remove);
+
+  static void engine_world_lookup(benchmark::State &state) {
+    auto a = make_shared<world>();
+
+    a->set_thread_count(state.range(0));
+
+    for (sl::index i = 0; i < 10000; i++) {
+      a->spawn(make_shared<my_lookup>(i % 9900), id_undefined);
+    }
+
+    for (auto _ : state) { a->tick(10); }
+  }
+
+  BENCHMARK(engine_world_lookup)->Arg(1)->Arg(4)->Arg(32);
 }
@@ -0,0 +1,72 @@
+/*  test/benchmarks/ee_batch.bench.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../../laplace/engine/eval/batch.h"
+#include <benchmark/benchmark.h>
+#include <random>
+
+namespace laplace::bench {
+  using std::mt19937_64, std::uniform_int_distribution, engine::intval,
+      engine::vec3i, engine::eval::box, engine::eval::soa_of;
+
+  namespace eval = engine::eval;
+
+  static auto random_boxes(sl::whole count) -> sl::vector<box> {
+    auto rng  = mt19937_64 {};
+    auto pos  = uniform_int_distribution<intval>(0, 10000);
+    auto size = uniform_int_distribution<intval>(0, 100);
+
+    auto v = sl::vector<box>(count);
+
+    for (auto &b : v) {
+      b.min = { pos(rng), pos(rng), pos(rng) };
+      b.max = b.min + vec3i { size(rng), size(rng), size(rng) };
+    }
+
+    return v;
+  }
+
+  static const auto query = box { { 4000, 4000, 4000 },
+                                  { 6000, 6000, 6000 } };
+
+  static void engine_batch_box_scalar(benchmark::State &state) {
+    const auto v = random_boxes(state.range(0));
+
+    for (auto _ : state) {
+      auto mask = eval::bitmask((v.size() + 63) / 64);
+
+      for (sl::index i = 0; i < v.size(); i++) {
+        if (eval::intersects(query, v[i])) {
+          mask[i / 64] |= uint64_t { 1 } << (i % 64);
+        }
+      }
+
+      benchmark::DoNotOptimize(mask.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void engine_batch_box(benchmark::State &state) {
+    const auto soa = soa_of(random_boxes(state.range(0)));
+
+    for (auto _ : state) {
+      auto mask = eval::intersects(query, soa);
+      benchmark::DoNotOptimize(mask.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  BENCHMARK(engine_batch_box_scalar)->Arg(1024)->Arg(16384);
+  BENCHMARK(engine_batch_box)->Arg(1024)->Arg(16384);
+}
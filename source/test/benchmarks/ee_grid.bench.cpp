@@ -0,0 +1,153 @@
+/*  test/benchmarks/ee_grid.bench.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../../laplace/engine/eval/grid.h"
+#include <benchmark/benchmark.h>
+#include <random>
+
+namespace laplace::bench {
+  using std::mt19937_64, std::uniform_int_distribution, engine::vec2z;
+
+  namespace grid = engine::eval::grid;
+
+  static auto random_map(sl::whole size) -> sl::vector<int8_t> {
+    auto rng  = mt19937_64 {};
+    auto cell = uniform_int_distribution<int>(0, 9);
+
+    auto v = sl::vector<int8_t>(size * size);
+
+    for (auto &x : v) { x = cell(rng) == 0 ? 1 : 0; }
+
+    return v;
+  }
+
+  static void engine_grid_merge(benchmark::State &state) {
+    const auto size = static_cast<sl::whole>(state.range(0));
+    const auto src  = random_map(size);
+
+    auto dst = sl::vector<int8_t>(src.size());
+
+    for (auto _ : state) {
+      grid::merge({ size, size }, dst, src, grid::op_or);
+      benchmark::DoNotOptimize(dst.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * size * size);
+  }
+
+  static void engine_grid_merge_function(benchmark::State &state) {
+    const auto size = static_cast<sl::whole>(state.range(0));
+    const auto src  = random_map(size);
+    const auto op   = grid::op { grid::op_or };
+
+    auto dst = sl::vector<int8_t>(src.size());
+
+    for (auto _ : state) {
+      grid::merge({ size, size }, dst, src, op);
+      benchmark::DoNotOptimize(dst.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * size * size);
+  }
+
+  static void engine_grid_convolve(benchmark::State &state) {
+    const auto size   = static_cast<sl::whole>(state.range(0));
+    const auto radius = sl::whole { 4 };
+    const auto fp     = 1 + radius * 2;
+    const auto src    = random_map(size);
+
+    const auto footprint = sl::vector<int8_t>(fp * fp, 1);
+
+    auto dst = sl::vector<int8_t>(src.size());
+
+    for (auto _ : state) {
+      grid::convolve({ size, size }, dst, src, { fp, fp },
+                     { radius, radius }, footprint);
+      benchmark::DoNotOptimize(dst.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * size * size);
+  }
+
+  static auto available(const int8_t x) -> bool {
+    return x == 0;
+  }
+
+  static auto run(grid::_replan_state &state) -> bool {
+    for (;;) {
+      const auto s = grid::replan_loop(state);
+
+      if (s != engine::eval::astar::status::progress) {
+        return s == engine::eval::astar::status::success;
+      }
+    }
+  }
+
+  static void engine_grid_replan_full(benchmark::State &state) {
+    const auto size = static_cast<sl::whole>(state.range(0));
+    const auto a    = vec2z { 1, 1 };
+    const auto b    = vec2z { size - 2, size - 2 };
+    const auto mid  = (size / 2) * size + size / 2;
+
+    auto map = random_map(size);
+
+    map[a.y() * size + a.x()] = 0;
+    map[b.y() * size + b.x()] = 0;
+
+    for (auto _ : state) {
+      map[mid] ^= 1;
+
+      auto s = grid::replan_init({ size, size }, 10, map, available,
+                                 a, b);
+      benchmark::DoNotOptimize(run(s));
+    }
+  }
+
+  static void engine_grid_replan_repair(benchmark::State &state) {
+    const auto size = static_cast<sl::whole>(state.range(0));
+    const auto a    = vec2z { 1, 1 };
+    const auto b    = vec2z { size - 2, size - 2 };
+    const auto mid  = vec2z { size / 2, size / 2 };
+
+    auto map = random_map(size);
+
+    map[a.y() * size + a.x()] = 0;
+    map[b.y() * size + b.x()] = 0;
+
+    auto s = grid::replan_init({ size, size }, 10, map, available, a,
+                               b);
+    run(s);
+
+    for (auto _ : state) {
+      map[mid.y() * size + mid.x()] ^= 1;
+
+      grid::replan_update(s, { &mid, 1 });
+      benchmark::DoNotOptimize(run(s));
+    }
+  }
+
+  BENCHMARK(engine_grid_merge)->Arg(256)->Arg(512)->Arg(1024);
+  BENCHMARK(engine_grid_merge_function)->Arg(256)->Arg(512)->Arg(1024);
+  BENCHMARK(engine_grid_convolve)
+      ->Arg(256)
+      ->Arg(512)
+      ->Arg(1024)
+      ->Unit(benchmark::kMillisecond);
+  BENCHMARK(engine_grid_replan_full)
+      ->Arg(64)
+      ->Arg(256)
+      ->Unit(benchmark::kMillisecond);
+  BENCHMARK(engine_grid_replan_repair)
+      ->Arg(64)
+      ->Arg(256)
+      ->Unit(benchmark::kMillisecond);
+}
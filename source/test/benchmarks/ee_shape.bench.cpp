@@ -0,0 +1,96 @@
+/*  test/benchmarks/ee_shape.bench.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../../laplace/engine/eval/shape.h"
+#include <benchmark/benchmark.h>
+#include <random>
+
+namespace laplace::bench {
+  using std::mt19937_64, std::uniform_int_distribution, engine::intval,
+      engine::vec3i, engine::eval::shape, engine::eval::vtriangle,
+      engine::eval::ray, engine::eval::bvh_of;
+
+  namespace eval = engine::eval;
+
+  static constexpr intval    soup_size  = 1000;
+  static constexpr intval    cell_size  = 50;
+  static constexpr sl::whole rays_count = 256;
+
+  static auto random_soup(sl::whole count) -> vtriangle {
+    auto rng  = mt19937_64 {};
+    auto pos  = uniform_int_distribution<intval>(0, soup_size);
+    auto size = uniform_int_distribution<intval>(-20, 20);
+
+    auto v = vtriangle(count);
+
+    for (auto &tr : v) {
+      const auto p = vec3i { pos(rng), pos(rng), pos(rng) };
+
+      tr = { p, p + vec3i { size(rng), size(rng), size(rng) },
+             p + vec3i { size(rng), size(rng), size(rng) } };
+    }
+
+    return v;
+  }
+
+  static auto random_rays() -> sl::vector<ray> {
+    auto rng = mt19937_64 { 1 };
+    auto pos = uniform_int_distribution<intval>(0, soup_size);
+    auto dir = uniform_int_distribution<intval>(-20, 20);
+
+    auto v = sl::vector<ray>(rays_count);
+
+    for (auto &r : v) {
+      r = ray { { pos(rng), pos(rng), pos(rng) },
+                { dir(rng), dir(rng), dir(rng) } };
+    }
+
+    return v;
+  }
+
+  static void cast_rays(benchmark::State &state, const shape &s) {
+    const auto rays = random_rays();
+
+    for (auto _ : state) {
+      for (auto &r : rays) {
+        benchmark::DoNotOptimize(eval::intersection(r, s));
+      }
+    }
+
+    state.SetItemsProcessed(state.iterations() * rays_count);
+  }
+
+  static void engine_shape_octree_ray(benchmark::State &state) {
+    auto s = shape {};
+    s.granulate(random_soup(state.range(0)), cell_size);
+    cast_rays(state, s);
+  }
+
+  static void engine_shape_bvh_ray(benchmark::State &state) {
+    auto s = shape {};
+    s.set_bvh(bvh_of(random_soup(state.range(0))));
+    cast_rays(state, s);
+  }
+
+  static void engine_shape_bvh_build(benchmark::State &state) {
+    const auto v = random_soup(state.range(0));
+
+    for (auto _ : state) {
+      auto tree = bvh_of(v);
+      benchmark::DoNotOptimize(tree.nodes.data());
+    }
+  }
+
+  BENCHMARK(engine_shape_octree_ray)->Arg(10000)->Arg(100000);
+  BENCHMARK(engine_shape_bvh_ray)->Arg(10000)->Arg(100000);
+  BENCHMARK(engine_shape_bvh_build)->Arg(10000)->Arg(100000);
+}
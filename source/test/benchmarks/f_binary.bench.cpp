@@ -0,0 +1,113 @@
+/*  test/benchmarks/f_binary.bench.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../../laplace/format/binary.h"
+#include <benchmark/benchmark.h>
+
+namespace laplace::bench {
+  namespace binary = format::binary;
+
+  using core::family, core::vfamily, core::composite;
+
+  static constexpr sl::whole tree_size = 100 * 1024 * 1024;
+
+  /*  Encoded family tree of about 100 MB.
+   */
+  static auto encoded_tree() -> const vbyte & {
+    static const auto v = []() {
+      auto record = family {};
+
+      record["name"]  = u8"unit_name_0123456789abcdef";
+      record["data"]  = vbyte(64, 7);
+      record["tags"]  = vfamily { 1, 2, 3, u8"tag" };
+      record["pos"]   = composite { { 0, 100 }, { 1, 200 } };
+      record["alive"] = true;
+
+      auto records = vfamily {};
+
+      auto v = vbyte {};
+
+      const auto write = [&v](span_cbyte data) -> sl::whole {
+        v.insert(v.end(), data.begin(), data.end());
+        return data.size();
+      };
+
+      binary::encode(write, record);
+
+      const auto count = tree_size / static_cast<sl::whole>(v.size());
+
+      records.reserve(count);
+
+      for (sl::index i = 0; i < count; i++) {
+        record["id"] = i;
+        records.emplace_back(record);
+      }
+
+      v.clear();
+      v.reserve(tree_size + tree_size / 8);
+
+      binary::encode(write, family { std::move(records) });
+
+      return v;
+    }();
+
+    return v;
+  }
+
+  static void format_binary_decode(benchmark::State &state) {
+    const auto &v = encoded_tree();
+
+    for (auto _ : state) {
+      auto pack = binary::decode(span_cbyte { v });
+      benchmark::DoNotOptimize(pack->get_size());
+    }
+
+    state.SetBytesProcessed(state.iterations() * v.size());
+  }
+
+  static void format_binary_decode_stream(benchmark::State &state) {
+    const auto &v = encoded_tree();
+
+    for (auto _ : state) {
+      auto offset = sl::index {};
+
+      auto pack = binary::decode([&](sl::whole n) -> vbyte {
+        const auto count = std::min<sl::whole>(n, v.size() - offset);
+        const auto p     = v.begin() + offset;
+
+        offset += count;
+        return vbyte(p, p + count);
+      });
+
+      benchmark::DoNotOptimize(pack->get_size());
+    }
+
+    state.SetBytesProcessed(state.iterations() * v.size());
+  }
+
+  static void format_binary_decode_frozen(benchmark::State &state) {
+    const auto &v = encoded_tree();
+
+    for (auto _ : state) {
+      auto tree = binary::decode_frozen(span_cbyte { v });
+      benchmark::DoNotOptimize(tree.get_root().get_size());
+    }
+
+    state.SetBytesProcessed(state.iterations() * v.size());
+  }
+
+  BENCHMARK(format_binary_decode)->Unit(benchmark::kMillisecond);
+  BENCHMARK(format_binary_decode_stream)
+      ->Unit(benchmark::kMillisecond);
+  BENCHMARK(format_binary_decode_frozen)
+      ->Unit(benchmark::kMillisecond);
+}
@@ -0,0 +1,99 @@
+/*  test/benchmarks/f_text.bench.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../../laplace/format/text.h"
+#include <benchmark/benchmark.h>
+
+namespace laplace::bench {
+  namespace text = format::text;
+
+  using core::family, core::vfamily, core::composite;
+
+  static constexpr sl::whole text_size = 1024 * 1024;
+
+  /*  Encoded family tree of about 1 MB.
+   */
+  static auto encoded_text() -> const vbyte & {
+    static const auto v = []() {
+      auto record = family {};
+
+      record["name"]  = u8"unit_name_0123456789abcdef";
+      record["data"]  = vbyte(16, 7);
+      record["tags"]  = vfamily { -1, -2, u8"tag" };
+      record["pos"]   = composite { { 0, 100 }, { 1, 200 } };
+      record["alive"] = true;
+
+      auto v = vbyte {};
+
+      const auto write = [&v](span_cbyte data) -> sl::whole {
+        v.insert(v.end(), data.begin(), data.end());
+        return data.size();
+      };
+
+      text::encode(write, record);
+
+      const auto count = text_size / static_cast<sl::whole>(v.size());
+
+      auto records = composite {};
+      records.reserve(count);
+
+      for (sl::index i = 0; i < count; i++) {
+        record["id"] = i;
+        records.emplace_back(family { i }, record);
+      }
+
+      v.clear();
+      v.reserve(text_size + text_size / 8);
+
+      text::encode(write, family { std::move(records) });
+
+      return v;
+    }();
+
+    return v;
+  }
+
+  static void format_text_decode(benchmark::State &state) {
+    const auto &v = encoded_text();
+
+    for (auto _ : state) {
+      auto pack = text::decode(span_cbyte { v });
+      benchmark::DoNotOptimize(pack->get_size());
+    }
+
+    state.SetBytesProcessed(state.iterations() * v.size());
+  }
+
+  static void format_text_decode_by_char(benchmark::State &state) {
+    const auto &v = encoded_text();
+
+    for (auto _ : state) {
+      auto offset = sl::index {};
+
+      auto pack = text::decode_by_char([&](sl::whole n) -> vbyte {
+        const auto count = std::min<sl::whole>(n, v.size() - offset);
+        const auto p     = v.begin() + offset;
+
+        offset += count;
+        return vbyte(p, p + count);
+      });
+
+      benchmark::DoNotOptimize(pack->get_size());
+    }
+
+    state.SetBytesProcessed(state.iterations() * v.size());
+  }
+
+  BENCHMARK(format_text_decode)->Unit(benchmark::kMillisecond);
+  BENCHMARK(format_text_decode_by_char)
+      ->Unit(benchmark::kMillisecond);
+}
@@ -0,0 +1,76 @@
+/*  test/benchmarks/g_image.bench.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../../laplace/graphics/image.h"
+#include <benchmark/benchmark.h>
+#include <random>
+
+namespace laplace::bench {
+  using std::mt19937_64, std::uniform_int_distribution,
+      graphics::image, graphics::rgba;
+
+  static auto random_image(sl::whole size) -> image {
+    auto rng = mt19937_64 {};
+    auto c   = uniform_int_distribution<int>(0, 255);
+    auto img = image(size, size);
+
+    for (sl::index i = 0; i < size * size; i++) {
+      img.set_pixel(i, rgba(c(rng), c(rng), c(rng), c(rng)));
+    }
+
+    return img;
+  }
+
+  static void graphics_image_mip(benchmark::State &state) {
+    const auto img = random_image(state.range(0));
+
+    for (auto _ : state) {
+      for (sl::index level = 0; level < img.get_mip_count();
+           level++) {
+        auto mip = img.mip(level);
+        benchmark::DoNotOptimize(mip->get_data());
+      }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0) *
+                            state.range(0));
+  }
+
+  static void graphics_image_mip_chain(benchmark::State &state) {
+    const auto img = random_image(state.range(0));
+
+    for (auto _ : state) {
+      auto chain = img.mip_chain();
+      benchmark::DoNotOptimize(chain.back()->get_data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0) *
+                            state.range(0));
+  }
+
+  static void graphics_image_mip_chain_gamma(
+      benchmark::State &state) {
+    const auto img = random_image(state.range(0));
+
+    for (auto _ : state) {
+      auto chain = img.mip_chain(0, true);
+      benchmark::DoNotOptimize(chain.back()->get_data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0) *
+                            state.range(0));
+  }
+
+  BENCHMARK(graphics_image_mip)->Arg(256)->Arg(1024);
+  BENCHMARK(graphics_image_mip_chain)->Arg(256)->Arg(1024);
+  BENCHMARK(graphics_image_mip_chain_gamma)->Arg(256)->Arg(1024);
+}
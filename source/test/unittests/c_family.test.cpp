@@ -16,7 +16,7 @@
 namespace laplace::test {
   using core::family, core::composite, core::vfamily, std::u8string,
       std::string_view, std::wstring_view, std::u8string_view,
-      std::u16string_view, std::u32string_view;
+      std::u16string_view, std::u32string_view, std::to_string;
 
   TEST(core, family_construct) {
     EXPECT_TRUE(family().is_empty());
@@ -200,4 +200,47 @@ namespace laplace::test {
     EXPECT_EQ(family(u8"my string").get_string(),
               u8string_view(u8"my string"));
   }
+
+  TEST(core, family_index) {
+    const auto count = sl::whole { 1000 };
+
+    auto f = family {};
+
+    for (sl::index i = 0; i < count; i++) {
+      const auto n = (i * 7919) % count;
+
+      f[to_string(n).c_str()] = n;
+      f.by_key(n - count / 2) = -n;
+    }
+
+    ASSERT_EQ(f.get_size(), count * 2);
+
+    for (sl::index n = 0; n < count; n++) {
+      const auto key = to_string(n);
+
+      EXPECT_TRUE(f.has(family(key)));
+      EXPECT_EQ(f[key.c_str()], family(n));
+      EXPECT_EQ(f.by_key(n - count / 2), family(-n));
+    }
+
+    EXPECT_FALSE(f.has(family("missing")));
+    EXPECT_EQ(f.get_value(family(u8"missing")), family());
+
+    for (sl::index i = 1; i < f.get_size(); i++) {
+      EXPECT_LT(f.get_key(i - 1), f.get_key(i));
+    }
+
+    auto g = f;
+    EXPECT_EQ(g, f);
+
+    g.set_key(0, family(u8"new key"));
+    EXPECT_TRUE(g.has(family(u8"new key")));
+    EXPECT_EQ(g.get_size(), count * 2);
+
+    g = true;
+    g[u8"a"] = 1;
+    EXPECT_EQ(g.get_size(), 1);
+    EXPECT_EQ(g[u8"a"], family(1));
+    EXPECT_EQ(f[u8"0"], family(0));
+  }
 }
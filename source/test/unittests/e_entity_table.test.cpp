@@ -0,0 +1,94 @@
+/*  test/unittests/e_entity_table.test.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../../laplace/engine/basic_entity.h"
+#include "../../laplace/engine/entity_table.h"
+#include <gtest/gtest.h>
+
+namespace laplace::test {
+  using std::make_shared, engine::basic_entity, engine::entity_table,
+      engine::id_undefined;
+
+  TEST(engine, entity_table_set_get) {
+    auto t = entity_table {};
+    auto e = make_shared<basic_entity>();
+
+    EXPECT_EQ(t.next_free(), 0);
+    EXPECT_EQ(t.next_live(0), id_undefined);
+
+    t.set(3, e);
+
+    EXPECT_EQ(t.get(3), e);
+    EXPECT_FALSE(t.get(2));
+    EXPECT_FALSE(t.get(1000));
+    EXPECT_TRUE(t.contains(3));
+    EXPECT_EQ(t.get_size(), 4);
+    EXPECT_EQ(t.get_count(), 1);
+    EXPECT_EQ(t.next_free(), 0);
+    EXPECT_EQ(t.next_live(0), 3);
+    EXPECT_EQ(t.next_live(4), id_undefined);
+
+    t.set(3, {});
+
+    EXPECT_FALSE(t.contains(3));
+    EXPECT_EQ(t.get_size(), 4);
+    EXPECT_EQ(t.get_count(), 0);
+  }
+
+  TEST(engine, entity_table_next_free) {
+    const auto count = entity_table::page_size * 3 + 7;
+
+    auto t = entity_table {};
+
+    for (sl::index i = 0; i < count; i++) {
+      EXPECT_EQ(t.next_free(), i);
+      t.set(i, make_shared<basic_entity>());
+    }
+
+    EXPECT_EQ(t.next_free(), count);
+
+    t.set(entity_table::page_size + 5, {});
+    t.set(entity_table::page_size * 2 + 9, {});
+
+    EXPECT_EQ(t.next_free(), entity_table::page_size + 5);
+
+    t.set(entity_table::page_size + 5, make_shared<basic_entity>());
+
+    EXPECT_EQ(t.next_free(), entity_table::page_size * 2 + 9);
+    EXPECT_EQ(t.next_free(entity_table::page_size * 2 + 10), count);
+  }
+
+  TEST(engine, entity_table_next_live) {
+    const auto far = entity_table::page_size * 200 + 17;
+
+    auto t = entity_table {};
+
+    t.set(1, make_shared<basic_entity>());
+    t.set(70, make_shared<basic_entity>());
+    t.set(far, make_shared<basic_entity>());
+
+    auto ids = sl::vector<sl::index> {};
+
+    for (auto id = t.next_live(0); id != id_undefined;
+         id = t.next_live(id + 1)) {
+      ids.emplace_back(id);
+    }
+
+    EXPECT_EQ(ids, (sl::vector<sl::index> { 1, 70, far }));
+    EXPECT_EQ(t.next_free(), 0);
+
+    t.clear();
+
+    EXPECT_EQ(t.get_size(), 0);
+    EXPECT_EQ(t.next_live(0), id_undefined);
+  }
+}
@@ -0,0 +1,115 @@
+/*  test/unittests/e_executor.test.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../../laplace/engine/executor.h"
+#include <atomic>
+#include <gtest/gtest.h>
+
+namespace laplace::test {
+  using engine::executor, std::mutex, std::unique_lock,
+      std::condition_variable;
+
+  TEST(engine, executor_thread_init) {
+    constexpr sl::whole thread_count = 4;
+
+    auto pool  = executor { thread_count };
+    auto lock  = mutex {};
+    auto sync  = condition_variable {};
+    auto ready = sl::vector<int>(thread_count, 0);
+
+    pool.set_thread_init([&](sl::index n) {
+      auto _ul = unique_lock(lock);
+      if (n >= 0 && n < thread_count)
+        ready[n]++;
+      sync.notify_all();
+    });
+
+    auto _ul = unique_lock(lock);
+
+    EXPECT_TRUE(sync.wait_for(_ul, std::chrono::seconds(10), [&] {
+      for (auto x : ready)
+        if (x != 1)
+          return false;
+      return true;
+    }));
+  }
+
+  TEST(engine, executor_lane_fairness) {
+    constexpr sl::whole task_count = 10;
+
+    auto order = sl::vector<sl::index> {};
+    auto lock  = mutex {};
+    auto sync  = condition_variable {};
+    auto ready = false;
+
+    {
+      auto pool = executor { 1 };
+      auto a    = pool.add_lane();
+      auto b    = pool.add_lane();
+
+      /*  Hold the only worker until both lanes are filled.
+       */
+      pool.submit(a, [&] {
+        auto _ul = unique_lock(lock);
+        sync.wait(_ul, [&] { return ready; });
+      });
+
+      for (sl::index i = 0; i < task_count; i++) {
+        pool.submit(a, [&order, a] { order.emplace_back(a); });
+        pool.submit(b, [&order, b] { order.emplace_back(b); });
+      }
+
+      auto _ul = unique_lock(lock);
+      ready    = true;
+      _ul.unlock();
+      sync.notify_all();
+    }
+
+    ASSERT_EQ(order.size(), task_count * 2);
+
+    for (sl::index i = 1; i < order.size(); i++) {
+      EXPECT_NE(order[i - 1], order[i]) << i;
+    }
+  }
+
+  TEST(engine, executor_lane_reuse) {
+    auto pool = executor { 1 };
+
+    const auto a = pool.add_lane();
+    const auto b = pool.add_lane();
+
+    EXPECT_NE(a, b);
+
+    pool.remove_lane(a);
+
+    EXPECT_EQ(pool.add_lane(), a);
+    EXPECT_NE(pool.add_lane(), b);
+  }
+
+  TEST(engine, executor_submit_after_remove) {
+    auto is_done    = std::atomic_bool { false };
+    auto is_removed = std::atomic_bool { false };
+
+    {
+      auto pool = executor { 2 };
+      auto a    = pool.add_lane();
+      auto b    = pool.add_lane();
+
+      pool.remove_lane(b);
+      pool.submit(b, [&] { is_removed = true; });
+      pool.submit(a, [&] { is_done = true; });
+    }
+
+    EXPECT_TRUE(is_done);
+    EXPECT_FALSE(is_removed);
+  }
+}
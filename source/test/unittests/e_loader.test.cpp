@@ -0,0 +1,112 @@
+/*  test/unittests/e_loader.test.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../../laplace/engine/basic_impact.h"
+#include "../../laplace/engine/loader.h"
+#include "../../laplace/engine/world.h"
+#include <gtest/gtest.h>
+
+namespace laplace::test {
+  using std::make_shared, std::mutex, std::unique_lock,
+      engine::basic_impact, engine::world, engine::loader;
+
+  namespace access = engine::access;
+
+  class my_log_task : public basic_impact {
+  public:
+    my_log_task(mutex *lock, sl::vector<sl::index> *log,
+                sl::index value) :
+        m_lock(lock), m_log(log), m_value(value) { }
+
+    ~my_log_task() override = default;
+
+    void perform(access::world) const override {
+      auto _ul = unique_lock(*m_lock);
+      m_log->emplace_back(m_value);
+    }
+
+  private:
+    mutex                 *m_lock;
+    sl::vector<sl::index> *m_log;
+    sl::index              m_value;
+  };
+
+  TEST(engine, loader_order) {
+    auto lock = mutex {};
+    auto log  = sl::vector<sl::index> {};
+
+    auto a = loader { 4 };
+    a.set_world(make_shared<world>());
+
+    for (sl::index i = 0; i < 100; i++) {
+      EXPECT_EQ(a.add_task(make_shared<my_log_task>(&lock, &log, i)),
+                i);
+    }
+
+    a.wait();
+
+    EXPECT_TRUE(a.is_ready());
+    EXPECT_EQ(a.get_progress(), 100);
+    EXPECT_EQ(a.get_task_count(), 100);
+    EXPECT_EQ(log.size(), 100);
+
+    for (sl::index i = 0; i < log.size(); i++) {
+      EXPECT_EQ(log[i], i);
+    }
+  }
+
+  TEST(engine, loader_dependencies) {
+    auto lock = mutex {};
+    auto log  = sl::vector<sl::index> {};
+
+    auto a     = loader { 4 };
+    auto calls = sl::whole {};
+
+    a.set_world(make_shared<world>());
+    a.on_progress([&](sl::index progress, sl::whole total) {
+      auto _ul = unique_lock(lock);
+      calls++;
+    });
+
+    /*  0 -> { 1, 2, ..., 10 } -> 11
+     */
+
+    const auto first = a.add_task(
+        make_shared<my_log_task>(&lock, &log, 0), {});
+
+    auto middle = sl::vector<sl::index> {};
+
+    for (sl::index i = 1; i <= 10; i++) {
+      middle.emplace_back(a.add_task(
+          make_shared<my_log_task>(&lock, &log, i),
+          { &first, 1 }));
+    }
+
+    a.add_task(make_shared<my_log_task>(&lock, &log, 11), middle);
+
+    a.wait();
+
+    EXPECT_EQ(a.get_progress(), 12);
+    EXPECT_EQ(calls, 12);
+    ASSERT_EQ(log.size(), 12);
+    EXPECT_EQ(log.front(), 0);
+    EXPECT_EQ(log.back(), 11);
+  }
+
+  TEST(engine, loader_no_tasks) {
+    auto a = loader { 2 };
+
+    EXPECT_TRUE(a.is_ready());
+    EXPECT_EQ(a.get_progress(), 0);
+    EXPECT_EQ(a.get_thread_count(), 2);
+  }
+}
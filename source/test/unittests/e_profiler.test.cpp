@@ -0,0 +1,135 @@
+/*  test/unittests/e_profiler.test.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../../laplace/engine/access/world.h"
+#include "../../laplace/engine/basic_impact.h"
+#include "../../laplace/engine/world.h"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
+
+namespace laplace::test {
+  using std::make_shared, std::ostringstream, engine::basic_entity,
+      engine::basic_impact, engine::world, engine::profiler,
+      engine::id_undefined;
+
+  namespace access = engine::access;
+
+  class my_ticker : public basic_entity {
+  public:
+    my_ticker() : basic_entity(1) { }
+    ~my_ticker() override = default;
+  };
+
+  class my_noop : public basic_impact {
+  public:
+    ~my_noop() override = default;
+    void perform(access::world) const override { }
+  };
+
+  TEST(engine, profiler_disabled) {
+    auto a = make_shared<world>();
+
+    a->set_thread_count(0);
+    a->spawn(make_shared<my_ticker>(), id_undefined);
+    a->tick(10);
+
+    EXPECT_EQ(a->get_profiler().get_stats(profiler::adjust).count, 0);
+  }
+
+  TEST(engine, profiler_single_thread) {
+    auto  a    = make_shared<world>();
+    auto &prof = a->get_profiler();
+
+    prof.enable(true);
+    prof.enable_detailed(true);
+
+    a->set_thread_count(0);
+    a->spawn(make_shared<my_ticker>(), id_undefined);
+    a->queue(make_shared<my_noop>());
+    a->tick(10);
+
+    EXPECT_EQ(prof.get_stats(profiler::dynamic_tick).count, 10);
+    EXPECT_EQ(prof.get_stats(profiler::adjust).count, 10);
+    EXPECT_EQ(prof.get_stats(profiler::entity).count, 10);
+    EXPECT_EQ(prof.get_stats(profiler::impact).count, 1);
+
+    auto types = prof.get_type_stats();
+    EXPECT_EQ(types.size(), 2);
+
+    auto s = ostringstream {};
+    prof.dump_trace(s);
+    EXPECT_EQ(s.str().substr(0, 15), "{\"traceEvents\":");
+
+    prof.clear();
+    EXPECT_EQ(prof.get_stats(profiler::adjust).count, 0);
+  }
+
+  TEST(engine, profiler_multithreading) {
+    auto  a    = make_shared<world>();
+    auto &prof = a->get_profiler();
+
+    prof.enable(true);
+
+    a->set_thread_count(4);
+    a->spawn(make_shared<my_ticker>(), id_undefined);
+    a->tick(10);
+
+    EXPECT_EQ(prof.get_thread_count(), 4);
+    EXPECT_EQ(prof.get_stats(profiler::dynamic_tick).count, 40);
+    EXPECT_EQ(prof.get_stats(profiler::adjust).count, 40);
+    EXPECT_EQ(prof.get_stats(profiler::entity).count, 0);
+
+    /*  Each task waits before each phase but the first one.
+     */
+    EXPECT_EQ(prof.get_stats(profiler::barrier_wait).count, 76);
+  }
+
+  TEST(engine, profiler_ring_overwrite) {
+    auto r = profiler::ring { 4 };
+
+    for (int64_t i = 0; i < 10; i++) {
+      r.push({ .begin = i, .end = i + 1 });
+    }
+
+    auto v = r.get_all();
+
+    ASSERT_EQ(v.size(), 4);
+    EXPECT_EQ(v[0].begin, 6);
+    EXPECT_EQ(v[3].begin, 9);
+
+    r.clear();
+    EXPECT_TRUE(r.get_all().empty());
+
+    r.push({ .begin = 10, .end = 11 });
+    EXPECT_EQ(r.get_all().size(), 1);
+  }
+
+  TEST(engine, profiler_ring_concurrent_read) {
+    auto r = profiler::ring { 16 };
+
+    auto th = std::jthread([&r] {
+      for (int64_t i = 0; i < 100000; i++) {
+        r.push({ .begin = i, .end = i });
+      }
+    });
+
+    for (int k = 0; k < 100; k++) {
+      auto v = r.get_all();
+
+      for (sl::index i = 1; i < v.size(); i++) {
+        ASSERT_EQ(v[i].begin, v[i - 1].begin + 1);
+        ASSERT_EQ(v[i].begin, v[i].end);
+      }
+    }
+  }
+}
@@ -49,6 +49,51 @@ namespace laplace::test {
     sl::index n_value = 0;
   };
 
+  class my_periodic : public basic_entity {
+  public:
+    my_periodic(uint64_t tick_period, sl::vector<sl::index> *log) :
+        basic_entity(tick_period) {
+      setup_sets({ { sets::debug_value, 0, 0 } });
+      n_value = index_of(sets::debug_value);
+      m_log   = log;
+    }
+
+    ~my_periodic() override = default;
+
+    void tick(access::world) override {
+      apply_delta(n_value, 1);
+
+      if (m_log) {
+        m_log->emplace_back(get_id());
+      }
+    }
+
+  private:
+    sl::index              n_value = 0;
+    sl::vector<sl::index> *m_log   = nullptr;
+  };
+
+  class my_lookup : public basic_entity {
+  public:
+    my_lookup(sl::index id_target) : basic_entity(1) {
+      setup_sets({ { sets::debug_value, 0, 0 } });
+      n_value  = index_of(sets::debug_value);
+      m_target = id_target;
+    }
+
+    ~my_lookup() override = default;
+
+    void tick(access::world w) override {
+      if (w.has_entity(m_target)) {
+        apply_delta(n_value, 1);
+      }
+    }
+
+  private:
+    sl::index n_value  = 0;
+    sl::index m_target = id_undefined;
+  };
+
   class my_additioner : public basic_impact {
   public:
     my_additioner(sl::index id_entity, int64_t delta) {
@@ -125,4 +170,212 @@ namespace laplace::test {
 
     EXPECT_EQ(value, 100);
   }
+
+  TEST(engine, world_shared_pool) {
+    constexpr sl::whole world_count  = 50;
+    constexpr sl::whole entity_count = 20;
+
+    auto worlds   = sl::vector<std::shared_ptr<world>> {};
+    auto entities = sl::vector<std::shared_ptr<my_periodic>> {};
+
+    for (sl::index i = 0; i < world_count; i++) {
+      auto &a = worlds.emplace_back(make_shared<world>());
+
+      a->set_thread_count(4);
+
+      for (sl::index k = 0; k < entity_count; k++) {
+        auto &e = entities.emplace_back(
+            make_shared<my_periodic>(1 + (i + k) % 7, nullptr));
+        a->spawn(e, id_undefined);
+      }
+    }
+
+    for (auto &a : worlds) { a->schedule(300); }
+    for (auto &a : worlds) { a->join(); }
+
+    for (sl::index i = 0; i < world_count; i++) {
+      for (sl::index k = 0; k < entity_count; k++) {
+        const auto &e = entities[i * entity_count + k];
+        const auto  n = e->get(e->index_of(sets::debug_value));
+
+        EXPECT_EQ(n, (300 + (i + k) % 7) / (1 + (i + k) % 7));
+      }
+    }
+  }
+
+  TEST(engine, world_tick_period) {
+    const uint64_t periods[] = { 1, 3, 7, 300 };
+    const int64_t  counts[]  = { 1000, 334, 143, 4 };
+
+    for (sl::whole threads : { 0, 4 }) {
+      auto a = make_shared<world>();
+      auto e = sl::vector<std::shared_ptr<my_periodic>> {};
+
+      a->set_thread_count(threads);
+
+      for (auto period : periods) {
+        e.emplace_back(make_shared<my_periodic>(period, nullptr));
+        a->spawn(e.back(), id_undefined);
+      }
+
+      a->tick(1000);
+
+      for (sl::index i = 0; i < e.size(); i++) {
+        EXPECT_EQ(e[i]->get(e[i]->index_of(sets::debug_value)),
+                  counts[i]);
+      }
+    }
+  }
+
+  TEST(engine, world_tick_callback) {
+    for (sl::whole threads : { 0, 4 }) {
+      auto a      = make_shared<world>();
+      auto e      = make_shared<my_periodic>(3, nullptr);
+      auto values = sl::vector<int64_t> {};
+
+      a->set_thread_count(threads);
+
+      const auto id = a->spawn(e, id_undefined);
+      const auto n  = e->index_of(sets::debug_value);
+
+      a->on_tick([&](const access::world &w) {
+        values.emplace_back(w.get_entity(id).get(n));
+      });
+
+      a->tick(10);
+      a->on_tick({});
+      a->tick(10);
+
+      ASSERT_EQ(values.size(), 10);
+
+      for (sl::index i = 0; i < values.size(); i++) {
+        EXPECT_EQ(values[i], i / 3 + 1);
+      }
+    }
+  }
+
+  TEST(engine, world_tick_order) {
+    auto a   = make_shared<world>();
+    auto log = sl::vector<sl::index> {};
+
+    a->set_thread_count(0);
+
+    for (sl::index i = 0; i < 20; i++) {
+      auto e = make_shared<my_periodic>(i % 2 == 0 ? 2 : 3, &log);
+      e->set_clock(i % 3);
+      a->spawn(e, id_undefined);
+    }
+
+    a->tick(1);
+
+    auto expected = sl::vector<sl::index> {};
+    for (sl::index i = 0; i < 20; i += 3) { expected.emplace_back(i); }
+
+    EXPECT_EQ(log, expected);
+
+    log.clear();
+    a->tick(1);
+
+    expected.clear();
+    for (sl::index i = 1; i < 20; i += 3) { expected.emplace_back(i); }
+
+    EXPECT_EQ(log, expected);
+  }
+
+  TEST(engine, world_set_clock) {
+    auto a = make_shared<world>();
+    auto e = make_shared<my_periodic>(10, nullptr);
+
+    a->set_thread_count(0);
+    a->spawn(e, id_undefined);
+    a->tick(1);
+
+    e->set_clock(0);
+    a->tick(1);
+
+    EXPECT_EQ(e->get(e->index_of(sets::debug_value)), 2);
+  }
+
+  TEST(engine, world_id_reuse) {
+    auto a = make_shared<world>();
+
+    for (sl::index i = 0; i < 1000; i++) {
+      EXPECT_EQ(a->spawn(make_shared<basic_entity>(), id_undefined), i);
+    }
+
+    a->remove(500);
+    a->remove(10);
+
+    EXPECT_EQ(a->spawn(make_shared<basic_entity>(), id_undefined), 10);
+    EXPECT_EQ(a->spawn(make_shared<basic_entity>(), id_undefined), 500);
+    EXPECT_EQ(a->spawn(make_shared<basic_entity>(), id_undefined),
+              1000);
+
+    a->remove(0);
+
+    EXPECT_FALSE(a->get_entity(0));
+    EXPECT_TRUE(a->get_entity(1));
+  }
+
+  TEST(engine, world_frozen_spawn) {
+    auto a = make_shared<world>();
+
+    EXPECT_EQ(a->spawn(make_shared<basic_entity>(), id_undefined), 0);
+
+    a->freeze();
+
+    EXPECT_EQ(a->spawn(make_shared<basic_entity>(), id_undefined), 1);
+    EXPECT_EQ(a->spawn(make_shared<basic_entity>(), id_undefined), 2);
+
+    a->remove(0);
+
+    EXPECT_TRUE(a->get_entity(0));
+    EXPECT_FALSE(a->get_entity(1));
+
+    a->unfreeze();
+
+    EXPECT_FALSE(a->get_entity(0));
+    EXPECT_TRUE(a->get_entity(1));
+    EXPECT_TRUE(a->get_entity(2));
+  }
+
+  TEST(engine, world_frozen_spawn_reserved) {
+    auto a = make_shared<world>();
+
+    a->freeze();
+
+    EXPECT_EQ(a->spawn(make_shared<basic_entity>(), 1), 1);
+    EXPECT_EQ(a->spawn(make_shared<basic_entity>(), id_undefined), 0);
+    EXPECT_EQ(a->spawn(make_shared<basic_entity>(), id_undefined), 2);
+
+    a->unfreeze();
+    a->freeze();
+
+    EXPECT_EQ(a->spawn(make_shared<basic_entity>(), id_undefined), 3);
+
+    a->unfreeze();
+
+    for (sl::index i = 0; i < 4; i++) {
+      EXPECT_TRUE(a->get_entity(i));
+    }
+  }
+
+  TEST(engine, world_frozen_lookup) {
+    auto a = make_shared<world>();
+    auto v = sl::vector<std::shared_ptr<my_lookup>> {};
+
+    a->set_thread_count(4);
+
+    for (sl::index i = 0; i < 100; i++) {
+      v.emplace_back(make_shared<my_lookup>(i % 2 == 0 ? 0 : 1000));
+      a->spawn(v.back(), id_undefined);
+    }
+
+    a->tick(10);
+
+    for (sl::index i = 0; i < v.size(); i++) {
+      EXPECT_EQ(v[i]->get(v[i]->index_of(sets::debug_value)),
+                i % 2 == 0 ? 10 : 0);
+    }
+  }
 }
@@ -0,0 +1,71 @@
+/*  test/unittests/ee_batch.test.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../../laplace/engine/eval/batch.h"
+#include <gtest/gtest.h>
+#include <random>
+
+namespace laplace::test {
+  using std::mt19937_64, std::uniform_int_distribution, engine::intval,
+      engine::vec3i, engine::eval::box, engine::eval::sphere,
+      engine::eval::ray, engine::eval::soa_of, engine::eval::is_set;
+
+  namespace eval = engine::eval;
+
+  static auto random_boxes(mt19937_64 &rng, sl::whole count)
+      -> sl::vector<box> {
+    auto pos  = uniform_int_distribution<intval>(-100, 100);
+    auto size = uniform_int_distribution<intval>(-5, 30);
+
+    auto v = sl::vector<box>(count);
+
+    for (auto &b : v) {
+      b.min = { pos(rng), pos(rng), pos(rng) };
+      b.max = b.min + vec3i { size(rng), size(rng), size(rng) };
+    }
+
+    return v;
+  }
+
+  TEST(engine, eval_batch_box) {
+    auto rng = mt19937_64 {};
+    auto pos = uniform_int_distribution<intval>(-100, 100);
+    auto v   = random_boxes(rng, 1003);
+    auto soa = soa_of(v);
+
+    for (sl::index n = 0; n < 50; n++) {
+      const auto p = vec3i { pos(rng), pos(rng), pos(rng) };
+      const auto q = box { p, p + vec3i { 20, 20, 20 } };
+      const auto s = sphere { p, 15 };
+      const auto r = ray { p, { pos(rng), pos(rng), pos(rng) } };
+
+      const auto m_point  = eval::contains(soa, p);
+      const auto m_box    = eval::intersects(q, soa);
+      const auto m_sphere = eval::intersects(s, soa);
+      const auto m_ray    = eval::intersects(r, soa);
+
+      for (sl::index i = 0; i < v.size(); i++) {
+        EXPECT_EQ(is_set(m_point, i), eval::contains(v[i], p));
+        EXPECT_EQ(is_set(m_box, i), eval::intersects(q, v[i]));
+        EXPECT_EQ(is_set(m_sphere, i), eval::intersects(v[i], s));
+        EXPECT_EQ(is_set(m_ray, i), eval::intersects(r, v[i]));
+      }
+    }
+  }
+
+  TEST(engine, eval_batch_empty) {
+    const auto soa = soa_of({});
+
+    EXPECT_TRUE(eval::intersects(box {}, soa).empty());
+    EXPECT_TRUE(eval::contains(soa, vec3i {}).empty());
+  }
+}
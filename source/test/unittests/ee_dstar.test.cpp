@@ -0,0 +1,265 @@
+/*  test/unittests/ee_dstar.test.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../../laplace/engine/eval/grid.h"
+#include <gtest/gtest.h>
+#include <queue>
+#include <random>
+
+namespace laplace::test {
+  namespace grid  = engine::eval::grid;
+  namespace astar = engine::eval::astar;
+
+  using std::mt19937_64, std::uniform_int_distribution, engine::vec2z,
+      engine::intval, engine::infinity;
+
+  static constexpr sl::whole width  = 40;
+  static constexpr sl::whole height = 40;
+  static constexpr intval    scale  = 10;
+
+  static auto available(const int8_t x) -> bool {
+    return x == 0;
+  }
+
+  static auto random_map(mt19937_64 &rng) -> sl::vector<int8_t> {
+    auto cell = uniform_int_distribution<int>(0, 3);
+    auto map  = sl::vector<int8_t>(width * height);
+
+    for (sl::index y = 0; y < height; y++)
+      for (sl::index x = 0; x < width; x++) {
+        const auto is_border = x == 0 || y == 0 || x == width - 1 ||
+                               y == height - 1;
+
+        map[y * width + x] = is_border || cell(rng) == 0 ? 1 : 0;
+      }
+
+    return map;
+  }
+
+  /*  Reference search from the destination.
+   */
+  static auto shortest(const sl::vector<int8_t> &map,
+                       const vec2z               source,
+                       const vec2z               destination)
+      -> intval {
+    using entry = std::pair<intval, sl::index>;
+
+    auto length = sl::vector<intval>(map.size(), infinity);
+    auto queue  = std::priority_queue<entry, sl::vector<entry>,
+                                     std::greater<entry>> {};
+
+    const auto d = destination.y() * width + destination.x();
+
+    length[d] = 0;
+    queue.emplace(0, d);
+
+    while (!queue.empty()) {
+      const auto [l, n] = queue.top();
+      queue.pop();
+
+      if (l > length[n]) {
+        continue;
+      }
+
+      for (sl::index k = 0;; k++) {
+        const auto e = grid::neighbors8(width, scale, map, available,
+                                        n, k);
+
+        if (e.node == astar::link::skip) {
+          continue;
+        }
+
+        if (e.node == astar::link::invalid) {
+          break;
+        }
+
+        if (l + e.distance < length[e.node]) {
+          length[e.node] = l + e.distance;
+          queue.emplace(length[e.node], e.node);
+        }
+      }
+    }
+
+    return length[source.y() * width + source.x()];
+  }
+
+  static auto length_of(const sl::vector<int8_t> &map,
+                        const sl::vector<vec2z>  &path) -> intval {
+    auto length = intval {};
+
+    for (sl::index i = 1; i < path.size(); i++) {
+      const auto a = path[i - 1].y() * width + path[i - 1].x();
+      const auto b = path[i].y() * width + path[i].x();
+
+      auto found = false;
+
+      for (sl::index k = 0;; k++) {
+        const auto e = grid::neighbors8(width, scale, map, available,
+                                        a, k);
+
+        if (e.node == astar::link::invalid) {
+          break;
+        }
+
+        if (e.node == b) {
+          length += e.distance;
+          found = true;
+          break;
+        }
+      }
+
+      if (!found) {
+        return -1;
+      }
+    }
+
+    return length;
+  }
+
+  static auto run(grid::_replan_state &state) -> astar::status {
+    for (;;) {
+      const auto s = grid::replan_loop(state);
+
+      if (s != astar::status::progress) {
+        return s;
+      }
+    }
+  }
+
+  static auto random_free(mt19937_64               &rng,
+                          const sl::vector<int8_t> &map) -> vec2z {
+    auto pos = uniform_int_distribution<sl::index>(1, width - 2);
+
+    for (;;) {
+      const auto p = vec2z { pos(rng), pos(rng) };
+
+      if (map[p.y() * width + p.x()] == 0) {
+        return p;
+      }
+    }
+  }
+
+  TEST(engine, eval_dstar_straight) {
+    auto map = sl::vector<int8_t>(width * height);
+
+    auto state = grid::replan_init({ width, height }, scale, map,
+                                   available, { 2, 2 }, { 2, 10 });
+
+    EXPECT_EQ(run(state), astar::status::success);
+
+    const auto v = grid::replan_finish(state);
+
+    ASSERT_EQ(v.size(), 9u);
+    EXPECT_EQ(v.front(), (vec2z { 2, 2 }));
+    EXPECT_EQ(v.back(), (vec2z { 2, 10 }));
+  }
+
+  TEST(engine, eval_dstar_failed) {
+    auto map = sl::vector<int8_t>(width * height);
+
+    for (sl::index x = 0; x < width; x++) { map[20 * width + x] = 1; }
+
+    auto state = grid::replan_init({ width, height }, scale, map,
+                                   available, { 5, 5 }, { 5, 30 });
+
+    EXPECT_EQ(run(state), astar::status::failed);
+    EXPECT_TRUE(grid::replan_finish(state).empty());
+  }
+
+  TEST(engine, eval_dstar_shortest) {
+    auto rng = mt19937_64 {};
+
+    for (sl::index i = 0; i < 50; i++) {
+      const auto map = random_map(rng);
+      const auto a   = random_free(rng, map);
+      const auto b   = random_free(rng, map);
+
+      auto state = grid::replan_init({ width, height }, scale, map,
+                                     available, a, b);
+
+      const auto expected = shortest(map, a, b);
+      const auto status   = run(state);
+
+      if (expected >= infinity) {
+        EXPECT_EQ(status, astar::status::failed);
+        continue;
+      }
+
+      ASSERT_EQ(status, astar::status::success);
+      EXPECT_EQ(length_of(map, grid::replan_finish(state)), expected);
+    }
+  }
+
+  TEST(engine, eval_dstar_replan) {
+    auto rng  = mt19937_64 { 1 };
+    auto cell = uniform_int_distribution<sl::index>(1, width - 2);
+
+    for (sl::index i = 0; i < 30; i++) {
+      auto map = random_map(rng);
+
+      const auto b = random_free(rng, map);
+      auto       a = random_free(rng, map);
+
+      auto state = grid::replan_init({ width, height }, scale, map,
+                                     available, a, b);
+
+      auto status = run(state);
+
+      for (sl::index j = 0; j < 10; j++) {
+        /*  Move along the path, then change some cells.
+         */
+
+        if (status == astar::status::success) {
+          const auto path = grid::replan_finish(state);
+
+          if (path.size() > 2) {
+            a = path[2];
+            grid::replan_move(state, a);
+          }
+        }
+
+        auto changed = sl::vector<vec2z> {};
+
+        for (sl::index k = 0; k < 20; k++) {
+          const auto p = vec2z { cell(rng), cell(rng) };
+
+          if (p == a || p == b) {
+            continue;
+          }
+
+          map[p.y() * width + p.x()] ^= 1;
+          changed.emplace_back(p);
+        }
+
+        grid::replan_update(state, changed);
+
+        const auto expected = shortest(map, a, b);
+
+        status = run(state);
+
+        if (expected >= infinity) {
+          EXPECT_EQ(status, astar::status::failed);
+          continue;
+        }
+
+        ASSERT_EQ(status, astar::status::success);
+
+        const auto path = grid::replan_finish(state);
+
+        ASSERT_FALSE(path.empty());
+        EXPECT_EQ(path.front(), a);
+        EXPECT_EQ(path.back(), b);
+        EXPECT_EQ(length_of(map, path), expected);
+      }
+    }
+  }
+}
@@ -12,6 +12,7 @@
 
 #include "../../laplace/engine/eval/grid.h"
 #include <gtest/gtest.h>
+#include <random>
 
 namespace laplace::test {
   namespace grid  = engine::eval::grid;
@@ -245,6 +246,64 @@ namespace laplace::test {
     EXPECT_EQ(dst, res);
   }
 
+  TEST(engine, eval_grid_convole_random) {
+    auto rng  = std::mt19937_64 {};
+    auto cell = std::uniform_int_distribution<int>(0, 9);
+    auto dim  = std::uniform_int_distribution<sl::index>(1, 7);
+
+    constexpr auto width  = 37;
+    constexpr auto height = 23;
+
+    for (sl::index n = 0; n < 50; n++) {
+      const auto fp_size = vec2z { dim(rng), dim(rng) };
+      const auto center  = vec2z { dim(rng) - 2, dim(rng) - 2 };
+
+      auto map       = sl::vector<int8_t>(width * height);
+      auto footprint = sl::vector<int8_t>(fp_size.x() * fp_size.y());
+
+      for (auto &x : map) { x = cell(rng) == 0 ? 1 : 0; }
+      for (auto &x : footprint) { x = cell(rng) < 6 ? 1 : 0; }
+
+      auto res = sl::vector<int8_t>(map.size());
+
+      for (sl::index j = 0; j < height; j++)
+        for (sl::index i = 0; i < width; i++) {
+          if (map[j * width + i] <= 0)
+            continue;
+
+          for (sl::index y = 0; y < fp_size.y(); y++)
+            for (sl::index x = 0; x < fp_size.x(); x++) {
+              const auto u = i - center.x() + x;
+              const auto v = j - center.y() + y;
+
+              if (u >= 0 && u < width && v >= 0 && v < height &&
+                  footprint[y * fp_size.x() + x] > 0)
+                res[v * width + u] = 1;
+            }
+        }
+
+      auto dst = sl::vector<int8_t>(map.size());
+
+      grid::convolve({ width, height }, dst, map, fp_size, center,
+                     footprint);
+
+      EXPECT_EQ(dst, res);
+    }
+  }
+
+  TEST(engine, eval_grid_merge) {
+    auto dst = std::array<int8_t, 6> { 1, 1, 0, 0, 1, 0 };
+    auto src = std::array<int8_t, 4> { 1, 0, 1, 1 };
+
+    grid::merge({ 2, 2 }, dst, src, grid::op_and);
+
+    EXPECT_EQ(dst, (std::array<int8_t, 6> { 1, 0, 0, 0, 1, 0 }));
+
+    grid::merge({ 3, 2 }, dst, { 2, 2 }, { 1, 0 }, src, grid::op_or);
+
+    EXPECT_EQ(dst, (std::array<int8_t, 6> { 1, 1, 0, 0, 1, 1 }));
+  }
+
   TEST(engine, eval_grid_nearest_empty) {
     constexpr auto width  = 3;
     constexpr auto height = 3;
@@ -10,12 +10,14 @@
  *  the MIT License for more details.
  */
 
+#include "../../laplace/engine/eval/grid.h"
 #include "../../laplace/engine/eval/maze.h"
 #include "../../laplace/engine/eval/random.h"
 #include <gtest/gtest.h>
 
 namespace laplace::test {
   namespace maze = engine::eval::maze;
+  namespace grid = engine::eval::grid;
 
   using std::array, std::random_device, std::cerr, std::string;
 
@@ -48,4 +50,28 @@ namespace laplace::test {
 
     cerr << s;
   }
+
+  TEST(engine, eval_maze_connected) {
+    constexpr auto width  = 31;
+    constexpr auto height = 31;
+
+    auto map = array<int8_t, width * height> {};
+
+    auto random = engine::eval::random {};
+
+    maze::generate({ width, height }, map, [&random]() {
+      return random();
+    });
+
+    const auto available = [](const int8_t state) {
+      return state == maze::walkable;
+    };
+
+    for (sl::index j = 1; j < height; j += 2) {
+      for (sl::index i = 1; i < width; i += 2) {
+        EXPECT_TRUE(grid::path_exists(width, map, available,
+                                      { 1, 1 }, { i, j }));
+      }
+    }
+  }
 }
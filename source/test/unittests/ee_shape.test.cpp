@@ -0,0 +1,144 @@
+/*  test/unittests/ee_shape.test.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../../laplace/engine/eval/shape.h"
+#include <gtest/gtest.h>
+#include <random>
+
+namespace laplace::test {
+  using std::mt19937_64, std::uniform_int_distribution, engine::intval,
+      engine::vec3i, engine::safe_limit, engine::epsilon,
+      engine::eval::shape, engine::eval::triangle,
+      engine::eval::vtriangle, engine::eval::box, engine::eval::sphere,
+      engine::eval::ray, engine::eval::bvh_of;
+
+  namespace eval = engine::eval;
+
+  static auto random_soup(mt19937_64 &rng, sl::whole count)
+      -> vtriangle {
+    auto pos  = uniform_int_distribution<intval>(0, 1000);
+    auto size = uniform_int_distribution<intval>(-50, 50);
+
+    auto v = vtriangle(count);
+
+    for (auto &tr : v) {
+      const auto p = vec3i { pos(rng), pos(rng), pos(rng) };
+
+      tr = { p, p + vec3i { size(rng), size(rng), size(rng) },
+             p + vec3i { size(rng), size(rng), size(rng) } };
+    }
+
+    return v;
+  }
+
+  static auto nearest(const ray &r, const vtriangle &v) -> intval {
+    auto result = safe_limit;
+
+    for (auto &tr : v) {
+      auto t = eval::intersection(r, tr);
+
+      if (t + epsilon >= 0 && t < result) {
+        result = t;
+      }
+    }
+
+    return result < engine::infinity ? result : -safe_limit;
+  }
+
+  TEST(engine, eval_bvh_empty) {
+    auto s = shape {};
+    s.set_bvh(bvh_of({}));
+
+    EXPECT_TRUE(s.is_bvh());
+    EXPECT_FALSE(eval::intersects(ray { {}, { 1, 0, 0 } }, s));
+    EXPECT_EQ(eval::intersection(ray { {}, { 1, 0, 0 } }, s),
+              -safe_limit);
+  }
+
+  TEST(engine, eval_bvh_ray_nearest) {
+    auto rng = mt19937_64 {};
+    auto pos = uniform_int_distribution<intval>(0, 1000);
+    auto dir = uniform_int_distribution<intval>(-20, 20);
+    auto v   = random_soup(rng, 2000);
+
+    auto s = shape {};
+    s.set_bvh(bvh_of(v));
+
+    EXPECT_EQ(s.get_bvh().triangles.size(), v.size());
+
+    auto hits = sl::whole {};
+
+    for (sl::index i = 0; i < 300; i++) {
+      auto r = ray { { pos(rng), pos(rng), pos(rng) },
+                     { dir(rng), dir(rng), dir(rng) } };
+
+      const auto expected = nearest(r, v);
+
+      EXPECT_EQ(eval::intersection(r, s), expected);
+      EXPECT_EQ(eval::intersects(r, s), expected != -safe_limit);
+
+      if (expected != -safe_limit) {
+        hits++;
+      }
+    }
+
+    EXPECT_GT(hits, 0);
+  }
+
+  TEST(engine, eval_bvh_box_overlap) {
+    auto rng  = mt19937_64 {};
+    auto pos  = uniform_int_distribution<intval>(0, 1000);
+    auto size = uniform_int_distribution<intval>(0, 100);
+    auto v    = random_soup(rng, 2000);
+
+    auto s = shape {};
+    s.set_bvh(bvh_of(v));
+
+    for (sl::index i = 0; i < 300; i++) {
+      const auto p = vec3i { pos(rng), pos(rng), pos(rng) };
+      const auto b = box { p, p + vec3i { size(rng), size(rng),
+                                          size(rng) } };
+
+      auto expected = false;
+
+      for (auto &tr : v) {
+        if (eval::intersects(b, tr)) {
+          expected = true;
+          break;
+        }
+      }
+
+      auto q = shape {};
+      q.set_box(b);
+
+      EXPECT_EQ(eval::intersects(q, s), expected);
+    }
+  }
+
+  TEST(engine, eval_bvh_sphere_overlap) {
+    auto rng = mt19937_64 {};
+    auto v   = random_soup(rng, 2000);
+
+    auto s = shape {};
+    s.set_bvh(bvh_of(v));
+
+    for (sl::index i = 0; i < 100; i++) {
+      auto q = shape {};
+      q.set_sphere(sphere { v[i * 7][1], 10 });
+      EXPECT_TRUE(eval::intersects(q, s));
+    }
+
+    auto q = shape {};
+    q.set_sphere(sphere { { -500, -500, -500 }, 100 });
+    EXPECT_FALSE(eval::intersects(q, s));
+  }
+}
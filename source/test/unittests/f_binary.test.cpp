@@ -0,0 +1,207 @@
+/*  test/unittests/f_binary.test.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../../laplace/format/binary.h"
+#include <gtest/gtest.h>
+
+namespace laplace::test {
+  namespace binary = format::binary;
+
+  using core::family, core::composite, core::vfamily;
+
+  static auto encode(const family &data) -> vbyte {
+    auto v = vbyte {};
+
+    binary::encode(
+        [&v](span_cbyte data) -> sl::whole {
+          v.insert(v.end(), data.begin(), data.end());
+          return data.size();
+        },
+        data);
+
+    return v;
+  }
+
+  static auto sample() -> family {
+    auto f = family {};
+
+    f["name"]     = u8"Quadwar";
+    f["count"]    = -42;
+    f["size"]     = uint64_t { 1024 };
+    f["bytes"]    = vbyte { 1, 2, 3, 255 };
+    f["flags"]    = vfamily { true, false, true, true, false, true,
+                           false, false, true };
+    f["list"]     = vfamily { 1, u8"two", vfamily { 3, 4 } };
+    f["compact"]  = composite { { 0, u8"a" }, { 3, u8"b" } };
+    f["nested"]   = composite { { -1, true }, { u8"key", 2 } };
+    f["nothing"]  = family {};
+    f["is_ready"] = false;
+
+    return f;
+  }
+
+  TEST(format, binary_round_trip) {
+    const auto data = sample();
+    const auto v    = encode(data);
+
+    ASSERT_FALSE(v.empty());
+
+    auto pack = binary::decode(span_cbyte { v });
+
+    ASSERT_TRUE(pack);
+    EXPECT_EQ(*pack, data);
+  }
+
+  TEST(format, binary_round_trip_stream) {
+    const auto data = sample();
+    const auto v    = encode(data);
+
+    auto offset = sl::index {};
+
+    auto pack = binary::decode([&](sl::whole n) -> vbyte {
+      const auto count = std::min<sl::whole>(n, v.size() - offset);
+      const auto p     = v.begin() + offset;
+
+      offset += count;
+      return vbyte(p, p + count);
+    });
+
+    ASSERT_TRUE(pack);
+    EXPECT_EQ(*pack, data);
+  }
+
+  TEST(format, binary_truncated) {
+    const auto v = encode(sample());
+
+    for (sl::whole n = 0; n < v.size(); n++) {
+      auto pack = binary::decode(
+          span_cbyte { v.data(), static_cast<size_t>(n) });
+
+      ASSERT_TRUE(pack);
+      EXPECT_TRUE(pack->is_empty());
+    }
+  }
+
+  TEST(format, binary_pack_keys) {
+    auto data = family {};
+
+    data["width"]         = 640;
+    data["height"]        = 480;
+    data["pixels"]        = vbyte { 1, 2, 3 };
+    data["load"]["depth"] = 3;
+    data["other"] = vfamily { composite { { u8"width", 1 } } };
+
+    auto packed = data;
+    binary::pack(packed);
+
+    EXPECT_FALSE(packed.has(family(u8"width")));
+    EXPECT_TRUE(packed.has(family(u8"other")));
+    EXPECT_EQ(packed.get_size(), data.get_size());
+
+    binary::unpack(packed);
+    EXPECT_EQ(packed, data);
+  }
+
+  TEST(format, binary_frozen) {
+    const auto data = sample();
+    const auto v    = encode(data);
+
+    const auto tree = binary::decode_frozen(span_cbyte { v });
+    const auto root = tree.get_root();
+
+    ASSERT_TRUE(root.is_composite());
+    EXPECT_EQ(root.get_size(), data.get_size());
+    EXPECT_EQ(root.thaw(), data);
+
+    EXPECT_EQ(root[u8"name"].get_string(), u8"Quadwar");
+    EXPECT_EQ(root[u8"count"].get_integer(), -42);
+    EXPECT_EQ(root[u8"size"].get_uint(), 1024u);
+    EXPECT_EQ(root[u8"bytes"].get_bytes().size(), 4);
+    EXPECT_EQ(root[u8"flags"].get_size(), 9);
+    EXPECT_TRUE(root[u8"flags"][3].get_boolean());
+    EXPECT_EQ(root[u8"list"][2][1].get_integer(), 4);
+    EXPECT_EQ(root[u8"compact"][1].get_string(), u8"b");
+    EXPECT_EQ(root[u8"compact"].get_value(family(3)).get_string(),
+              u8"b");
+    EXPECT_TRUE(root[u8"nested"].get_value(family(-1)).get_boolean());
+    EXPECT_TRUE(root[u8"nothing"].is_empty());
+    EXPECT_TRUE(root.has(family(u8"is_ready")));
+    EXPECT_FALSE(root.has(family(u8"missing")));
+    EXPECT_TRUE(root[u8"missing"].is_empty());
+
+    for (sl::whole n = 0; n < v.size(); n++) {
+      const auto part = binary::decode_frozen(
+          span_cbyte { v.data(), static_cast<size_t>(n) });
+
+      EXPECT_TRUE(part.get_root().is_empty());
+    }
+  }
+
+  TEST(format, binary_frozen_depth) {
+    auto shallow = family { 1 };
+    auto deep    = family { 1 };
+
+    for (sl::index i = 0; i < 100; i++)
+      shallow = family { vfamily { shallow } };
+    for (sl::index i = 0; i < 1000; i++)
+      deep = family { vfamily { deep } };
+
+    const auto a = encode(shallow);
+    const auto b = encode(deep);
+
+    EXPECT_EQ(
+        binary::decode_frozen(span_cbyte { a }).get_root().thaw(),
+        shallow);
+    EXPECT_TRUE(binary::decode_frozen(span_cbyte { b })
+                    .get_root()
+                    .is_empty());
+  }
+
+  /*  Vectors of one field nested n times.
+   */
+  static auto nested_vectors(sl::whole n) -> vbyte {
+    auto v = vbyte {};
+    v.reserve(n * 9 + 1);
+
+    for (sl::index i = 0; i < n; i++) {
+      v.emplace_back(binary::ids::vector);
+      v.insert(v.end(), { 1, 0, 0, 0, 0, 0, 0, 0 });
+    }
+
+    v.emplace_back(binary::ids::empty);
+    return v;
+  }
+
+  TEST(format, binary_depth) {
+    const auto shallow = nested_vectors(100);
+    const auto deep    = nested_vectors(100000);
+
+    auto pack = binary::decode(span_cbyte { shallow });
+
+    ASSERT_TRUE(pack);
+    EXPECT_TRUE(pack->is_vector());
+    EXPECT_TRUE(binary::decode(span_cbyte { deep })->is_empty());
+
+    auto offset = sl::index {};
+
+    auto stream = binary::decode([&](sl::whole size) -> vbyte {
+      const auto left = static_cast<sl::whole>(deep.size()) - offset;
+      const auto n    = std::min(size, left);
+      const auto i = deep.begin() + offset;
+      offset += n;
+      return vbyte(i, i + n);
+    });
+
+    ASSERT_TRUE(stream);
+    EXPECT_TRUE(stream->is_empty());
+  }
+}
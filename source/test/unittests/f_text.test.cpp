@@ -0,0 +1,213 @@
+/*  test/unittests/f_text.test.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../../laplace/format/text.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+
+namespace laplace::test {
+  namespace text = format::text;
+
+  using core::family, core::composite, core::vfamily,
+      std::string_view, std::string, std::numeric_limits;
+
+  static auto bytes_of(string_view s) -> span_cbyte {
+    return { reinterpret_cast<const uint8_t *>(s.data()), s.size() };
+  }
+
+  static auto reader(span_cbyte data) -> format::fn_read {
+    return [data, offset = sl::index {}](sl::whole n) mutable {
+      const auto count = std::min<sl::whole>(n, data.size() - offset);
+      const auto p     = data.begin() + offset;
+
+      offset += count;
+      return vbyte(p, p + count);
+    };
+  }
+
+  static auto encode(const family &data) -> vbyte {
+    auto v = vbyte {};
+
+    text::encode(
+        [&v](span_cbyte data) -> sl::whole {
+          v.insert(v.end(), data.begin(), data.end());
+          return data.size();
+        },
+        data);
+
+    return v;
+  }
+
+  static auto sample() -> family {
+    auto f = family {};
+
+    f["name"]    = u8"Quadwar";
+    f["count"]   = -42;
+    f["size"]    = uint64_t { 1024 };
+    f["ratio"]   = 0.75;
+    f["scale"]   = 2.0;
+    f["bytes"]   = vbyte { 1, 2, 3, 255 };
+    f["flags"]   = vfamily { true, false, true, true };
+    f["list"]    = vfamily { -1, u8"two", vfamily { -3, 0.5 } };
+    f["single"]  = vfamily { u8"one" };
+    f["nested"]  = composite { { uint64_t { 0 }, u8"a" },
+                              { u8"key", true } };
+    f["nothing"] = family {};
+
+    return f;
+  }
+
+  TEST(format, text_decode_same_as_parser) {
+    const string_view samples[] = {
+      "true", "false", "42", "-42", "+7", "\"Hello, world\"",
+      "\"a\\\"b\"", "name", "f()", "f(1)", "f(1, two, \"3\")",
+      "(1)", "(1, 2)", "((1, 2), 3)", "1, 2, 3", ":: { 01 2a ff }",
+      "{ }", "{ \"reset\"() }", "{ b = 2; a = 1; b = 3 }",
+      "{\n"
+      "  name = \"Quadwar\";\n"
+      "  count = -42; size : 1024\n"
+      "  flags = true, false, true\n"
+      "  list = (1, two, \"3\")\n"
+      "  call = f(1, 2)\n"
+      "  bytes = :: { 01 2a ff }\n"
+      "  nested = { a = x; 0 = (y) }\n"
+      "  empty = { }\n"
+      "}\n",
+      "{ a = }", "(1", "\"abc", "{ a 1 }", ":: { 100 }", "{ reset() }"
+    };
+
+    for (const auto s : samples) {
+      const auto expected = text::decode_by_char(reader(bytes_of(s)));
+      const auto pack     = text::decode(bytes_of(s));
+
+      ASSERT_EQ(!expected, !pack) << s;
+
+      if (expected) {
+        EXPECT_EQ(*pack, *expected) << s;
+      }
+    }
+  }
+
+  TEST(format, text_decode_numbers) {
+    const auto pack = text::decode(
+        bytes_of("(0x1f, 1.5, -2.5e3, 18446744073709551615, .25)"));
+
+    ASSERT_TRUE(pack);
+    EXPECT_EQ(*pack, family(vfamily { uint64_t { 0x1f }, 1.5,
+                                      -2.5e3, UINT64_MAX, .25 }));
+  }
+
+  TEST(format, text_round_trip) {
+    const auto data = sample();
+    const auto v    = encode(data);
+
+    ASSERT_FALSE(v.empty());
+
+    const auto pack   = text::decode(span_cbyte { v });
+    const auto stream = text::decode(reader(v));
+
+    ASSERT_TRUE(pack);
+    ASSERT_TRUE(stream);
+    EXPECT_EQ(*pack, data);
+    EXPECT_EQ(*stream, data);
+  }
+
+  TEST(format, text_truncated) {
+    const auto v = encode(sample());
+
+    /*  The closing brace is the last char, so each prefix is
+     *  incomplete.
+     */
+    for (sl::whole n = 0; n + 1 < v.size(); n++) {
+      EXPECT_FALSE(text::decode(
+          span_cbyte { v.data(), static_cast<size_t>(n) }))
+          << n;
+    }
+  }
+
+  TEST(format, text_escape_round_trip) {
+    const std::u8string_view samples[] = { u8"quote \" in",
+                                           u8"back \\ slash",
+                                           u8"\\\"", u8"\\" };
+
+    for (const auto s : samples) {
+      const auto data = family(s);
+      const auto v    = encode(data);
+
+      const auto pack = text::decode(span_cbyte { v });
+      const auto slow = text::decode_by_char(reader(v));
+
+      ASSERT_TRUE(pack);
+      ASSERT_TRUE(slow);
+      EXPECT_EQ(*pack, data);
+      EXPECT_EQ(*slow, data);
+    }
+  }
+
+  TEST(format, text_trailing_data) {
+    EXPECT_TRUE(text::decode(bytes_of("{ a = 1 } \n\t ")));
+    EXPECT_FALSE(text::decode(bytes_of("{ a = 1 } }")));
+    EXPECT_FALSE(text::decode(bytes_of("42 garbage")));
+    EXPECT_FALSE(text::decode(bytes_of("\"a\" \"b\"")));
+  }
+
+  TEST(format, text_depth) {
+    const auto shallow = string(200, '(') + "1" + string(200, ')');
+
+    auto deep = string(100000, '(');
+
+    EXPECT_TRUE(text::decode(bytes_of(shallow)));
+    EXPECT_FALSE(text::decode(bytes_of(deep)));
+
+    deep += string(100000, ')');
+
+    EXPECT_FALSE(text::decode(bytes_of(deep)));
+  }
+
+  TEST(format, text_round_trip_reals) {
+    const auto inf  = numeric_limits<double>::infinity();
+    const auto data = family(vfamily { inf, -inf, 1e300, -0.0 });
+    const auto v    = encode(data);
+
+    const auto pack = text::decode(span_cbyte { v });
+
+    ASSERT_TRUE(pack);
+    EXPECT_EQ(*pack, data);
+
+    const auto w   = encode(numeric_limits<double>::quiet_NaN());
+    const auto nan = text::decode(span_cbyte { w });
+
+    ASSERT_TRUE(nan);
+    ASSERT_TRUE(nan->is_real());
+    EXPECT_TRUE(std::isnan(nan->get_real()));
+  }
+
+  TEST(format, text_empty_vector) {
+    /*  The family keeps an empty vector as an empty value.
+     */
+    auto data       = family {};
+    data["list"]    = vfamily {};
+    data["nothing"] = family {};
+
+    const auto v = encode(family(vfamily {}));
+
+    EXPECT_EQ(string(v.begin(), v.end()), "{ }");
+
+    const auto w    = encode(data);
+    const auto pack = text::decode(span_cbyte { w });
+
+    ASSERT_TRUE(pack);
+    EXPECT_EQ(*pack, data);
+    EXPECT_TRUE((*pack)["list"].is_empty());
+  }
+}
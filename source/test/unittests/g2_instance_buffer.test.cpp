@@ -0,0 +1,100 @@
+/*  test/unittests/g2_instance_buffer.test.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../../laplace/graphics/flat/instance_buffer.h"
+#include <gtest/gtest.h>
+
+namespace laplace::test {
+  using graphics::flat::instance_buffer,
+      graphics::flat::instance_shader, graphics::vec2,
+      graphics::vec4;
+
+  using instance     = instance_buffer::instance;
+  using solid_vertex = instance_buffer::solid_vertex;
+
+  TEST(graphics, instance_layout) {
+    EXPECT_EQ(sizeof(instance), 20);
+    EXPECT_EQ(offsetof(instance, position), 0);
+    EXPECT_EQ(offsetof(instance, scale), 8);
+    EXPECT_EQ(offsetof(instance, color), 16);
+  }
+
+  TEST(graphics, instance_pack) {
+    const auto a = instance_buffer::pack({ 10.f, 20.f },
+                                         { 14.f, 30.f }, 3);
+
+    EXPECT_EQ(a.position, (vec2 { 12.f, 25.f }));
+    EXPECT_EQ(a.scale, (vec2 { 2.f, 5.f }));
+    EXPECT_EQ(a.color, 3u);
+  }
+
+  TEST(graphics, instance_expand) {
+    const vec4 palette[] = { vec4 { 1.f, 0.f, 0.f, 1.f },
+                             vec4 { 0.f, 1.f, 0.f, 1.f } };
+
+    const instance instances[] = {
+      instance_buffer::pack({ 0.f, 0.f }, { 2.f, 4.f }, 1),
+      instance_buffer::pack({ -1.f, -1.f }, { 1.f, 1.f }, 2)
+    };
+
+    auto v = sl::vector<solid_vertex> {};
+
+    instance_buffer::expand(instances, palette, v);
+
+    ASSERT_EQ(v.size(), 12);
+
+    EXPECT_EQ(v[0].position, (vec2 { 0.f, 0.f }));
+    EXPECT_EQ(v[1].position, (vec2 { 2.f, 0.f }));
+    EXPECT_EQ(v[2].position, (vec2 { 0.f, 4.f }));
+    EXPECT_EQ(v[3].position, (vec2 { 2.f, 0.f }));
+    EXPECT_EQ(v[4].position, (vec2 { 2.f, 4.f }));
+    EXPECT_EQ(v[5].position, (vec2 { 0.f, 4.f }));
+    EXPECT_EQ(v[6].position, (vec2 { -1.f, -1.f }));
+    EXPECT_EQ(v[10].position, (vec2 { 1.f, 1.f }));
+
+    for (sl::index i = 0; i < 6; i++) {
+      EXPECT_EQ(v[i].color, palette[1]);
+      EXPECT_EQ(v[i + 6].color, palette[0]);
+    }
+  }
+
+  TEST(graphics, instance_expand_wrap) {
+    const auto size = static_cast<uint32_t>(
+        instance_shader::palette_size);
+
+    auto palette = sl::vector<vec4>(size + 4);
+
+    for (sl::index i = 0; i < palette.size(); i++) {
+      palette[i] = vec4 { static_cast<float>(i), 0.f, 0.f, 1.f };
+    }
+
+    const instance instances[] = {
+      instance_buffer::pack({}, { 1.f, 1.f }, size + 1),
+      instance_buffer::pack({}, { 1.f, 1.f }, size - 1)
+    };
+
+    auto v = sl::vector<solid_vertex> {};
+
+    instance_buffer::expand(instances, palette, v);
+
+    ASSERT_EQ(v.size(), 12);
+
+    /*  The same wrap as in the shader.
+     */
+    EXPECT_EQ(v[0].color, palette[1]);
+    EXPECT_EQ(v[6].color, palette[size - 1]);
+
+    instance_buffer::expand(instances, {}, v);
+
+    EXPECT_EQ(v[0].color, vec4 {});
+  }
+}
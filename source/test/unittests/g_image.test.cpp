@@ -0,0 +1,123 @@
+/*  test/unittests/g_image.test.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../../laplace/graphics/image.h"
+#include <gtest/gtest.h>
+#include <random>
+
+namespace laplace::test {
+  using graphics::image, graphics::pixel, graphics::rgba,
+      std::mt19937_64, std::uniform_int_distribution;
+
+  static auto reference_box(const image &src) -> image {
+    const auto size = src.get_width() / 2;
+    auto       dst  = image(size, size);
+
+    const auto avg = [](int a, int b, int c, int d) {
+      return static_cast<uint8_t>((a + b + c + d + 2) / 4);
+    };
+
+    for (sl::index y = 0; y < size; y++) {
+      for (sl::index x = 0; x < size; x++) {
+        const auto p0 = src.get_pixel(x * 2, y * 2);
+        const auto p1 = src.get_pixel(x * 2 + 1, y * 2);
+        const auto p2 = src.get_pixel(x * 2, y * 2 + 1);
+        const auto p3 = src.get_pixel(x * 2 + 1, y * 2 + 1);
+
+        dst.set_pixel(
+            x, y,
+            rgba(avg(p0.red, p1.red, p2.red, p3.red),
+                 avg(p0.green, p1.green, p2.green, p3.green),
+                 avg(p0.blue, p1.blue, p2.blue, p3.blue),
+                 avg(p0.alpha, p1.alpha, p2.alpha, p3.alpha)));
+      }
+    }
+
+    return dst;
+  }
+
+  static auto equals(const image &a, const image &b) -> bool {
+    if (a.get_width() != b.get_width() ||
+        a.get_height() != b.get_height())
+      return false;
+    for (sl::index i = 0; i < a.get_width() * a.get_height(); i++) {
+      const auto p = a.get_pixel(i);
+      const auto q = b.get_pixel(i);
+      if (p.red != q.red || p.green != q.green ||
+          p.blue != q.blue || p.alpha != q.alpha)
+        return false;
+    }
+    return true;
+  }
+
+  TEST(graphics, image_mip_chain_sizes) {
+    const auto img   = image(100, 60);
+    const auto chain = img.mip_chain();
+
+    ASSERT_EQ(chain.size(), img.get_mip_count());
+
+    for (sl::index i = 0; i < chain.size(); i++) {
+      EXPECT_EQ(chain[i]->get_width(), sl::whole { 128 } >> i);
+      EXPECT_EQ(chain[i]->get_height(), sl::whole { 128 } >> i);
+    }
+  }
+
+  TEST(graphics, image_mip_chain_box) {
+    auto rng = mt19937_64 {};
+    auto c   = uniform_int_distribution<int>(0, 255);
+    auto img = image(64, 64);
+
+    for (sl::index i = 0; i < 64 * 64; i++) {
+      img.set_pixel(i, rgba(c(rng), c(rng), c(rng), c(rng)));
+    }
+
+    const auto chain = img.mip_chain();
+
+    ASSERT_EQ(chain.size(), 7);
+    EXPECT_TRUE(equals(*chain[0], img));
+
+    for (sl::index i = 1; i < chain.size(); i++) {
+      EXPECT_TRUE(equals(*chain[i], reference_box(*chain[i - 1])));
+    }
+  }
+
+  TEST(graphics, image_mip_chain_gamma) {
+    auto img = image(16, 16);
+
+    for (sl::index y = 0; y < 16; y++) {
+      for (sl::index x = 0; x < 16; x++) {
+        const auto v = static_cast<uint8_t>((x + y) % 2 == 0 ? 255
+                                                             : 0);
+        img.set_pixel(x, y, rgba(v, v, v, v));
+      }
+    }
+
+    const auto linear = img.mip_chain(0, false);
+    const auto gamma  = img.mip_chain(0, true);
+
+    const auto p = linear[1]->get_pixel(0, 0);
+    const auto q = gamma[1]->get_pixel(0, 0);
+
+    EXPECT_EQ(p.red, 128);
+    EXPECT_EQ(q.red, 188);
+    EXPECT_EQ(q.alpha, 128);
+
+    for (int v = 0; v < 256; v++) {
+      const auto u = static_cast<uint8_t>(v);
+      auto       s = image(2, 2);
+      for (sl::index i = 0; i < 4; i++) {
+        s.set_pixel(i, rgba(u, u, u, u));
+      }
+      EXPECT_EQ(s.mip_chain(0, true)[1]->get_pixel(0).green, u);
+    }
+  }
+}
@@ -0,0 +1,53 @@
+/*  test/unittests/p_thread.test.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../../laplace/platform/thread.h"
+#include <gtest/gtest.h>
+
+namespace laplace::test {
+  using platform::parse_cpu_list, platform::parse_policy,
+      platform::thread_options, platform::apply_thread_options;
+
+  namespace policy = platform::policy;
+
+  TEST(platform, thread_parse_cpu_list) {
+    using v = sl::vector<sl::index>;
+
+    EXPECT_EQ(parse_cpu_list("3"), v({ 3 }));
+    EXPECT_EQ(parse_cpu_list("0-3"), v({ 0, 1, 2, 3 }));
+    EXPECT_EQ(parse_cpu_list("8, 0-2,10-11"),
+              v({ 0, 1, 2, 8, 10, 11 }));
+    EXPECT_EQ(parse_cpu_list("2,1-2"), v({ 1, 2 }));
+  }
+
+  TEST(platform, thread_parse_cpu_list_invalid) {
+    EXPECT_TRUE(parse_cpu_list("").empty());
+    EXPECT_TRUE(parse_cpu_list("a").empty());
+    EXPECT_TRUE(parse_cpu_list("3-1").empty());
+    EXPECT_TRUE(parse_cpu_list("1,,2").empty());
+    EXPECT_TRUE(parse_cpu_list("-2").empty());
+    EXPECT_TRUE(parse_cpu_list("100000").empty());
+  }
+
+  TEST(platform, thread_parse_policy) {
+    EXPECT_EQ(parse_policy("normal"), policy::normal);
+    EXPECT_EQ(parse_policy("batch"), policy::batch);
+    EXPECT_EQ(parse_policy("idle"), policy::idle);
+    EXPECT_EQ(parse_policy("fifo"), policy::fifo);
+    EXPECT_EQ(parse_policy("round_robin"), policy::round_robin);
+    EXPECT_EQ(parse_policy("unknown"), policy::inherit);
+  }
+
+  TEST(platform, thread_empty_options) {
+    EXPECT_TRUE(apply_thread_options(thread_options {}));
+  }
+}
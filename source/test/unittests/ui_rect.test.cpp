@@ -14,7 +14,8 @@
 #include <gtest/gtest.h>
 
 namespace laplace::test {
-  using ui::rect, ui::contains, ui::intersects;
+  using ui::rect, ui::contains, ui::intersects, ui::unite,
+      ui::intersection;
 
   TEST(ui, rect_contains_point) {
     rect a { 10, 5, 100, 200 };
@@ -48,4 +49,22 @@ namespace laplace::test {
     EXPECT_TRUE(contains(a, b));
     EXPECT_FALSE(contains(a, c));
   }
+
+  TEST(ui, rect_unite) {
+    rect a { 10, 10, 20, 20 };
+    rect b { 40, 5, 10, 10 };
+
+    EXPECT_EQ(unite(a, b), (rect { 10, 5, 40, 25 }));
+    EXPECT_EQ(unite(a, rect {}), a);
+    EXPECT_EQ(unite(rect {}, b), b);
+  }
+
+  TEST(ui, rect_intersection) {
+    rect a { 10, 10, 20, 20 };
+    rect b { 20, 5, 20, 10 };
+    rect c { 40, 40, 10, 10 };
+
+    EXPECT_EQ(intersection(a, b), (rect { 20, 10, 10, 5 }));
+    EXPECT_EQ(intersection(a, c).width, 0);
+  }
 }
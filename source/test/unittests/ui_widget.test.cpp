@@ -0,0 +1,85 @@
+/*  test/unittests/ui_widget.test.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../../laplace/ui/widget.h"
+#include <gtest/gtest.h>
+
+namespace laplace::test {
+  using ui::widget, ui::rect, std::make_shared;
+
+  TEST(ui, widget_dirty_attach) {
+    auto root  = make_shared<widget>();
+    auto child = make_shared<widget>();
+    auto leaf  = make_shared<widget>();
+
+    child->set_rect({ 10, 10, 50, 20 });
+    leaf->set_rect({ 5, 5, 10, 10 });
+
+    EXPECT_EQ(root->get_dirty(), rect {});
+
+    root->attach(child);
+
+    EXPECT_EQ(root->get_dirty(), (rect { 10, 10, 50, 20 }));
+
+    child->attach(leaf);
+
+    EXPECT_EQ(root->get_dirty(), (rect { 10, 10, 50, 20 }));
+  }
+
+  TEST(ui, widget_dirty_move) {
+    auto root  = make_shared<widget>();
+    auto child = make_shared<widget>();
+    auto leaf  = make_shared<widget>();
+
+    child->set_rect({ 10, 10, 50, 20 });
+    leaf->set_rect({ 5, 5, 10, 10 });
+
+    root->attach(child);
+    child->attach(leaf);
+
+    leaf->move_to(100, 5);
+
+    EXPECT_EQ(root->get_dirty(), (rect { 10, 10, 110, 20 }));
+    EXPECT_TRUE(root->has_childs_expired());
+    EXPECT_TRUE(child->has_childs_expired());
+    EXPECT_TRUE(leaf->is_expired());
+
+    child->detach(leaf);
+    leaf->move_to(0, 0);
+
+    EXPECT_EQ(root->get_dirty(), (rect { 10, 10, 110, 20 }));
+  }
+
+  TEST(ui, widget_dirty_nested) {
+    auto root  = make_shared<widget>();
+    auto inner = make_shared<widget>();
+    auto leaf  = make_shared<widget>();
+    auto other = make_shared<widget>();
+
+    inner->set_rect({ 20, 30, 100, 100 });
+    inner->set_retained(true);
+    leaf->set_rect({ 5, 5, 10, 10 });
+    other->set_rect({ 200, 0, 10, 10 });
+
+    root->attach(inner);
+    root->attach(other);
+    inner->attach(leaf);
+
+    EXPECT_EQ(inner->get_dirty(), (rect { 20, 30, 100, 100 }));
+
+    other->move_to(300, 0);
+    leaf->move_to(150, 5);
+
+    EXPECT_EQ(inner->get_dirty(), (rect { 20, 30, 160, 100 }));
+    EXPECT_EQ(root->get_dirty(), (rect { 20, 0, 290, 130 }));
+  }
+}
@@ -0,0 +1,130 @@
+/*  test/unittests/uit_atlas.test.cpp
+ *
+ *  Copyright (c) 2021 Mitya Selivanov
+ *
+ *  This file is part of the Laplace project.
+ *
+ *  Laplace is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ *  the MIT License for more details.
+ */
+
+#include "../../laplace/ui/text/atlas.h"
+#include <gtest/gtest.h>
+
+namespace laplace::test {
+  using ui::text::atlas, graphics::image, graphics::rgba;
+
+  static auto bitmap(sl::whole width, sl::whole height) -> image {
+    auto img = image(width, height);
+
+    for (sl::index i = 0; i < width * height; i++) {
+      img.set_pixel(i, rgba(255, 255, 255, 128));
+    }
+
+    return img;
+  }
+
+  static auto key_of(char32_t code) -> atlas::key {
+    return { .face = nullptr, .size = 12, .code = code };
+  }
+
+  TEST(ui, atlas_insert_find) {
+    auto a = atlas(64, 64);
+
+    EXPECT_EQ(a.find(key_of(U'a')), nullptr);
+
+    const auto *g = a.insert(key_of(U'a'), 1, 9, 8, bitmap(3, 2));
+
+    ASSERT_NE(g, nullptr);
+    EXPECT_EQ(a.find(key_of(U'a')), g);
+    EXPECT_EQ(a.get_count(), 1);
+    EXPECT_EQ(g->width, 3);
+    EXPECT_EQ(g->height, 2);
+    EXPECT_EQ(g->left, 1);
+    EXPECT_EQ(g->top, 9);
+    EXPECT_EQ(g->advance, 8);
+
+    EXPECT_EQ(a.get_image().get_pixel(g->x + 2, g->y + 1).alpha, 128);
+    EXPECT_EQ(a.get_image().get_pixel(g->x + 3, g->y + 1).alpha, 0);
+
+    const auto r = a.take_dirty();
+
+    EXPECT_EQ(r.x, g->x);
+    EXPECT_EQ(r.y, g->y);
+    EXPECT_EQ(r.width, 3);
+    EXPECT_EQ(r.height, 2);
+    EXPECT_EQ(a.take_dirty().width, 0);
+
+    auto k = key_of(U'a');
+    k.size = 14;
+    EXPECT_EQ(a.find(k), nullptr);
+  }
+
+  TEST(ui, atlas_empty_glyph) {
+    auto a = atlas(64, 64);
+
+    const auto *g = a.insert(key_of(U' '), 0, 0, 5, image {});
+
+    ASSERT_NE(g, nullptr);
+    EXPECT_EQ(g->width, 0);
+    EXPECT_EQ(g->advance, 5);
+    EXPECT_EQ(a.take_dirty().width, 0);
+  }
+
+  TEST(ui, atlas_lru_eviction) {
+    auto a = atlas(16, 8);
+
+    a.next_stamp();
+    ASSERT_NE(a.insert(key_of(U'a'), 0, 0, 0, bitmap(7, 7)), nullptr);
+    a.next_stamp();
+    ASSERT_NE(a.insert(key_of(U'b'), 0, 0, 0, bitmap(7, 7)), nullptr);
+    a.next_stamp();
+    const auto *g = a.find(key_of(U'a'));
+    ASSERT_NE(g, nullptr);
+
+    const auto x = g->x;
+    const auto y = g->y;
+
+    a.next_stamp();
+    ASSERT_NE(a.insert(key_of(U'c'), 0, 0, 0, bitmap(7, 7)), nullptr);
+
+    /*  The glyphs left are not moved.
+     */
+    g = a.find(key_of(U'a'));
+    ASSERT_NE(g, nullptr);
+    EXPECT_EQ(g->x, x);
+    EXPECT_EQ(g->y, y);
+    EXPECT_EQ(a.find(key_of(U'b')), nullptr);
+    EXPECT_NE(a.find(key_of(U'c')), nullptr);
+    EXPECT_EQ(a.get_count(), 2);
+  }
+
+  TEST(ui, atlas_pinned) {
+    auto a = atlas(16, 8);
+
+    a.next_stamp();
+    ASSERT_NE(a.insert(key_of(U'a'), 0, 0, 0, bitmap(7, 7)), nullptr);
+    ASSERT_NE(a.insert(key_of(U'b'), 0, 0, 0, bitmap(7, 7)), nullptr);
+    EXPECT_EQ(a.insert(key_of(U'c'), 0, 0, 0, bitmap(7, 7)), nullptr);
+    EXPECT_EQ(a.insert(key_of(U'd'), 0, 0, 0, bitmap(20, 2)),
+              nullptr);
+
+    EXPECT_NE(a.find(key_of(U'a')), nullptr);
+    EXPECT_NE(a.find(key_of(U'b')), nullptr);
+  }
+
+  TEST(ui, atlas_reuse) {
+    auto a = atlas(32, 32);
+
+    for (char32_t c = 0; c < 1000; c++) {
+      a.next_stamp();
+      const auto size = 3 + static_cast<sl::whole>(c % 5);
+      ASSERT_NE(a.insert(key_of(c), 0, 0, 0, bitmap(size, size)),
+                nullptr);
+    }
+
+    EXPECT_GT(a.get_count(), 10);
+  }
+}